@@ -0,0 +1,494 @@
+#include "regolith/regolith.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+typedef struct bench_options_s {
+    const char* scene;
+    rg_step_mode_t mode;
+    uint32_t steps;
+    uint32_t warmup_steps;
+    int32_t chunks_x;
+    int32_t chunks_y;
+    int32_t chunk_size;
+    rg_sleep_policy_t sleep_policy;
+    uint32_t sleep_ticks;
+    uint32_t threads;
+    /* Nonzero: one row per worker count 1, 2, 4, ... up to and including this. */
+    uint32_t thread_sweep;
+    uint8_t work_stealing;
+    uint32_t grain;
+    int32_t tile_size;
+    uint32_t block;
+} bench_options_t;
+
+typedef struct bench_materials_s {
+    rg_material_id_t sand;
+    rg_material_id_t water;
+    rg_material_id_t stone;
+} bench_materials_t;
+
+typedef rg_status_t (*bench_scene_fn)(rg_world_t* world, const bench_options_t* options, const bench_materials_t* materials);
+
+typedef struct bench_scene_s {
+    const char* name;
+    bench_scene_fn populate;
+} bench_scene_t;
+
+static uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+
+    if (timespec_get(&ts, TIME_UTC) == 0) {
+        return 0u;
+    }
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+static const char* bench_mode_name(rg_step_mode_t mode)
+{
+    switch (mode) {
+    case RG_STEP_MODE_FULL_SCAN_SERIAL:
+        return "full";
+    case RG_STEP_MODE_CHUNK_SCAN_SERIAL:
+        return "chunk";
+    case RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL:
+        return "checkerboard";
+    case RG_STEP_MODE_TILE_CHECKERBOARD_PARALLEL:
+        return "tile";
+    case RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC:
+        return "atomic";
+    case RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO:
+        return "halo";
+    default:
+        return "unknown";
+    }
+}
+
+static int bench_parse_mode(const char* text, rg_step_mode_t* out_mode)
+{
+    if (strcmp(text, "full") == 0) {
+        *out_mode = RG_STEP_MODE_FULL_SCAN_SERIAL;
+    } else if (strcmp(text, "chunk") == 0) {
+        *out_mode = RG_STEP_MODE_CHUNK_SCAN_SERIAL;
+    } else if (strcmp(text, "checkerboard") == 0) {
+        *out_mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    } else if (strcmp(text, "tile") == 0) {
+        *out_mode = RG_STEP_MODE_TILE_CHECKERBOARD_PARALLEL;
+    } else if (strcmp(text, "atomic") == 0) {
+        *out_mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC;
+    } else if (strcmp(text, "halo") == 0) {
+        *out_mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+static int bench_parse_sleep_policy(const char* text, rg_sleep_policy_t* out_policy)
+{
+    if (strcmp(text, "fixed") == 0) {
+        *out_policy = RG_SLEEP_POLICY_FIXED;
+    } else if (strcmp(text, "adaptive") == 0) {
+        *out_policy = RG_SLEEP_POLICY_ADAPTIVE;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+static int bench_parse_schedule(const char* text, uint8_t* out_work_stealing)
+{
+    if (strcmp(text, "shared") == 0) {
+        *out_work_stealing = 0u;
+    } else if (strcmp(text, "stealing") == 0) {
+        *out_work_stealing = 1u;
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+static rg_status_t bench_fill_rect(
+    rg_world_t* world,
+    rg_material_id_t material_id,
+    int32_t x0,
+    int32_t y0,
+    int32_t x1,
+    int32_t y1)
+{
+    rg_cell_write_t write;
+    int32_t x;
+    int32_t y;
+    rg_status_t status;
+
+    memset(&write, 0, sizeof(write));
+    write.material_id = material_id;
+    for (y = y0; y < y1; ++y) {
+        for (x = x0; x < x1; ++x) {
+            status = rg_cell_set(world, (rg_cell_coord_t){x, y}, &write);
+            if (status != RG_STATUS_OK) {
+                return status;
+            }
+        }
+    }
+    return RG_STATUS_OK;
+}
+
+/* Upper half of the world is sand resting on a stone floor; every chunk is busy. */
+static rg_status_t bench_scene_dense_fall(
+    rg_world_t* world,
+    const bench_options_t* options,
+    const bench_materials_t* materials)
+{
+    int32_t width;
+    int32_t height;
+    rg_status_t status;
+
+    width = options->chunks_x * options->chunk_size;
+    height = options->chunks_y * options->chunk_size;
+
+    status = bench_fill_rect(world, materials->stone, 0, height - 1, width, height);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+    return bench_fill_rect(world, materials->sand, 0, 0, width, height / 2);
+}
+
+/* Many loaded chunks, only one with moving material: cost should track active chunks. */
+static rg_status_t bench_scene_sparse(
+    rg_world_t* world,
+    const bench_options_t* options,
+    const bench_materials_t* materials)
+{
+    int32_t height;
+    int32_t size;
+
+    height = options->chunks_y * options->chunk_size;
+    size = options->chunk_size;
+    return bench_fill_rect(world, materials->water, size / 4, 0, size - (size / 4), height / 4);
+}
+
+static const bench_scene_t g_bench_scenes[] = {
+    {"dense_fall", bench_scene_dense_fall},
+    {"sparse", bench_scene_sparse}
+};
+
+static const bench_scene_t* bench_find_scene(const char* name)
+{
+    size_t i;
+
+    for (i = 0u; i < sizeof(g_bench_scenes) / sizeof(g_bench_scenes[0]); ++i) {
+        if (strcmp(g_bench_scenes[i].name, name) == 0) {
+            return &g_bench_scenes[i];
+        }
+    }
+    return NULL;
+}
+
+static rg_status_t bench_register_materials(rg_world_t* world, bench_materials_t* out_materials)
+{
+    rg_material_desc_t desc;
+    rg_status_t status;
+
+    memset(&desc, 0, sizeof(desc));
+    desc.name = "sand";
+    desc.flags = RG_MATERIAL_POWDER;
+    desc.density = 10.0f;
+    status = rg_material_register(world, &desc, &out_materials->sand);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+
+    desc.name = "water";
+    desc.flags = RG_MATERIAL_LIQUID;
+    desc.density = 5.0f;
+    status = rg_material_register(world, &desc, &out_materials->water);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+
+    desc.name = "stone";
+    desc.flags = RG_MATERIAL_STATIC;
+    desc.density = 100.0f;
+    return rg_material_register(world, &desc, &out_materials->stone);
+}
+
+static void bench_destroy(rg_world_t* world, rg_thread_runner_t* thread_runner)
+{
+    rg_world_destroy(world);
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    rg_thread_runner_destroy(thread_runner);
+#else
+    (void)thread_runner;
+#endif
+}
+
+static int bench_run(const bench_options_t* options, const bench_scene_t* scene)
+{
+    rg_world_config_t cfg;
+    rg_world_t* world;
+    rg_thread_runner_t* thread_runner;
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    rg_thread_runner_config_t runner_cfg;
+#endif
+    bench_materials_t materials;
+    rg_step_options_t step_options;
+    rg_world_stats_t stats;
+    uint64_t start_ns;
+    uint64_t elapsed_ns;
+    uint64_t cell_updates;
+    uint64_t cross_intents;
+    uint64_t setup_ns;
+    uint64_t simulate_ns;
+    uint64_t wakes_before;
+    uint64_t sleeps_before;
+    int32_t cx;
+    int32_t cy;
+    uint32_t i;
+    rg_status_t status;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = options->chunk_size;
+    cfg.chunk_height = options->chunk_size;
+    cfg.initial_chunk_capacity = (uint32_t)(options->chunks_x * options->chunks_y);
+    /* Atomic mode trades reproducibility for throughput and refuses deterministic worlds. */
+    cfg.deterministic_mode = (options->mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC) ? 0u : 1u;
+    cfg.deterministic_seed = 1u;
+    cfg.default_step_mode = options->mode;
+    cfg.sleep_policy = options->sleep_policy;
+    cfg.chunk_sleep_ticks = options->sleep_ticks;
+    cfg.checkerboard_grain = options->grain;
+    cfg.checkerboard_block = options->block;
+    cfg.tile_width = options->tile_size;
+    cfg.tile_height = options->tile_size;
+
+    thread_runner = NULL;
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    if (options->threads > 1u) {
+        runner_cfg.worker_count = options->threads;
+        runner_cfg.schedule = (options->work_stealing != 0u) ? RG_THREAD_SCHEDULE_WORK_STEALING : RG_THREAD_SCHEDULE_SHARED;
+        status = rg_thread_runner_create_with_config(&runner_cfg, &thread_runner);
+        if (status != RG_STATUS_OK) {
+            fprintf(stderr, "rg_thread_runner_create_with_config failed: %s\n", rg_status_string(status));
+            return 1;
+        }
+        cfg.runner = rg_thread_runner_get_runner(thread_runner);
+    }
+#endif
+
+    status = rg_world_create(&cfg, &world);
+    if (status != RG_STATUS_OK) {
+        fprintf(stderr, "rg_world_create failed: %s\n", rg_status_string(status));
+        bench_destroy(NULL, thread_runner);
+        return 1;
+    }
+
+    status = bench_register_materials(world, &materials);
+    for (cy = 0; status == RG_STATUS_OK && cy < options->chunks_y; ++cy) {
+        for (cx = 0; status == RG_STATUS_OK && cx < options->chunks_x; ++cx) {
+            status = rg_chunk_load(world, cx, cy);
+        }
+    }
+    if (status == RG_STATUS_OK) {
+        status = scene->populate(world, options, &materials);
+    }
+    if (status != RG_STATUS_OK) {
+        fprintf(stderr, "scene setup failed: %s\n", rg_status_string(status));
+        bench_destroy(world, thread_runner);
+        return 1;
+    }
+
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = options->mode;
+    step_options.substeps = 1u;
+
+    for (i = 0u; i < options->warmup_steps; ++i) {
+        status = rg_world_step(world, &step_options);
+        if (status != RG_STATUS_OK) {
+            fprintf(stderr, "rg_world_step failed: %s\n", rg_status_string(status));
+            bench_destroy(world, thread_runner);
+            return 1;
+        }
+    }
+
+    (void)rg_world_get_stats(world, &stats);
+    wakes_before = stats.chunk_wakes_total;
+    sleeps_before = stats.chunk_sleeps_total;
+    cell_updates = 0u;
+    cross_intents = 0u;
+    setup_ns = 0u;
+    simulate_ns = 0u;
+    start_ns = bench_now_ns();
+    for (i = 0u; i < options->steps; ++i) {
+        status = rg_world_step(world, &step_options);
+        if (status != RG_STATUS_OK) {
+            fprintf(stderr, "rg_world_step failed: %s\n", rg_status_string(status));
+            bench_destroy(world, thread_runner);
+            return 1;
+        }
+        (void)rg_world_get_stats(world, &stats);
+        cell_updates += stats.intents_emitted_last_step;
+        cross_intents += stats.cross_intents_last_step;
+        setup_ns += stats.step_setup_ns_last_step;
+        simulate_ns += stats.step_simulate_ns_last_step;
+    }
+    elapsed_ns = bench_now_ns() - start_ns;
+
+    (void)rg_world_get_stats(world, &stats);
+    printf(
+        "%s,%s,%d,%d,%u,%llu,%.1f,%llu,%llu,%s,%u,%llu,%llu,%llu,%llu,%u,%s,%u,%d,%llu,%u\n",
+        scene->name,
+        bench_mode_name(options->mode),
+        options->chunks_x * options->chunks_y,
+        options->chunk_size,
+        options->steps,
+        (unsigned long long)stats.live_cells,
+        (options->steps > 0u) ? ((double)elapsed_ns / (double)options->steps) : 0.0,
+        (unsigned long long)cell_updates,
+        (unsigned long long)elapsed_ns,
+        (options->sleep_policy == RG_SLEEP_POLICY_ADAPTIVE) ? "adaptive" : "fixed",
+        options->sleep_ticks,
+        (unsigned long long)(stats.chunk_wakes_total - wakes_before),
+        (unsigned long long)(stats.chunk_sleeps_total - sleeps_before),
+        (unsigned long long)setup_ns,
+        (unsigned long long)simulate_ns,
+        options->threads,
+        (options->work_stealing != 0u) ? "stealing" : "shared",
+        (options->grain == 0u) ? 1u : options->grain,
+        (options->tile_size == 0) ? options->chunk_size : options->tile_size,
+        (unsigned long long)cross_intents,
+        (options->block == 0u) ? 1u : options->block);
+
+    bench_destroy(world, thread_runner);
+    return 0;
+}
+
+static void bench_usage(const char* argv0)
+{
+    fprintf(
+        stderr,
+        "usage: %s [--scene dense_fall|sparse] [--mode full|chunk|checkerboard|tile|atomic|halo] [--steps N] [--warmup N]\n"
+        "          [--chunks-x N] [--chunks-y N] [--chunk-size N] [--sleep-policy fixed|adaptive]\n"
+        "          [--sleep-ticks N] [--threads N] [--thread-sweep MAX] [--schedule shared|stealing]\n"
+        "          [--grain N] [--tile-size N] [--block N]\n",
+        argv0);
+}
+
+int main(int argc, char** argv)
+{
+    bench_options_t options;
+    const bench_scene_t* scene;
+    uint32_t threads;
+    int result;
+    int i;
+
+    memset(&options, 0, sizeof(options));
+    options.scene = "dense_fall";
+    options.mode = RG_STEP_MODE_CHUNK_SCAN_SERIAL;
+    options.steps = 200u;
+    options.warmup_steps = 0u;
+    options.chunks_x = 8;
+    options.chunks_y = 8;
+    options.chunk_size = 64;
+    options.sleep_policy = RG_SLEEP_POLICY_FIXED;
+    options.sleep_ticks = 0u;
+    options.threads = 1u;
+    options.thread_sweep = 0u;
+    options.work_stealing = 0u;
+    options.grain = 0u;
+    options.block = 0u;
+    options.tile_size = 0;
+
+    for (i = 1; i < argc; ++i) {
+        const char* arg;
+        const char* value;
+
+        arg = argv[i];
+        value = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (value == NULL) {
+            bench_usage(argv[0]);
+            return 1;
+        }
+
+        if (strcmp(arg, "--scene") == 0) {
+            options.scene = value;
+        } else if (strcmp(arg, "--mode") == 0) {
+            if (bench_parse_mode(value, &options.mode) == 0) {
+                bench_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(arg, "--steps") == 0) {
+            options.steps = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--warmup") == 0) {
+            options.warmup_steps = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--chunks-x") == 0) {
+            options.chunks_x = (int32_t)strtol(value, NULL, 10);
+        } else if (strcmp(arg, "--chunks-y") == 0) {
+            options.chunks_y = (int32_t)strtol(value, NULL, 10);
+        } else if (strcmp(arg, "--chunk-size") == 0) {
+            options.chunk_size = (int32_t)strtol(value, NULL, 10);
+        } else if (strcmp(arg, "--sleep-policy") == 0) {
+            if (bench_parse_sleep_policy(value, &options.sleep_policy) == 0) {
+                bench_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(arg, "--sleep-ticks") == 0) {
+            options.sleep_ticks = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--threads") == 0) {
+            options.threads = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--thread-sweep") == 0) {
+            options.thread_sweep = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--schedule") == 0) {
+            if (bench_parse_schedule(value, &options.work_stealing) == 0) {
+                bench_usage(argv[0]);
+                return 1;
+            }
+        } else if (strcmp(arg, "--grain") == 0) {
+            options.grain = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--block") == 0) {
+            options.block = (uint32_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--tile-size") == 0) {
+            options.tile_size = (int32_t)strtol(value, NULL, 10);
+        } else {
+            bench_usage(argv[0]);
+            return 1;
+        }
+        i += 1;
+    }
+
+#if !defined(REGOLITH_HAVE_THREAD_RUNNER)
+    if (options.threads > 1u || options.thread_sweep > 1u) {
+        fprintf(stderr, "--threads needs REGOLITH_BUILD_THREAD_RUNNER\n");
+        return 1;
+    }
+#endif
+    if (options.chunks_x <= 0 || options.chunks_y <= 0 || options.chunk_size <= 0) {
+        bench_usage(argv[0]);
+        return 1;
+    }
+
+    scene = bench_find_scene(options.scene);
+    if (scene == NULL) {
+        fprintf(stderr, "unknown scene: %s\n", options.scene);
+        return 1;
+    }
+
+    printf("scene,mode,chunks,chunk_size,steps,live_cells,ns_per_step,cell_moves,elapsed_ns,sleep_policy,sleep_ticks,chunk_wakes,chunk_sleeps,setup_ns,simulate_ns,threads,schedule,grain,tile_size,cross_intents,block\n");
+    if (options.thread_sweep == 0u) {
+        return bench_run(&options, scene);
+    }
+
+    /* Scaling runs: same scene and step count at each worker count. */
+    result = 0;
+    for (threads = 1u; result == 0; threads *= 2u) {
+        options.threads = (threads < options.thread_sweep) ? threads : options.thread_sweep;
+        result = bench_run(&options, scene);
+        if (options.threads == options.thread_sweep || threads > UINT32_MAX / 2u) {
+            break;
+        }
+    }
+    return result;
+}
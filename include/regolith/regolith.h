@@ -4,6 +4,7 @@
 #include "regolith/types.h"
 #include "regolith/world.h"
 #include "regolith/runner_sdl.h"
+#include "regolith/runner_thread.h"
 
 #ifdef __cplusplus
 extern "C" {
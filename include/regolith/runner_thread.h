@@ -0,0 +1,50 @@
+#ifndef REGOLITH_RUNNER_THREAD_H
+#define REGOLITH_RUNNER_THREAD_H
+
+#include <stdint.h>
+
+#include "regolith/world.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct rg_thread_runner_s rg_thread_runner_t;
+
+/*
+ * SHARED hands out task indices from one atomic counter in index order.
+ * WORK_STEALING deals tasks round-robin into per-worker deques (worker w owns
+ * w, w + n, ...); owners pop their lowest index, idle workers steal the highest
+ * remaining index from others. Both start low indices first, which pairs with
+ * callers that submit their most expensive tasks first.
+ */
+typedef enum rg_thread_schedule_e {
+    RG_THREAD_SCHEDULE_SHARED = 0,
+    RG_THREAD_SCHEDULE_WORK_STEALING = 1
+} rg_thread_schedule_t;
+
+typedef struct rg_thread_runner_config_s {
+    uint32_t worker_count; /* 0 selects 1. */
+    rg_thread_schedule_t schedule;
+} rg_thread_runner_config_t;
+
+/*
+ * Persistent pthread pool: worker_count - 1 helper threads are started here and
+ * live until destroy; the thread calling parallel_for acts as worker 0.
+ * parallel_for must not be called concurrently on the same runner.
+ * submit/wait run one job at a time on a further thread, started on the first
+ * submit; a second submit before wait returns RG_STATUS_CONFLICT. destroy lets
+ * a submitted job finish before stopping the pool.
+ */
+rg_status_t rg_thread_runner_create(uint32_t worker_count, rg_thread_runner_t** out_runner);
+rg_status_t rg_thread_runner_create_with_config(
+    const rg_thread_runner_config_t* cfg,
+    rg_thread_runner_t** out_runner);
+void rg_thread_runner_destroy(rg_thread_runner_t* runner);
+const rg_runner_t* rg_thread_runner_get_runner(const rg_thread_runner_t* runner);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -38,9 +38,45 @@ typedef rg_status_t (*rg_runner_parallel_for_fn)(
 
 typedef uint32_t (*rg_runner_worker_count_fn)(void* runner_user);
 
+typedef void (*rg_async_job_fn)(void* user_data);
+
+/* Starts job(user_data) on a runner-owned thread and returns without waiting. */
+typedef rg_status_t (*rg_runner_submit_fn)(void* runner_user, rg_async_job_fn job, void* user_data);
+
+/* Blocks until the job started by the last submit has returned. */
+typedef void (*rg_runner_wait_fn)(void* runner_user);
+
+/*
+ * Tasks with dependencies. Task i may start once every task in
+ * dependencies[dependency_offsets[i] .. dependency_offsets[i + 1]) has returned,
+ * and successors lists the reverse edges in the same layout. Dependencies always
+ * have lower indices than their task, so index order is a valid serial order.
+ */
+typedef struct rg_task_graph_s {
+    uint32_t task_count;
+    rg_parallel_task_fn task;
+    void* task_user_data;
+    const uint32_t* dependency_offsets;
+    const uint32_t* dependencies;
+    const uint32_t* successor_offsets;
+    const uint32_t* successors;
+} rg_task_graph_t;
+
+/* Runs every task of the graph once, respecting its edges, and returns when all have. */
+typedef rg_status_t (*rg_runner_run_graph_fn)(void* runner_user, const rg_task_graph_t* graph);
+
+/*
+ * submit and wait are optional and come as a pair. The submitted job may call
+ * parallel_for on the same runner; the submitting thread must not until wait.
+ * run_graph is optional; without it the world separates dependent work with
+ * parallel_for barriers instead.
+ */
 typedef struct rg_runner_vtable_s {
     rg_runner_parallel_for_fn parallel_for;
     rg_runner_worker_count_fn worker_count;
+    rg_runner_submit_fn submit;
+    rg_runner_wait_fn wait;
+    rg_runner_run_graph_fn run_graph;
 } rg_runner_vtable_t;
 
 struct rg_runner_s {
@@ -51,9 +87,37 @@ struct rg_runner_s {
 typedef enum rg_step_mode_e {
     RG_STEP_MODE_FULL_SCAN_SERIAL = 0,
     RG_STEP_MODE_CHUNK_SCAN_SERIAL = 1,
-    RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL = 2
+    RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL = 2,
+    /* Checkerboard over tile_width x tile_height sub-chunk tiles instead of whole chunks. */
+    RG_STEP_MODE_TILE_CHECKERBOARD_PARALLEL = 3,
+    /*
+     * Chunk checkerboard that commits moves into neighbor chunks in place with
+     * atomic claims instead of buffering and merging intents. Not reproducible:
+     * UNSUPPORTED when deterministic_mode is set or chunks are narrower or
+     * shorter than 2 cells.
+     */
+    RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC = 4,
+    /*
+     * Chunk checkerboard where a task owns its chunk plus the one-cell ring
+     * around it and writes moves into that ring directly; the color phases keep
+     * same-color rings apart, so no intents are needed and results stay
+     * deterministic. UNSUPPORTED when chunks are narrower or shorter than 2 cells.
+     */
+    RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO = 5
 } rg_step_mode_t;
 
+/*
+ * FIXED puts a chunk to sleep after chunk_sleep_ticks unchanged steps.
+ * ADAPTIVE starts every chunk at chunk_sleep_ticks and tunes it per chunk
+ * within [chunk_sleep_ticks_min, chunk_sleep_ticks_max]: a chunk woken again
+ * soon after falling asleep doubles its threshold, and a chunk that stayed
+ * asleep halves it the next time it settles.
+ */
+typedef enum rg_sleep_policy_e {
+    RG_SLEEP_POLICY_FIXED = 0,
+    RG_SLEEP_POLICY_ADAPTIVE = 1
+} rg_sleep_policy_t;
+
 typedef enum rg_material_flags_e {
     RG_MATERIAL_STATIC = 1u << 0,
     RG_MATERIAL_SOLID = 1u << 1,
@@ -77,6 +141,18 @@ typedef struct rg_world_config_s {
     uint64_t deterministic_seed;
     uint8_t deterministic_mode;
     rg_step_mode_t default_step_mode;
+    rg_sleep_policy_t sleep_policy;
+    uint32_t chunk_sleep_ticks;     /* 0 selects the default (8). */
+    uint32_t chunk_sleep_ticks_min; /* ADAPTIVE only; 0 selects chunk_sleep_ticks / 4 (at least 1). */
+    uint32_t chunk_sleep_ticks_max; /* ADAPTIVE only; 0 selects chunk_sleep_ticks * 8. */
+    uint32_t lod_full_rate_radius;  /* Chunk distance from a focus point that still steps every tick. */
+    uint32_t lod_band_width;        /* Chunks per band beyond the radius; each band halves the rate. 0 selects 2. */
+    uint32_t lod_max_period;        /* Power of two cap on the step period in ticks. 0 selects 8. */
+    uint32_t checkerboard_grain;    /* Chunks (or blocks) per runner task in checkerboard phases. 0 selects 1. */
+    uint32_t checkerboard_block;    /* Chunk checkerboard modes step k x k chunk blocks as one task. 0 selects 1. */
+    int32_t tile_width;             /* Tile mode; divides chunk_width, multiple of 8 unless equal. 0 selects chunk_width. */
+    int32_t tile_height;            /* Tile mode; divides chunk_height, chunk_width * tile_height a multiple of 8 unless equal. 0 selects chunk_height. */
+    uint32_t step_scratch_chunks;   /* Active chunks to size step scratch for at create. 0 grows on demand. */
     rg_allocator_t allocator;
     const rg_runner_t* runner;
 } rg_world_config_t;
@@ -122,6 +198,21 @@ typedef struct rg_step_options_s {
     uint32_t substeps;
 } rg_step_options_t;
 
+/* Monotonic time in nanoseconds. Called from runner workers in checkerboard mode. */
+typedef uint64_t (*rg_clock_now_fn)(void* user);
+
+typedef struct rg_budget_step_options_s {
+    rg_step_mode_t mode;
+    uint64_t budget_ns;           /* 0 disables the deadline. */
+    rg_clock_now_fn clock_now_ns; /* NULL selects CLOCK_MONOTONIC (QueryPerformanceCounter on Windows). */
+    void* clock_user;
+} rg_budget_step_options_t;
+
+typedef struct rg_budget_step_result_s {
+    uint32_t chunks_stepped;
+    uint32_t chunks_deferred;
+} rg_budget_step_result_t;
+
 typedef struct rg_world_stats_s {
     uint32_t loaded_chunks;
     uint32_t active_chunks;
@@ -131,6 +222,16 @@ typedef struct rg_world_stats_s {
     uint64_t intent_conflicts_last_step;
     uint64_t payload_overflow_allocs;
     uint64_t payload_overflow_frees;
+    uint64_t chunk_wakes_last_step;
+    uint64_t chunk_sleeps_last_step;
+    uint64_t chunk_wakes_total;
+    uint64_t chunk_sleeps_total;
+    uint64_t lod_skipped_chunks_last_step;
+    uint64_t budget_deferred_chunks_last_step;
+    uint64_t step_setup_ns_last_step;    /* Snapshotting, sorting and scratch preparation. */
+    uint64_t step_simulate_ns_last_step; /* Chunk stepping and intent merges. */
+    uint64_t step_scratch_allocs;        /* Cumulative step scratch growths; 0 while reserved scratch suffices. */
+    uint64_t cross_intents_last_step;    /* Cross-chunk/tile moves buffered as intents and merged. */
 } rg_world_stats_t;
 
 rg_status_t rg_world_create(const rg_world_config_t* cfg, rg_world_t** out_world);
@@ -158,8 +259,75 @@ rg_status_t rg_cell_clear(rg_world_t* world, rg_cell_coord_t cell);
 
 rg_status_t rg_world_step(rg_world_t* world, const rg_step_options_t* options);
 
+/*
+ * Steps world_count distinct worlds that share one runner (or none) by one
+ * rg_world_step(world, options) each. Worlds in chunk checkerboard modes run
+ * each color phase together: every world's tasks for the phase go out in one
+ * parallel_for, so many small worlds keep all workers busy. Intent merges and
+ * bookkeeping stay per world, so a deterministic world ends in the same state
+ * as if it had been stepped alone. Worlds in other modes are stepped one after another.
+ * With options NULL each world uses its default mode. A failing world stops
+ * stepping while the others finish; the first failure is returned.
+ */
+rg_status_t rg_world_step_batch(rg_world_t* const* worlds, uint32_t world_count, const rg_step_options_t* options);
+
+/*
+ * Starts rg_world_step(world, options) and returns without waiting when the
+ * runner provides submit/wait; otherwise the step runs here before returning.
+ * Options are validated up front, step errors are reported by
+ * rg_world_step_wait. Until that call returns the step owns the world: every
+ * other rg_world_*, rg_chunk_*, rg_cell_* and rg_material_* call on it,
+ * including rg_cell_get and rg_world_get_stats, returns RG_STATUS_CONFLICT
+ * without touching it, and rg_world_destroy waits for the step first. Copy
+ * whatever the frame renders before beginning the step. These rules bind the
+ * thread that called begin; the world is still not safe to share across
+ * threads.
+ */
+rg_status_t rg_world_step_begin(rg_world_t* world, const rg_step_options_t* options);
+
+/*
+ * Waits for the step started by rg_world_step_begin and returns its status;
+ * RG_STATUS_INVALID_ARGUMENT when no step is in flight.
+ */
+rg_status_t rg_world_step_wait(rg_world_t* world);
+
+/*
+ * Preallocates step scratch (chunk lists, task outputs, intent and merge
+ * buffers) for up to active_chunk_count active chunks in any step mode, so
+ * steps that stay within it make no allocator calls. A step that needs more
+ * still grows the scratch and counts it in rg_world_stats_t.step_scratch_allocs.
+ */
+rg_status_t rg_world_reserve_step_scratch(rg_world_t* world, uint32_t active_chunk_count);
+
+/*
+ * Advances one tick, stepping due chunks in priority order until the budget is
+ * spent; the rest are deferred and simply miss this tick. Order: chunks deferred
+ * by more consecutive calls first, then higher rg_chunk_set_priority values,
+ * then nearer to a focus point, then chunk table order. At least one chunk is
+ * stepped per call, so a chunk that stays due is never starved. Which chunks fit
+ * in the budget depends on timing, so budgeted runs are not deterministic.
+ * Supports RG_STEP_MODE_FULL_SCAN_SERIAL, RG_STEP_MODE_CHUNK_SCAN_SERIAL and
+ * RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL; the tile, atomic and halo modes
+ * return RG_STATUS_UNSUPPORTED.
+ */
+rg_status_t rg_world_step_budgeted(
+    rg_world_t* world,
+    const rg_budget_step_options_t* options,
+    rg_budget_step_result_t* out_result);
+
+rg_status_t rg_chunk_set_priority(rg_world_t* world, int32_t chunk_x, int32_t chunk_y, int32_t priority);
+
 rg_status_t rg_world_get_stats(const rg_world_t* world, rg_world_stats_t* out_stats);
 
+/*
+ * Level of detail: with at least one focus point set, each chunk steps every
+ * 2^k ticks, where k grows with its Chebyshev chunk distance to the nearest
+ * focus point (see lod_* in rg_world_config_t). Which ticks a chunk is due on
+ * depends only on the tick, its chunk coordinates and the focus points, so
+ * deterministic runs stay reproducible. Passing count 0 restores full rate.
+ */
+rg_status_t rg_world_set_focus_points(rg_world_t* world, const rg_cell_coord_t* points, uint32_t count);
+
 rg_status_t rg_ctx_try_move(
     rg_update_ctx_t* ctx,
     rg_cell_coord_t from,
@@ -4,68 +4,135 @@
 
 #include <stdlib.h>
 
-typedef struct rg_sdl_parallel_ctx_s {
-    rg_parallel_task_fn task;
-    void* task_user_data;
-    uint32_t task_count;
-    uint32_t next_index;
-    SDL_Mutex* mutex;
-} rg_sdl_parallel_ctx_t;
+enum {
+    /* Polls of the phase generation before a worker parks on the condition. */
+    RG_SDL_SPIN_ITERATIONS = 4096
+};
 
 typedef struct rg_sdl_worker_args_s {
-    rg_sdl_parallel_ctx_t* ctx;
+    rg_sdl_runner_t* runner;
     uint32_t worker_index;
 } rg_sdl_worker_args_t;
 
 struct rg_sdl_runner_s {
     rg_runner_t runner;
     uint32_t worker_count;
+    uint32_t helper_count;
+    SDL_Thread** threads;
+    rg_sdl_worker_args_t* worker_args;
+
+    /*
+     * Job slots are written by the caller before generation is bumped and read
+     * by helpers after they observe the new generation.
+     */
+    rg_parallel_task_fn task;
+    void* task_user_data;
+    uint32_t task_count;
+    SDL_AtomicInt next_index;
+    SDL_AtomicInt generation;
+    SDL_AtomicInt busy_helpers;
+    SDL_AtomicInt shutdown;
+
+    /* Parking only; the fast path never takes the mutex on the worker side. */
+    SDL_Mutex* mutex;
+    SDL_Condition* wake_cond;
+    SDL_Semaphore* done_sem;
+    uint32_t sleeping_helpers;
+
+    /*
+     * Submitted jobs run on one extra thread, started on first submit, which
+     * then acts as worker 0 for any parallel_for the job issues. async_job is
+     * non-NULL from submit until the job has returned.
+     */
+    SDL_Thread* async_thread;
+    uint8_t async_shutdown;
+    rg_async_job_fn async_job;
+    void* async_user_data;
+    SDL_Mutex* async_mutex;
+    SDL_Condition* async_cond;
+
+    /*
+     * run_graph state, grown on demand. graph_pending counts each task's
+     * unfinished dependencies; the task that finishes the last one appends the
+     * successor (as index + 1) at graph_push. Workers claim queue slots at
+     * graph_pop and wait for a claimed slot to be filled.
+     */
+    const rg_task_graph_t* graph;
+    SDL_AtomicInt* graph_pending;
+    SDL_AtomicInt* graph_ready;
+    uint32_t graph_capacity;
+    SDL_AtomicInt graph_push;
+    SDL_AtomicInt graph_pop;
 };
 
-static uint8_t rg_sdl_claim_task(rg_sdl_parallel_ctx_t* ctx, uint32_t* out_task_index)
+static void rg_sdl_run_claimed_tasks(rg_sdl_runner_t* runner, uint32_t worker_index)
 {
-    uint32_t task_index;
+    rg_parallel_task_fn task;
+    void* task_user_data;
+    uint32_t task_count;
 
-    if (ctx == NULL || out_task_index == NULL || ctx->mutex == NULL) {
-        return 0u;
-    }
-    SDL_LockMutex(ctx->mutex);
+    task = runner->task;
+    task_user_data = runner->task_user_data;
+    task_count = runner->task_count;
+    while (1) {
+        uint32_t task_index;
 
-    task_index = ctx->next_index;
-    if (task_index < ctx->task_count) {
-        ctx->next_index = task_index + 1u;
-    } else {
-        task_index = UINT32_MAX;
+        task_index = (uint32_t)SDL_AddAtomicInt(&runner->next_index, 1);
+        if (task_index >= task_count) {
+            break;
+        }
+        task(task_index, worker_index, task_user_data);
     }
+}
 
-    SDL_UnlockMutex(ctx->mutex);
+/* Spins, then parks, until a new phase is published or shutdown is requested. */
+static int rg_sdl_wait_for_phase(rg_sdl_runner_t* runner, int seen_generation)
+{
+    int generation;
+    uint32_t spin;
 
-    if (task_index == UINT32_MAX) {
-        return 0u;
+    for (spin = 0u; spin < RG_SDL_SPIN_ITERATIONS; ++spin) {
+        generation = SDL_GetAtomicInt(&runner->generation);
+        if (generation != seen_generation || SDL_GetAtomicInt(&runner->shutdown) != 0) {
+            return generation;
+        }
+        SDL_CPUPauseInstruction();
     }
 
-    *out_task_index = task_index;
-    return 1u;
+    SDL_LockMutex(runner->mutex);
+    while (1) {
+        generation = SDL_GetAtomicInt(&runner->generation);
+        if (generation != seen_generation || SDL_GetAtomicInt(&runner->shutdown) != 0) {
+            break;
+        }
+        runner->sleeping_helpers += 1u;
+        SDL_WaitCondition(runner->wake_cond, runner->mutex);
+        runner->sleeping_helpers -= 1u;
+    }
+    SDL_UnlockMutex(runner->mutex);
+    return generation;
 }
 
 static int rg_sdl_worker_main(void* user_data)
 {
     rg_sdl_worker_args_t* worker_args;
-    rg_sdl_parallel_ctx_t* ctx;
+    rg_sdl_runner_t* runner;
+    int seen_generation;
 
     worker_args = (rg_sdl_worker_args_t*)user_data;
-    if (worker_args == NULL || worker_args->ctx == NULL || worker_args->ctx->task == NULL) {
-        return 0;
-    }
-
-    ctx = worker_args->ctx;
+    runner = worker_args->runner;
+    seen_generation = 0;
     while (1) {
-        uint32_t task_index;
-
-        if (rg_sdl_claim_task(ctx, &task_index) == 0u) {
+        seen_generation = rg_sdl_wait_for_phase(runner, seen_generation);
+        if (SDL_GetAtomicInt(&runner->shutdown) != 0) {
             break;
         }
-        ctx->task(task_index, worker_args->worker_index, ctx->task_user_data);
+
+        rg_sdl_run_claimed_tasks(runner, worker_args->worker_index);
+
+        if (SDL_AddAtomicInt(&runner->busy_helpers, -1) == 1) {
+            SDL_SignalSemaphore(runner->done_sem);
+        }
     }
 
     return 0;
@@ -89,13 +156,7 @@ static rg_status_t rg_sdl_runner_parallel_for(
     void* task_user_data)
 {
     rg_sdl_runner_t* runner;
-    uint32_t worker_count;
-    uint32_t thread_count;
-    rg_sdl_parallel_ctx_t ctx;
-    rg_sdl_worker_args_t main_worker_args;
-    SDL_Thread** threads;
-    rg_sdl_worker_args_t* worker_args;
-    uint32_t created_threads;
+    uint32_t spin;
     uint32_t i;
 
     if (task == NULL) {
@@ -110,86 +171,249 @@ static rg_status_t rg_sdl_runner_parallel_for(
         return RG_STATUS_INVALID_ARGUMENT;
     }
 
-    worker_count = (runner->worker_count == 0u) ? 1u : runner->worker_count;
-    if (worker_count == 1u || task_count == 1u) {
+    if (runner->helper_count == 0u || task_count == 1u) {
         for (i = 0u; i < task_count; ++i) {
             task(i, 0u, task_user_data);
         }
         return RG_STATUS_OK;
     }
 
-    thread_count = worker_count;
-    if (thread_count > task_count) {
-        thread_count = task_count;
+    runner->task = task;
+    runner->task_user_data = task_user_data;
+    runner->task_count = task_count;
+    SDL_SetAtomicInt(&runner->next_index, 0);
+    SDL_SetAtomicInt(&runner->busy_helpers, (int)runner->helper_count);
+
+    SDL_LockMutex(runner->mutex);
+    SDL_AddAtomicInt(&runner->generation, 1);
+    if (runner->sleeping_helpers > 0u) {
+        SDL_BroadcastCondition(runner->wake_cond);
     }
+    SDL_UnlockMutex(runner->mutex);
 
-    threads = NULL;
-    worker_args = NULL;
-    created_threads = 0u;
+    rg_sdl_run_claimed_tasks(runner, 0u);
 
-    ctx.task = task;
-    ctx.task_user_data = task_user_data;
-    ctx.task_count = task_count;
-    ctx.next_index = 0u;
-    ctx.mutex = SDL_CreateMutex();
-    if (ctx.mutex == NULL) {
-        return RG_STATUS_ALLOCATION_FAILED;
+    /* The last helper posts done_sem exactly once per phase. */
+    for (spin = 0u; spin < RG_SDL_SPIN_ITERATIONS; ++spin) {
+        if (SDL_TryWaitSemaphore(runner->done_sem)) {
+            return RG_STATUS_OK;
+        }
+        SDL_CPUPauseInstruction();
     }
+    SDL_WaitSemaphore(runner->done_sem);
+    return RG_STATUS_OK;
+}
 
-    if (thread_count > 1u) {
-        threads = (SDL_Thread**)malloc((size_t)(thread_count - 1u) * sizeof(*threads));
-        worker_args = (rg_sdl_worker_args_t*)malloc((size_t)(thread_count - 1u) * sizeof(*worker_args));
-        if (threads == NULL || worker_args == NULL) {
-            free(threads);
-            free(worker_args);
-            SDL_DestroyMutex(ctx.mutex);
-            return RG_STATUS_ALLOCATION_FAILED;
+/*
+ * One worker's share of a graph, run as a parallel_for task per worker. Every
+ * task is queued exactly once, so claims past task_count mean the graph is
+ * drained; a claimed slot is filled once a running task releases its entry.
+ */
+static void rg_sdl_graph_worker(uint32_t task_index, uint32_t worker_index, void* user_data)
+{
+    rg_sdl_runner_t* runner;
+    const rg_task_graph_t* graph;
+
+    (void)task_index;
+
+    runner = (rg_sdl_runner_t*)user_data;
+    graph = runner->graph;
+    while (1) {
+        uint32_t slot;
+        uint32_t node;
+        uint32_t spin;
+        uint32_t i;
+
+        slot = (uint32_t)SDL_AddAtomicInt(&runner->graph_pop, 1);
+        if (slot >= graph->task_count) {
+            break;
         }
 
-        for (i = 0u; i < thread_count - 1u; ++i) {
-            worker_args[i].ctx = &ctx;
-            worker_args[i].worker_index = i + 1u;
-            threads[i] = SDL_CreateThread(rg_sdl_worker_main, "rg_worker", &worker_args[i]);
-            if (threads[i] == NULL) {
-                break;
+        spin = 0u;
+        while ((node = (uint32_t)SDL_GetAtomicInt(&runner->graph_ready[slot])) == 0u) {
+            if (spin < RG_SDL_SPIN_ITERATIONS) {
+                spin += 1u;
+                SDL_CPUPauseInstruction();
+            } else {
+                SDL_Delay(0u);
             }
-            created_threads += 1u;
         }
+        node -= 1u;
 
-        if (created_threads != (thread_count - 1u)) {
-            uint32_t join_index;
-            for (join_index = 0u; join_index < created_threads; ++join_index) {
-                SDL_WaitThread(threads[join_index], NULL);
+        graph->task(node, worker_index, graph->task_user_data);
+        for (i = graph->successor_offsets[node]; i < graph->successor_offsets[node + 1u]; ++i) {
+            uint32_t successor;
+
+            successor = graph->successors[i];
+            if (SDL_AddAtomicInt(&runner->graph_pending[successor], -1) == 1) {
+                slot = (uint32_t)SDL_AddAtomicInt(&runner->graph_push, 1);
+                SDL_SetAtomicInt(&runner->graph_ready[slot], (int)(successor + 1u));
             }
-            free(threads);
-            free(worker_args);
-            SDL_DestroyMutex(ctx.mutex);
+        }
+    }
+}
+
+static rg_status_t rg_sdl_runner_run_graph(void* runner_user, const rg_task_graph_t* graph)
+{
+    rg_sdl_runner_t* runner;
+    uint32_t ready_count;
+    uint32_t i;
+
+    runner = (rg_sdl_runner_t*)runner_user;
+    if (runner == NULL || graph == NULL || graph->task == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (graph->task_count == 0u) {
+        return RG_STATUS_OK;
+    }
+    if (graph->task_count >= (uint32_t)SDL_MAX_SINT32 || graph->dependency_offsets == NULL ||
+        graph->successor_offsets == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+
+    /* Edges must point backwards, which also rules out cycles that would hang the workers. */
+    for (i = 0u; i < graph->task_count; ++i) {
+        uint32_t edge;
+
+        for (edge = graph->dependency_offsets[i]; edge < graph->dependency_offsets[i + 1u]; ++edge) {
+            if (graph->dependencies[edge] >= i) {
+                return RG_STATUS_INVALID_ARGUMENT;
+            }
+        }
+    }
+
+    if (runner->helper_count == 0u || graph->task_count == 1u) {
+        for (i = 0u; i < graph->task_count; ++i) {
+            graph->task(i, 0u, graph->task_user_data);
+        }
+        return RG_STATUS_OK;
+    }
+
+    if (runner->graph_capacity < graph->task_count) {
+        SDL_AtomicInt* pending;
+        SDL_AtomicInt* ready;
+
+        pending = (SDL_AtomicInt*)malloc((size_t)graph->task_count * sizeof(*pending));
+        ready = (SDL_AtomicInt*)malloc((size_t)graph->task_count * sizeof(*ready));
+        if (pending == NULL || ready == NULL) {
+            free(pending);
+            free(ready);
             return RG_STATUS_ALLOCATION_FAILED;
         }
+        free(runner->graph_pending);
+        free(runner->graph_ready);
+        runner->graph_pending = pending;
+        runner->graph_ready = ready;
+        runner->graph_capacity = graph->task_count;
     }
 
-    main_worker_args.ctx = &ctx;
-    main_worker_args.worker_index = 0u;
-    (void)rg_sdl_worker_main(&main_worker_args);
+    for (i = 0u; i < graph->task_count; ++i) {
+        SDL_SetAtomicInt(&runner->graph_ready[i], 0);
+    }
 
-    for (i = 0u; i < created_threads; ++i) {
-        SDL_WaitThread(threads[i], NULL);
+    ready_count = 0u;
+    for (i = 0u; i < graph->task_count; ++i) {
+        SDL_SetAtomicInt(
+            &runner->graph_pending[i],
+            (int)(graph->dependency_offsets[i + 1u] - graph->dependency_offsets[i]));
+        if (graph->dependency_offsets[i + 1u] == graph->dependency_offsets[i]) {
+            SDL_SetAtomicInt(&runner->graph_ready[ready_count], (int)(i + 1u));
+            ready_count += 1u;
+        }
     }
+    SDL_SetAtomicInt(&runner->graph_push, (int)ready_count);
+    SDL_SetAtomicInt(&runner->graph_pop, 0);
+    runner->graph = graph;
 
-    free(threads);
-    free(worker_args);
-    SDL_DestroyMutex(ctx.mutex);
-    return RG_STATUS_OK;
+    return rg_sdl_runner_parallel_for(runner, runner->worker_count, rg_sdl_graph_worker, runner);
+}
+
+static int rg_sdl_async_main(void* user_data)
+{
+    rg_sdl_runner_t* runner;
+
+    runner = (rg_sdl_runner_t*)user_data;
+    SDL_LockMutex(runner->async_mutex);
+    while (1) {
+        rg_async_job_fn job;
+        void* job_user_data;
+
+        while (runner->async_job == NULL && runner->async_shutdown == 0u) {
+            SDL_WaitCondition(runner->async_cond, runner->async_mutex);
+        }
+        if (runner->async_job == NULL) {
+            break;
+        }
+
+        job = runner->async_job;
+        job_user_data = runner->async_user_data;
+        SDL_UnlockMutex(runner->async_mutex);
+        job(job_user_data);
+        SDL_LockMutex(runner->async_mutex);
+        runner->async_job = NULL;
+        SDL_BroadcastCondition(runner->async_cond);
+    }
+    SDL_UnlockMutex(runner->async_mutex);
+    return 0;
+}
+
+static rg_status_t rg_sdl_runner_submit(void* runner_user, rg_async_job_fn job, void* user_data)
+{
+    rg_sdl_runner_t* runner;
+    rg_status_t status;
+
+    runner = (rg_sdl_runner_t*)runner_user;
+    if (runner == NULL || job == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+
+    status = RG_STATUS_OK;
+    SDL_LockMutex(runner->async_mutex);
+    if (runner->async_job != NULL) {
+        status = RG_STATUS_CONFLICT;
+    } else if (runner->async_thread == NULL) {
+        runner->async_thread = SDL_CreateThread(rg_sdl_async_main, "rg_async", runner);
+        if (runner->async_thread == NULL) {
+            status = RG_STATUS_ALLOCATION_FAILED;
+        }
+    }
+    if (status == RG_STATUS_OK) {
+        runner->async_job = job;
+        runner->async_user_data = user_data;
+        SDL_BroadcastCondition(runner->async_cond);
+    }
+    SDL_UnlockMutex(runner->async_mutex);
+    return status;
+}
+
+static void rg_sdl_runner_wait(void* runner_user)
+{
+    rg_sdl_runner_t* runner;
+
+    runner = (rg_sdl_runner_t*)runner_user;
+    if (runner == NULL) {
+        return;
+    }
+
+    SDL_LockMutex(runner->async_mutex);
+    while (runner->async_job != NULL) {
+        SDL_WaitCondition(runner->async_cond, runner->async_mutex);
+    }
+    SDL_UnlockMutex(runner->async_mutex);
 }
 
 static const rg_runner_vtable_t g_rg_sdl_runner_vtable = {
     rg_sdl_runner_parallel_for,
-    rg_sdl_runner_worker_count
+    rg_sdl_runner_worker_count,
+    rg_sdl_runner_submit,
+    rg_sdl_runner_wait,
+    rg_sdl_runner_run_graph
 };
 
 rg_status_t rg_sdl_runner_create(uint32_t worker_count, rg_sdl_runner_t** out_runner)
 {
     rg_sdl_runner_t* runner;
+    uint32_t i;
 
     if (out_runner == NULL) {
         return RG_STATUS_INVALID_ARGUMENT;
@@ -200,7 +424,7 @@ rg_status_t rg_sdl_runner_create(uint32_t worker_count, rg_sdl_runner_t** out_ru
         worker_count = 1u;
     }
 
-    runner = (rg_sdl_runner_t*)malloc(sizeof(*runner));
+    runner = (rg_sdl_runner_t*)calloc(1u, sizeof(*runner));
     if (runner == NULL) {
         return RG_STATUS_ALLOCATION_FAILED;
     }
@@ -208,6 +432,39 @@ rg_status_t rg_sdl_runner_create(uint32_t worker_count, rg_sdl_runner_t** out_ru
     runner->runner.vtable = &g_rg_sdl_runner_vtable;
     runner->runner.user = runner;
     runner->worker_count = worker_count;
+    runner->helper_count = 0u;
+
+    runner->mutex = SDL_CreateMutex();
+    runner->wake_cond = SDL_CreateCondition();
+    runner->done_sem = SDL_CreateSemaphore(0u);
+    runner->async_mutex = SDL_CreateMutex();
+    runner->async_cond = SDL_CreateCondition();
+    if (runner->mutex == NULL || runner->wake_cond == NULL || runner->done_sem == NULL ||
+        runner->async_mutex == NULL || runner->async_cond == NULL) {
+        rg_sdl_runner_destroy(runner);
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+
+    if (worker_count > 1u) {
+        runner->threads = (SDL_Thread**)malloc((size_t)(worker_count - 1u) * sizeof(*runner->threads));
+        runner->worker_args =
+            (rg_sdl_worker_args_t*)malloc((size_t)(worker_count - 1u) * sizeof(*runner->worker_args));
+        if (runner->threads == NULL || runner->worker_args == NULL) {
+            rg_sdl_runner_destroy(runner);
+            return RG_STATUS_ALLOCATION_FAILED;
+        }
+
+        for (i = 0u; i < worker_count - 1u; ++i) {
+            runner->worker_args[i].runner = runner;
+            runner->worker_args[i].worker_index = i + 1u;
+            runner->threads[i] = SDL_CreateThread(rg_sdl_worker_main, "rg_worker", &runner->worker_args[i]);
+            if (runner->threads[i] == NULL) {
+                rg_sdl_runner_destroy(runner);
+                return RG_STATUS_ALLOCATION_FAILED;
+            }
+            runner->helper_count += 1u;
+        }
+    }
 
     *out_runner = runner;
     return RG_STATUS_OK;
@@ -215,6 +472,41 @@ rg_status_t rg_sdl_runner_create(uint32_t worker_count, rg_sdl_runner_t** out_ru
 
 void rg_sdl_runner_destroy(rg_sdl_runner_t* runner)
 {
+    uint32_t i;
+
+    if (runner == NULL) {
+        return;
+    }
+
+    /* A job still in flight finishes first; it may be driving the helpers. */
+    if (runner->async_thread != NULL) {
+        SDL_LockMutex(runner->async_mutex);
+        runner->async_shutdown = 1u;
+        SDL_BroadcastCondition(runner->async_cond);
+        SDL_UnlockMutex(runner->async_mutex);
+        SDL_WaitThread(runner->async_thread, NULL);
+    }
+
+    if (runner->helper_count > 0u) {
+        SDL_LockMutex(runner->mutex);
+        SDL_SetAtomicInt(&runner->shutdown, 1);
+        SDL_BroadcastCondition(runner->wake_cond);
+        SDL_UnlockMutex(runner->mutex);
+
+        for (i = 0u; i < runner->helper_count; ++i) {
+            SDL_WaitThread(runner->threads[i], NULL);
+        }
+    }
+
+    SDL_DestroyCondition(runner->async_cond);
+    SDL_DestroyMutex(runner->async_mutex);
+    SDL_DestroySemaphore(runner->done_sem);
+    SDL_DestroyCondition(runner->wake_cond);
+    SDL_DestroyMutex(runner->mutex);
+    free(runner->threads);
+    free(runner->worker_args);
+    free(runner->graph_pending);
+    free(runner->graph_ready);
     free(runner);
 }
 
@@ -0,0 +1,678 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
+#include "regolith/runner_thread.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+enum {
+    /* Polls of the phase generation before a worker parks on the condvar. */
+    RG_THREAD_SPIN_ITERATIONS = 4096,
+    RG_THREAD_CACHE_LINE_BYTES = 64
+};
+
+/*
+ * One worker's share of a phase as [head, tail) positions in its round-robin
+ * sequence, packed as head | tail << 32 so owner pops and thief steals race on
+ * a single CAS. Padded to keep deques on separate cache lines.
+ */
+typedef struct rg_thread_deque_s {
+    _Atomic uint64_t range;
+    uint8_t padding[RG_THREAD_CACHE_LINE_BYTES - sizeof(uint64_t)];
+} rg_thread_deque_t;
+
+typedef struct rg_thread_worker_args_s {
+    rg_thread_runner_t* runner;
+    uint32_t worker_index;
+} rg_thread_worker_args_t;
+
+struct rg_thread_runner_s {
+    rg_runner_t runner;
+    uint32_t worker_count;
+    uint32_t helper_count;
+    rg_thread_schedule_t schedule;
+    rg_thread_deque_t* deques;
+    pthread_t* threads;
+    rg_thread_worker_args_t* worker_args;
+
+    /*
+     * Job slots are written by the caller before generation is bumped and read
+     * by helpers after they observe the new generation.
+     */
+    rg_parallel_task_fn task;
+    void* task_user_data;
+    uint32_t task_count;
+    atomic_uint next_index;
+    atomic_uint generation;
+    atomic_uint busy_helpers;
+    atomic_uint shutdown;
+
+    /* Parking only; the fast path never takes the mutex on the worker side. */
+    pthread_mutex_t mutex;
+    pthread_cond_t wake_cond;
+    pthread_cond_t done_cond;
+    uint32_t sleeping_helpers;
+
+    /*
+     * Submitted jobs run on one extra thread, started on first submit, which
+     * then acts as worker 0 for any parallel_for the job issues. async_job is
+     * non-NULL from submit until the job has returned.
+     */
+    pthread_t async_thread;
+    uint8_t async_started;
+    uint8_t async_shutdown;
+    rg_async_job_fn async_job;
+    void* async_user_data;
+    pthread_mutex_t async_mutex;
+    pthread_cond_t async_cond;
+
+    /*
+     * run_graph state, grown on demand. graph_pending counts each task's
+     * unfinished dependencies; the task that finishes the last one appends the
+     * successor (as index + 1) at graph_push. Workers claim queue slots at
+     * graph_pop and wait for a claimed slot to be filled.
+     */
+    const rg_task_graph_t* graph;
+    atomic_uint* graph_pending;
+    atomic_uint* graph_ready;
+    uint32_t graph_capacity;
+    atomic_uint graph_push;
+    atomic_uint graph_pop;
+};
+
+static void rg_thread_cpu_relax(void)
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_ia32_pause();
+#elif defined(__GNUC__) && defined(__aarch64__)
+    __asm__ __volatile__("yield");
+#endif
+}
+
+static uint64_t rg_thread_pack_range(uint32_t head, uint32_t tail)
+{
+    return (uint64_t)head | ((uint64_t)tail << 32u);
+}
+
+static void rg_thread_deal_deques(rg_thread_runner_t* runner, uint32_t task_count)
+{
+    uint32_t worker_count;
+    uint32_t i;
+
+    worker_count = runner->worker_count;
+    for (i = 0u; i < worker_count; ++i) {
+        uint32_t owned;
+
+        owned = (task_count > i) ? ((task_count - i + worker_count - 1u) / worker_count) : 0u;
+        atomic_store_explicit(&runner->deques[i].range, rg_thread_pack_range(0u, owned), memory_order_relaxed);
+    }
+}
+
+/* Takes the owner's lowest position (from_tail == 0) or a thief's highest. */
+static uint8_t rg_thread_deque_take(rg_thread_deque_t* deque, uint8_t from_tail, uint32_t* out_position)
+{
+    uint64_t range;
+
+    range = atomic_load_explicit(&deque->range, memory_order_relaxed);
+    while (1) {
+        uint32_t head;
+        uint32_t tail;
+        uint64_t next;
+
+        head = (uint32_t)(range & UINT32_MAX);
+        tail = (uint32_t)(range >> 32u);
+        if (head >= tail) {
+            return 0u;
+        }
+
+        next = (from_tail != 0u) ? rg_thread_pack_range(head, tail - 1u) : rg_thread_pack_range(head + 1u, tail);
+        if (atomic_compare_exchange_weak_explicit(
+                &deque->range,
+                &range,
+                next,
+                memory_order_relaxed,
+                memory_order_relaxed)) {
+            *out_position = (from_tail != 0u) ? (tail - 1u) : head;
+            return 1u;
+        }
+    }
+}
+
+static void rg_thread_run_stealing(rg_thread_runner_t* runner, uint32_t worker_index)
+{
+    uint32_t worker_count;
+    uint32_t position;
+    uint32_t offset;
+
+    worker_count = runner->worker_count;
+    while (rg_thread_deque_take(&runner->deques[worker_index], 0u, &position) != 0u) {
+        runner->task(worker_index + (position * worker_count), worker_index, runner->task_user_data);
+    }
+
+    /* Nothing is pushed mid-phase, so one empty sweep over the victims ends it. */
+    offset = 1u;
+    while (offset < worker_count) {
+        uint32_t victim;
+
+        victim = (worker_index + offset) % worker_count;
+        if (rg_thread_deque_take(&runner->deques[victim], 1u, &position) == 0u) {
+            offset += 1u;
+            continue;
+        }
+        runner->task(victim + (position * worker_count), worker_index, runner->task_user_data);
+    }
+}
+
+static void rg_thread_run_claimed_tasks(rg_thread_runner_t* runner, uint32_t worker_index)
+{
+    rg_parallel_task_fn task;
+    void* task_user_data;
+    uint32_t task_count;
+
+    if (runner->schedule == RG_THREAD_SCHEDULE_WORK_STEALING) {
+        rg_thread_run_stealing(runner, worker_index);
+        return;
+    }
+
+    task = runner->task;
+    task_user_data = runner->task_user_data;
+    task_count = runner->task_count;
+    while (1) {
+        uint32_t task_index;
+
+        task_index = atomic_fetch_add_explicit(&runner->next_index, 1u, memory_order_relaxed);
+        if (task_index >= task_count) {
+            break;
+        }
+        task(task_index, worker_index, task_user_data);
+    }
+}
+
+/* Spins, then parks, until a new phase is published or shutdown is requested. */
+static unsigned rg_thread_wait_for_phase(rg_thread_runner_t* runner, unsigned seen_generation)
+{
+    unsigned generation;
+    uint32_t spin;
+
+    for (spin = 0u; spin < RG_THREAD_SPIN_ITERATIONS; ++spin) {
+        generation = atomic_load_explicit(&runner->generation, memory_order_acquire);
+        if (generation != seen_generation || atomic_load_explicit(&runner->shutdown, memory_order_acquire) != 0u) {
+            return generation;
+        }
+        rg_thread_cpu_relax();
+    }
+
+    pthread_mutex_lock(&runner->mutex);
+    while (1) {
+        generation = atomic_load_explicit(&runner->generation, memory_order_acquire);
+        if (generation != seen_generation || atomic_load_explicit(&runner->shutdown, memory_order_acquire) != 0u) {
+            break;
+        }
+        runner->sleeping_helpers += 1u;
+        pthread_cond_wait(&runner->wake_cond, &runner->mutex);
+        runner->sleeping_helpers -= 1u;
+    }
+    pthread_mutex_unlock(&runner->mutex);
+    return generation;
+}
+
+static void* rg_thread_worker_main(void* user_data)
+{
+    rg_thread_worker_args_t* worker_args;
+    rg_thread_runner_t* runner;
+    unsigned seen_generation;
+
+    worker_args = (rg_thread_worker_args_t*)user_data;
+    runner = worker_args->runner;
+    seen_generation = 0u;
+    while (1) {
+        seen_generation = rg_thread_wait_for_phase(runner, seen_generation);
+        if (atomic_load_explicit(&runner->shutdown, memory_order_acquire) != 0u) {
+            break;
+        }
+
+        rg_thread_run_claimed_tasks(runner, worker_args->worker_index);
+
+        if (atomic_fetch_sub_explicit(&runner->busy_helpers, 1u, memory_order_acq_rel) == 1u) {
+            pthread_mutex_lock(&runner->mutex);
+            pthread_cond_signal(&runner->done_cond);
+            pthread_mutex_unlock(&runner->mutex);
+        }
+    }
+
+    return NULL;
+}
+
+static uint32_t rg_thread_runner_worker_count(void* runner_user)
+{
+    const rg_thread_runner_t* runner;
+
+    runner = (const rg_thread_runner_t*)runner_user;
+    if (runner == NULL || runner->worker_count == 0u) {
+        return 1u;
+    }
+    return runner->worker_count;
+}
+
+static rg_status_t rg_thread_runner_parallel_for(
+    void* runner_user,
+    uint32_t task_count,
+    rg_parallel_task_fn task,
+    void* task_user_data)
+{
+    rg_thread_runner_t* runner;
+    uint32_t spin;
+    uint32_t i;
+
+    if (task == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (task_count == 0u) {
+        return RG_STATUS_OK;
+    }
+
+    runner = (rg_thread_runner_t*)runner_user;
+    if (runner == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+
+    if (runner->helper_count == 0u || task_count == 1u) {
+        for (i = 0u; i < task_count; ++i) {
+            task(i, 0u, task_user_data);
+        }
+        return RG_STATUS_OK;
+    }
+
+    runner->task = task;
+    runner->task_user_data = task_user_data;
+    runner->task_count = task_count;
+    atomic_store_explicit(&runner->next_index, 0u, memory_order_relaxed);
+    if (runner->schedule == RG_THREAD_SCHEDULE_WORK_STEALING) {
+        rg_thread_deal_deques(runner, task_count);
+    }
+    atomic_store_explicit(&runner->busy_helpers, runner->helper_count, memory_order_relaxed);
+
+    pthread_mutex_lock(&runner->mutex);
+    atomic_fetch_add_explicit(&runner->generation, 1u, memory_order_release);
+    if (runner->sleeping_helpers > 0u) {
+        pthread_cond_broadcast(&runner->wake_cond);
+    }
+    pthread_mutex_unlock(&runner->mutex);
+
+    rg_thread_run_claimed_tasks(runner, 0u);
+
+    for (spin = 0u; spin < RG_THREAD_SPIN_ITERATIONS; ++spin) {
+        if (atomic_load_explicit(&runner->busy_helpers, memory_order_acquire) == 0u) {
+            return RG_STATUS_OK;
+        }
+        rg_thread_cpu_relax();
+    }
+
+    pthread_mutex_lock(&runner->mutex);
+    while (atomic_load_explicit(&runner->busy_helpers, memory_order_acquire) != 0u) {
+        pthread_cond_wait(&runner->done_cond, &runner->mutex);
+    }
+    pthread_mutex_unlock(&runner->mutex);
+    return RG_STATUS_OK;
+}
+
+/*
+ * One worker's share of a graph, run as a parallel_for task per worker. Every
+ * task is queued exactly once, so claims past task_count mean the graph is
+ * drained; a claimed slot is filled once a running task releases its entry.
+ */
+static void rg_thread_graph_worker(uint32_t task_index, uint32_t worker_index, void* user_data)
+{
+    rg_thread_runner_t* runner;
+    const rg_task_graph_t* graph;
+
+    (void)task_index;
+
+    runner = (rg_thread_runner_t*)user_data;
+    graph = runner->graph;
+    while (1) {
+        uint32_t slot;
+        uint32_t node;
+        uint32_t spin;
+        uint32_t i;
+
+        slot = atomic_fetch_add_explicit(&runner->graph_pop, 1u, memory_order_relaxed);
+        if (slot >= graph->task_count) {
+            break;
+        }
+
+        spin = 0u;
+        while ((node = atomic_load_explicit(&runner->graph_ready[slot], memory_order_acquire)) == 0u) {
+            if (spin < RG_THREAD_SPIN_ITERATIONS) {
+                spin += 1u;
+                rg_thread_cpu_relax();
+            } else {
+                sched_yield();
+            }
+        }
+        node -= 1u;
+
+        graph->task(node, worker_index, graph->task_user_data);
+        for (i = graph->successor_offsets[node]; i < graph->successor_offsets[node + 1u]; ++i) {
+            uint32_t successor;
+
+            successor = graph->successors[i];
+            if (atomic_fetch_sub_explicit(&runner->graph_pending[successor], 1u, memory_order_acq_rel) == 1u) {
+                slot = atomic_fetch_add_explicit(&runner->graph_push, 1u, memory_order_relaxed);
+                atomic_store_explicit(&runner->graph_ready[slot], successor + 1u, memory_order_release);
+            }
+        }
+    }
+}
+
+static rg_status_t rg_thread_runner_run_graph(void* runner_user, const rg_task_graph_t* graph)
+{
+    rg_thread_runner_t* runner;
+    uint32_t ready_count;
+    uint32_t i;
+
+    runner = (rg_thread_runner_t*)runner_user;
+    if (runner == NULL || graph == NULL || graph->task == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (graph->task_count == 0u) {
+        return RG_STATUS_OK;
+    }
+    if (graph->task_count == UINT32_MAX || graph->dependency_offsets == NULL ||
+        graph->successor_offsets == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+
+    /* Edges must point backwards, which also rules out cycles that would hang the workers. */
+    for (i = 0u; i < graph->task_count; ++i) {
+        uint32_t edge;
+
+        for (edge = graph->dependency_offsets[i]; edge < graph->dependency_offsets[i + 1u]; ++edge) {
+            if (graph->dependencies[edge] >= i) {
+                return RG_STATUS_INVALID_ARGUMENT;
+            }
+        }
+    }
+
+    if (runner->helper_count == 0u || graph->task_count == 1u) {
+        for (i = 0u; i < graph->task_count; ++i) {
+            graph->task(i, 0u, graph->task_user_data);
+        }
+        return RG_STATUS_OK;
+    }
+
+    if (runner->graph_capacity < graph->task_count) {
+        atomic_uint* pending;
+        atomic_uint* ready;
+
+        pending = (atomic_uint*)malloc((size_t)graph->task_count * sizeof(*pending));
+        ready = (atomic_uint*)malloc((size_t)graph->task_count * sizeof(*ready));
+        if (pending == NULL || ready == NULL) {
+            free(pending);
+            free(ready);
+            return RG_STATUS_ALLOCATION_FAILED;
+        }
+        free(runner->graph_pending);
+        free(runner->graph_ready);
+        runner->graph_pending = pending;
+        runner->graph_ready = ready;
+        runner->graph_capacity = graph->task_count;
+    }
+
+    for (i = 0u; i < graph->task_count; ++i) {
+        atomic_init(&runner->graph_ready[i], 0u);
+    }
+
+    ready_count = 0u;
+    for (i = 0u; i < graph->task_count; ++i) {
+        atomic_init(&runner->graph_pending[i], graph->dependency_offsets[i + 1u] - graph->dependency_offsets[i]);
+        if (graph->dependency_offsets[i + 1u] == graph->dependency_offsets[i]) {
+            atomic_init(&runner->graph_ready[ready_count], i + 1u);
+            ready_count += 1u;
+        }
+    }
+    atomic_store_explicit(&runner->graph_push, ready_count, memory_order_relaxed);
+    atomic_store_explicit(&runner->graph_pop, 0u, memory_order_relaxed);
+    runner->graph = graph;
+
+    return rg_thread_runner_parallel_for(runner, runner->worker_count, rg_thread_graph_worker, runner);
+}
+
+static void* rg_thread_async_main(void* user_data)
+{
+    rg_thread_runner_t* runner;
+
+    runner = (rg_thread_runner_t*)user_data;
+    pthread_mutex_lock(&runner->async_mutex);
+    while (1) {
+        rg_async_job_fn job;
+        void* job_user_data;
+
+        while (runner->async_job == NULL && runner->async_shutdown == 0u) {
+            pthread_cond_wait(&runner->async_cond, &runner->async_mutex);
+        }
+        if (runner->async_job == NULL) {
+            break;
+        }
+
+        job = runner->async_job;
+        job_user_data = runner->async_user_data;
+        pthread_mutex_unlock(&runner->async_mutex);
+        job(job_user_data);
+        pthread_mutex_lock(&runner->async_mutex);
+        runner->async_job = NULL;
+        pthread_cond_broadcast(&runner->async_cond);
+    }
+    pthread_mutex_unlock(&runner->async_mutex);
+    return NULL;
+}
+
+static rg_status_t rg_thread_runner_submit(void* runner_user, rg_async_job_fn job, void* user_data)
+{
+    rg_thread_runner_t* runner;
+    rg_status_t status;
+
+    runner = (rg_thread_runner_t*)runner_user;
+    if (runner == NULL || job == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+
+    status = RG_STATUS_OK;
+    pthread_mutex_lock(&runner->async_mutex);
+    if (runner->async_job != NULL) {
+        status = RG_STATUS_CONFLICT;
+    } else if (runner->async_started == 0u) {
+        if (pthread_create(&runner->async_thread, NULL, rg_thread_async_main, runner) != 0) {
+            status = RG_STATUS_ALLOCATION_FAILED;
+        } else {
+            runner->async_started = 1u;
+        }
+    }
+    if (status == RG_STATUS_OK) {
+        runner->async_job = job;
+        runner->async_user_data = user_data;
+        pthread_cond_broadcast(&runner->async_cond);
+    }
+    pthread_mutex_unlock(&runner->async_mutex);
+    return status;
+}
+
+static void rg_thread_runner_wait(void* runner_user)
+{
+    rg_thread_runner_t* runner;
+
+    runner = (rg_thread_runner_t*)runner_user;
+    if (runner == NULL) {
+        return;
+    }
+
+    pthread_mutex_lock(&runner->async_mutex);
+    while (runner->async_job != NULL) {
+        pthread_cond_wait(&runner->async_cond, &runner->async_mutex);
+    }
+    pthread_mutex_unlock(&runner->async_mutex);
+}
+
+static const rg_runner_vtable_t g_rg_thread_runner_vtable = {
+    rg_thread_runner_parallel_for,
+    rg_thread_runner_worker_count,
+    rg_thread_runner_submit,
+    rg_thread_runner_wait,
+    rg_thread_runner_run_graph
+};
+
+static void rg_thread_runner_stop_helpers(rg_thread_runner_t* runner, uint32_t started_count)
+{
+    uint32_t i;
+
+    pthread_mutex_lock(&runner->mutex);
+    atomic_store_explicit(&runner->shutdown, 1u, memory_order_release);
+    pthread_cond_broadcast(&runner->wake_cond);
+    pthread_mutex_unlock(&runner->mutex);
+
+    for (i = 0u; i < started_count; ++i) {
+        pthread_join(runner->threads[i], NULL);
+    }
+}
+
+rg_status_t rg_thread_runner_create(uint32_t worker_count, rg_thread_runner_t** out_runner)
+{
+    rg_thread_runner_config_t cfg;
+
+    cfg.worker_count = worker_count;
+    cfg.schedule = RG_THREAD_SCHEDULE_SHARED;
+    return rg_thread_runner_create_with_config(&cfg, out_runner);
+}
+
+rg_status_t rg_thread_runner_create_with_config(
+    const rg_thread_runner_config_t* cfg,
+    rg_thread_runner_t** out_runner)
+{
+    rg_thread_runner_t* runner;
+    uint32_t worker_count;
+    uint32_t i;
+
+    if (out_runner == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    *out_runner = NULL;
+
+    if (cfg == NULL || (uint32_t)cfg->schedule > (uint32_t)RG_THREAD_SCHEDULE_WORK_STEALING) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    worker_count = (cfg->worker_count == 0u) ? 1u : cfg->worker_count;
+
+    runner = (rg_thread_runner_t*)calloc(1u, sizeof(*runner));
+    if (runner == NULL) {
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+
+    runner->runner.vtable = &g_rg_thread_runner_vtable;
+    runner->runner.user = runner;
+    runner->worker_count = worker_count;
+    runner->helper_count = worker_count - 1u;
+    runner->schedule = cfg->schedule;
+    atomic_init(&runner->next_index, 0u);
+    atomic_init(&runner->generation, 0u);
+    atomic_init(&runner->busy_helpers, 0u);
+    atomic_init(&runner->shutdown, 0u);
+    atomic_init(&runner->graph_push, 0u);
+    atomic_init(&runner->graph_pop, 0u);
+
+    if (pthread_mutex_init(&runner->mutex, NULL) != 0) {
+        free(runner);
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+    if (pthread_cond_init(&runner->wake_cond, NULL) != 0) {
+        pthread_mutex_destroy(&runner->mutex);
+        free(runner);
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+    if (pthread_cond_init(&runner->done_cond, NULL) != 0) {
+        pthread_cond_destroy(&runner->wake_cond);
+        pthread_mutex_destroy(&runner->mutex);
+        free(runner);
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+    if (pthread_mutex_init(&runner->async_mutex, NULL) != 0) {
+        pthread_cond_destroy(&runner->done_cond);
+        pthread_cond_destroy(&runner->wake_cond);
+        pthread_mutex_destroy(&runner->mutex);
+        free(runner);
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+    if (pthread_cond_init(&runner->async_cond, NULL) != 0) {
+        pthread_mutex_destroy(&runner->async_mutex);
+        pthread_cond_destroy(&runner->done_cond);
+        pthread_cond_destroy(&runner->wake_cond);
+        pthread_mutex_destroy(&runner->mutex);
+        free(runner);
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+
+    if (runner->helper_count > 0u) {
+        runner->threads = (pthread_t*)malloc((size_t)runner->helper_count * sizeof(*runner->threads));
+        runner->worker_args =
+            (rg_thread_worker_args_t*)malloc((size_t)runner->helper_count * sizeof(*runner->worker_args));
+        runner->deques = (rg_thread_deque_t*)calloc((size_t)worker_count, sizeof(*runner->deques));
+        if (runner->threads == NULL || runner->worker_args == NULL || runner->deques == NULL) {
+            runner->helper_count = 0u;
+            rg_thread_runner_destroy(runner);
+            return RG_STATUS_ALLOCATION_FAILED;
+        }
+
+        for (i = 0u; i < runner->helper_count; ++i) {
+            runner->worker_args[i].runner = runner;
+            runner->worker_args[i].worker_index = i + 1u;
+            if (pthread_create(&runner->threads[i], NULL, rg_thread_worker_main, &runner->worker_args[i]) != 0) {
+                runner->helper_count = i;
+                rg_thread_runner_destroy(runner);
+                return RG_STATUS_ALLOCATION_FAILED;
+            }
+        }
+    }
+
+    *out_runner = runner;
+    return RG_STATUS_OK;
+}
+
+void rg_thread_runner_destroy(rg_thread_runner_t* runner)
+{
+    if (runner == NULL) {
+        return;
+    }
+
+    /* A job still in flight finishes first; it may be driving the helpers. */
+    pthread_mutex_lock(&runner->async_mutex);
+    runner->async_shutdown = 1u;
+    pthread_cond_broadcast(&runner->async_cond);
+    pthread_mutex_unlock(&runner->async_mutex);
+    if (runner->async_started != 0u) {
+        pthread_join(runner->async_thread, NULL);
+    }
+
+    rg_thread_runner_stop_helpers(runner, runner->helper_count);
+    pthread_cond_destroy(&runner->async_cond);
+    pthread_mutex_destroy(&runner->async_mutex);
+    pthread_cond_destroy(&runner->done_cond);
+    pthread_cond_destroy(&runner->wake_cond);
+    pthread_mutex_destroy(&runner->mutex);
+    free(runner->threads);
+    free(runner->worker_args);
+    free(runner->deques);
+    free(runner->graph_pending);
+    free(runner->graph_ready);
+    free(runner);
+}
+
+const rg_runner_t* rg_thread_runner_get_runner(const rg_thread_runner_t* runner)
+{
+    if (runner == NULL) {
+        return NULL;
+    }
+    return &runner->runner;
+}
@@ -1,10 +1,24 @@
+#ifndef _POSIX_C_SOURCE
+#define _POSIX_C_SOURCE 200809L
+#endif
+
 #include "regolith/world.h"
 
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #if defined(_MSC_VER)
 #include <malloc.h>
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#endif
+
+#if !defined(__STDC_NO_ATOMICS__)
+#include <stdatomic.h>
+#define RG_HAVE_ATOMICS 1
+#else
+#define RG_HAVE_ATOMICS 0
 #endif
 
 enum {
@@ -13,7 +27,40 @@ enum {
     RG_DEFAULT_INLINE_PAYLOAD_BYTES = 16,
     RG_DEFAULT_MAX_MATERIALS = 256,
     RG_DEFAULT_INITIAL_CHUNKS = 16,
-    RG_CHUNK_SLEEP_TICKS = 8
+    RG_DEFAULT_CHUNK_SLEEP_TICKS = 8,
+    RG_DEFAULT_LOD_BAND_WIDTH = 2,
+    RG_DEFAULT_LOD_MAX_PERIOD = 8,
+    RG_MAX_LOD_PERIOD = 1 << 16,
+    RG_RANDOM_BLOCK_WORDS = 8,
+    RG_CACHE_LINE_BYTES = 64
+};
+
+#ifndef RG_CACHE_LINE_PADDING
+#define RG_CACHE_LINE_PADDING 1
+#endif
+
+/*
+ * Starts a struct on its own cache line and rounds its size up to whole lines,
+ * for state that different workers write during a phase. Configure with
+ * REGOLITH_CACHE_LINE_PADDING=OFF to measure the packed layout.
+ */
+#if RG_CACHE_LINE_PADDING
+#define RG_CACHE_ALIGNED _Alignas(RG_CACHE_LINE_BYTES)
+#else
+#define RG_CACHE_ALIGNED
+#endif
+
+/* Neighbor directions in chunk table order ((dy, dx) lexicographic). */
+enum {
+    RG_DIR_NW = 0,
+    RG_DIR_N = 1,
+    RG_DIR_NE = 2,
+    RG_DIR_W = 3,
+    RG_DIR_E = 4,
+    RG_DIR_SW = 5,
+    RG_DIR_S = 6,
+    RG_DIR_SE = 7,
+    RG_DIR_COUNT = 8
 };
 
 typedef struct rg_material_record_s {
@@ -32,15 +79,43 @@ typedef struct rg_material_record_s {
     uint8_t used;
 } rg_material_record_t;
 
-typedef struct rg_chunk_s {
-    uint16_t* material_ids;
+typedef struct rg_chunk_s rg_chunk_t;
+
+/* Cache aligned: tasks on different workers update their own chunks' headers. */
+struct rg_chunk_s {
+    RG_CACHE_ALIGNED uint16_t* material_ids;
     uint8_t* inline_payload;
     void** overflow_payloads;
     uint8_t* updated_mask;
+    uint64_t mask_tick;
     uint32_t live_cells;
     uint32_t idle_steps;
+    uint32_t sleep_ticks;
+    uint64_t sleep_tick;
+    uint8_t woke_early;
+    /* Chebyshev chunk distance to the nearest focus point (UINT32_MAX without focus). */
+    uint32_t focus_distance;
+    /* The chunk steps every (1 << lod_shift) ticks. */
+    uint8_t lod_shift;
+    int32_t priority;
+    /* Budgeted steps this chunk was due in but not stepped since it last ran. */
+    uint32_t deferred_age;
+    /* Tile mode: some tile of this chunk changed during the current tick. */
+    uint8_t tile_changed;
+    uint32_t entry_index;
+    uint32_t active_slot;
+    rg_chunk_t* neighbors[RG_DIR_COUNT];
+    uint8_t border_dirty;
+    uint8_t color;
     uint8_t awake;
-} rg_chunk_t;
+};
+
+typedef struct rg_chunk_list_s {
+    uint32_t* indices;
+    uint32_t count;
+    uint32_t capacity;
+    uint8_t unsorted; /* Indices left chunk table order; restored by the next snapshot. */
+} rg_chunk_list_t;
 
 typedef struct rg_chunk_entry_s {
     int32_t chunk_x;
@@ -48,6 +123,133 @@ typedef struct rg_chunk_entry_s {
     rg_chunk_t* chunk;
 } rg_chunk_entry_t;
 
+typedef struct rg_cross_intent_s {
+    uint32_t source_chunk_index;
+    uint32_t target_chunk_index;
+    uint32_t source_cell_index;
+    uint32_t target_cell_index;
+    rg_material_id_t source_material_id;
+    rg_material_id_t target_material_id;
+} rg_cross_intent_t;
+
+/* Packed merge ordering of one intent: (target cell, source cell) as global cell ids. */
+typedef struct rg_intent_sort_entry_s {
+    uint64_t key;
+    uint32_t intent_index;
+    uint8_t applied;
+} rg_intent_sort_entry_t;
+
+/* Sorted entries [begin, end) that share one target chunk. */
+typedef struct rg_intent_bucket_s {
+    uint32_t begin;
+    uint32_t end;
+} rg_intent_bucket_t;
+
+/* How checkerboard tasks commit moves that leave their chunk. */
+typedef enum rg_remote_commit_e {
+    RG_REMOTE_COMMIT_INTENTS = 0,
+    RG_REMOTE_COMMIT_ATOMIC = 1,
+    RG_REMOTE_COMMIT_HALO = 2
+} rg_remote_commit_t;
+
+/*
+ * Per-task results, the task-local slots of a phase: each is written by one
+ * task and reduced into the world after the barrier. Cache aligned, so
+ * neighboring slots stepped by different workers never share a line.
+ */
+typedef struct rg_task_output_s {
+    RG_CACHE_ALIGNED rg_cross_intent_t* intents;
+    uint32_t intent_count;
+    uint32_t intent_capacity;
+    uint64_t emitted_move_count;
+    /* World-wide counters accumulated per task and folded in after the barrier. */
+    int64_t live_cell_delta;
+    uint64_t payload_overflow_allocs;
+    uint64_t payload_overflow_frees;
+    /*
+     * Tile tasks own only [tile_x0, tile_x1) x [tile_y0, tile_y1) of their chunk:
+     * moves leaving it become intents, and chunk-level bookkeeping (live cells,
+     * border bits, idle/awake) is collected here and applied after the barrier.
+     */
+    int32_t tile_x0;
+    int32_t tile_y0;
+    int32_t tile_x1;
+    int32_t tile_y1;
+    int64_t chunk_live_delta;
+    uint8_t border_dirty;
+    uint8_t tiled;
+    uint8_t changed;
+    uint8_t skipped;
+    /*
+     * Atomic and halo modes commit moves into neighbor chunks in place; their
+     * chunk-level bookkeeping is collected per RG_DIR_* and applied after the
+     * barrier. Halo mode also lists the neighbor cells it wrote in intents,
+     * whose update-mask bits are set then.
+     */
+    uint8_t remote_commit;
+    uint8_t neighbor_touched;
+    uint8_t neighbor_border_dirty[RG_DIR_COUNT];
+    int32_t neighbor_live_delta[RG_DIR_COUNT];
+    /*
+     * Cross-phase graph tasks apply their own intents, keeping only the applied
+     * ones in intents. Neighbors' wake state is left to their own tasks (or the
+     * stepping thread), so the RG_DIR_* bits of neighbors a border flush reached
+     * and the world counters a barrier phase would have bumped are kept here.
+     */
+    uint8_t neighbor_flushed;
+    uint8_t lod_skipped;
+    uint32_t cross_intent_count;
+    uint32_t intent_conflicts;
+    uint32_t chunk_wakes;
+    uint32_t chunk_sleeps;
+} rg_task_output_t;
+
+typedef struct rg_budget_key_s {
+    uint32_t deferred_age;
+    int32_t priority;
+    uint32_t focus_distance;
+    uint32_t chunk_index;
+} rg_budget_key_t;
+
+typedef struct rg_step_budget_s {
+    rg_clock_now_fn clock_now_ns;
+    void* clock_user;
+    uint64_t deadline_ns;
+    /* Task 0 ignores the deadline so a budgeted step always makes progress. */
+    uint8_t run_first;
+} rg_step_budget_t;
+
+typedef struct rg_checkerboard_task_ctx_s {
+    rg_world_t* world;
+    uint64_t tick;
+    const uint32_t* chunk_indices;
+    uint32_t chunk_count;
+    /*
+     * Runner tasks; task t steps chunk positions t, t + task_count, ... or,
+     * with block_offsets, the positions of blocks t, t + task_count, ...
+     */
+    uint32_t task_count;
+    const uint32_t* block_offsets;
+    uint32_t block_count;
+    rg_task_output_t* outputs;
+    const rg_step_budget_t* budget;
+    rg_remote_commit_t remote_commit;
+    uint64_t simulate_start_ns;
+} rg_checkerboard_task_ctx_t;
+
+/*
+ * One cross-phase graph step: task t steps chunk chunk_indices[t], and
+ * chunk_tasks maps chunk table indices back to tasks (UINT32_MAX for chunks
+ * without one). Tasks are ordered by color, the phase they run in.
+ */
+typedef struct rg_checkerboard_graph_ctx_s {
+    rg_world_t* world;
+    uint64_t tick;
+    const uint32_t* chunk_indices;
+    const uint32_t* chunk_tasks;
+    rg_task_output_t* outputs;
+} rg_checkerboard_graph_ctx_t;
+
 struct rg_world_s {
     rg_allocator_t allocator;
     const rg_runner_t* runner;
@@ -60,7 +262,23 @@ struct rg_world_s {
     uint32_t cells_per_chunk;
     uint16_t inline_payload_bytes;
     uint16_t max_materials;
-    uint8_t* swap_payload;
+    uint8_t sleep_adaptive;
+    uint32_t sleep_ticks;
+    uint32_t sleep_ticks_min;
+    uint32_t sleep_ticks_max;
+    uint32_t lod_radius;
+    uint32_t lod_band;
+    uint8_t lod_max_shift;
+    uint32_t checkerboard_grain;
+    /* Chunks per block side; checkerboard colors and tasks are per block. */
+    int32_t checkerboard_block;
+    int32_t tile_width;
+    int32_t tile_height;
+    /* Focus points in chunk coordinates. */
+    rg_cell_coord_t* focus_chunks;
+    uint32_t focus_count;
+    /* Per local cell index: RG_DIR_* bits of the neighbor chunks that border it. */
+    uint8_t* cell_border_bits;
 
     rg_material_record_t* materials;
     rg_material_id_t material_count;
@@ -69,39 +287,128 @@ struct rg_world_s {
     uint32_t chunk_count;
     uint32_t chunk_capacity;
 
+    /*
+     * Awake chunks by checkerboard color ((block_x & 1) | (block_y & 1) << 1,
+     * block coordinates being chunk coordinates floor-divided by
+     * checkerboard_block), holding chunk table indices. While a parallel phase
+     * is running, tasks only flip chunk->awake and the lists are reconciled after
+     * the phase barrier.
+     */
+    rg_chunk_list_t active_lists[4];
+    uint8_t active_sync_deferred;
     uint32_t active_chunk_count;
     uint64_t live_cells;
     uint64_t step_index;
+    uint64_t step_tick;
+
+    /*
+     * Set by rg_world_step_begin and cleared by rg_world_step_wait, both on the
+     * calling thread; the async_* fields hand the step to the runner job.
+     */
+    uint8_t step_in_flight;
+    rg_step_mode_t async_mode;
+    uint32_t async_substeps;
+    rg_status_t async_status;
     uint64_t intents_emitted_last_step;
     uint64_t intent_conflicts_last_step;
+    uint64_t cross_intents_last_step;
     uint64_t payload_overflow_allocs;
     uint64_t payload_overflow_frees;
+    uint64_t chunk_wakes_last_step;
+    uint64_t chunk_sleeps_last_step;
+    uint64_t chunk_wakes_total;
+    uint64_t chunk_sleeps_total;
+    uint64_t lod_skipped_chunks_last_step;
+    uint64_t budget_deferred_chunks_last_step;
+    uint64_t step_setup_ns_last_step;
+    uint64_t step_simulate_ns_last_step;
+
+    /*
+     * Step scratch, grown on demand and reused across phases, substeps and steps
+     * so steady-state stepping does not allocate. Task outputs keep their intent
+     * buffers; only the counts are reset per phase.
+     */
+    uint32_t* scratch_chunk_indices;
+    uint32_t scratch_chunk_index_capacity;
+    rg_task_output_t* scratch_outputs;
+    uint32_t scratch_output_capacity;
+    /* Intent arena; each task output of a phase owns a fixed slice. */
+    rg_cross_intent_t* scratch_intents;
+    uint32_t scratch_intent_capacity;
+    rg_cross_intent_t* scratch_merged;
+    uint32_t scratch_merged_capacity;
+    /* Two halves of scratch_intent_sort_capacity / 2 entries: radix source and destination. */
+    rg_intent_sort_entry_t* scratch_intent_sort;
+    uint32_t scratch_intent_sort_capacity;
+    /* Two halves as well: buckets in target chunk order, then grouped by color. */
+    rg_intent_bucket_t* scratch_intent_buckets;
+    uint32_t scratch_intent_bucket_capacity;
+    /* Task graphs for runners with run_graph: dependency, then successor offsets and edges. */
+    uint32_t* scratch_merge_graph;
+    uint32_t scratch_merge_graph_capacity;
+    /* Cross-phase graph task of each chunk table index; all UINT32_MAX outside a step. */
+    uint32_t* scratch_chunk_tasks;
+    uint32_t scratch_chunk_task_capacity;
+    rg_budget_key_t* scratch_budget_keys;
+    uint32_t scratch_budget_key_capacity;
+    uint64_t* scratch_cost_keys;
+    uint32_t scratch_cost_key_capacity;
+    /* Block tasks: phase positions [offsets[b], offsets[b + 1]) are the chunks of block b. */
+    uint32_t* scratch_block_offsets;
+    uint32_t scratch_block_offset_capacity;
+    /* Chunk of each tile task in the current phase; the tile rectangle is in its output. */
+    uint32_t* scratch_tile_chunks;
+    uint32_t scratch_tile_chunk_capacity;
+    /* Set while rg_world_reserve_step_scratch grows scratch, so it is not counted as a fallback. */
+    uint8_t scratch_reserving;
+    uint64_t step_scratch_allocs;
+
+    /*
+     * rg_world_step_batch: the resolved mode, this world's prepared phase and
+     * where its tasks start in the shared dispatch.
+     */
+    uint8_t batch_member;
+    rg_step_mode_t batch_mode;
+    rg_status_t batch_status;
+    rg_checkerboard_task_ctx_t batch_phase;
+    uint32_t batch_task_begin;
 };
 
-typedef struct rg_cross_intent_s {
-    uint32_t source_chunk_index;
-    uint32_t target_chunk_index;
-    uint32_t source_cell_index;
-    uint32_t target_cell_index;
-    rg_material_id_t source_material_id;
-    rg_material_id_t target_material_id;
-} rg_cross_intent_t;
-
-typedef struct rg_task_output_s {
-    rg_cross_intent_t* intents;
-    uint32_t intent_count;
-    uint32_t intent_capacity;
-    uint64_t emitted_move_count;
-    uint8_t changed;
-} rg_task_output_t;
-
-typedef struct rg_checkerboard_task_ctx_s {
+typedef struct rg_tile_task_ctx_s {
     rg_world_t* world;
     uint64_t tick;
     const uint32_t* chunk_indices;
-    uint32_t chunk_count;
+    uint32_t task_count;
     rg_task_output_t* outputs;
-} rg_checkerboard_task_ctx_t;
+} rg_tile_task_ctx_t;
+
+/* Worlds of one rg_world_step_batch phase; each world's batch_phase holds its tasks. */
+typedef struct rg_batch_task_ctx_s {
+    rg_world_t* const* worlds;
+    uint32_t world_count;
+} rg_batch_task_ctx_t;
+
+typedef struct rg_intent_apply_ctx_s {
+    rg_world_t* world;
+    const rg_cross_intent_t* merged;
+    rg_intent_sort_entry_t* sorted;
+    const rg_intent_bucket_t* buckets;
+    uint32_t bucket_count;
+    /* Graph merges: buckets of color c are [color_offsets[c], color_offsets[c + 1]). */
+    const uint32_t* color_offsets;
+} rg_intent_apply_ctx_t;
+
+/*
+ * Counter-based bit stream keyed by (seed, tick, chunk, salt). Bit i belongs to
+ * cell (or row) i and is produced from the counter i / 64 alone, so values never
+ * depend on visiting order or on which worker steps the chunk. Words are filled
+ * a block at a time.
+ */
+typedef struct rg_random_stream_s {
+    uint64_t key;
+    uint32_t block_index;
+    uint64_t words[RG_RANDOM_BLOCK_WORDS];
+} rg_random_stream_t;
 
 struct rg_update_ctx_s {
     rg_world_t* world;
@@ -124,6 +431,40 @@ static int rg_is_power_of_two_u32(uint32_t value)
     return value != 0u && (value & (value - 1u)) == 0u;
 }
 
+static uint64_t rg_default_clock_now_ns(void* user)
+{
+#if defined(_MSC_VER)
+    LARGE_INTEGER freq;
+    LARGE_INTEGER counter;
+    uint64_t ticks;
+    uint64_t ticks_per_sec;
+
+    (void)user;
+    if (!QueryPerformanceFrequency(&freq) || !QueryPerformanceCounter(&counter)) {
+        return 0u;
+    }
+    ticks = (uint64_t)counter.QuadPart;
+    ticks_per_sec = (uint64_t)freq.QuadPart;
+    /* Split the conversion so large tick counts do not overflow. */
+    return ((ticks / ticks_per_sec) * 1000000000ull) +
+           (((ticks % ticks_per_sec) * 1000000000ull) / ticks_per_sec);
+#else
+    struct timespec ts;
+
+    (void)user;
+    if (clock_gettime(CLOCK_MONOTONIC, &ts) != 0) {
+        return 0u;
+    }
+    return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+/* Clamped so a clock that reads backwards records zero rather than wrapping. */
+static uint64_t rg_elapsed_ns(uint64_t start_ns, uint64_t end_ns)
+{
+    return (end_ns > start_ns) ? end_ns - start_ns : 0u;
+}
+
 static uint64_t rg_mix_u64(uint64_t value)
 {
     value ^= value >> 30u;
@@ -275,18 +616,41 @@ static uint8_t rg_chunk_coord_less(int32_t ax, int32_t ay, int32_t bx, int32_t b
     return (uint8_t)(ax < bx);
 }
 
+static uint32_t rg_chunk_lower_bound(const rg_world_t* world, int32_t chunk_x, int32_t chunk_y)
+{
+    uint32_t lo;
+    uint32_t hi;
+
+    lo = 0u;
+    hi = world->chunk_count;
+    while (lo < hi) {
+        uint32_t mid;
+        const rg_chunk_entry_t* entry;
+
+        mid = lo + ((hi - lo) >> 1u);
+        entry = &world->chunks[mid];
+        if (rg_chunk_coord_less(entry->chunk_x, entry->chunk_y, chunk_x, chunk_y) != 0u) {
+            lo = mid + 1u;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
 static uint32_t rg_chunk_find_index(const rg_world_t* world, int32_t chunk_x, int32_t chunk_y)
 {
-    uint32_t i;
+    uint32_t index;
 
     if (world == NULL) {
         return UINT32_MAX;
     }
 
-    for (i = 0u; i < world->chunk_count; ++i) {
-        if (world->chunks[i].chunk_x == chunk_x && world->chunks[i].chunk_y == chunk_y) {
-            return i;
-        }
+    index = rg_chunk_lower_bound(world, chunk_x, chunk_y);
+    if (index < world->chunk_count &&
+        world->chunks[index].chunk_x == chunk_x &&
+        world->chunks[index].chunk_y == chunk_y) {
+        return index;
     }
 
     return UINT32_MAX;
@@ -336,2158 +700,5771 @@ static rg_status_t rg_chunk_reserve(rg_world_t* world, uint32_t min_capacity)
     return RG_STATUS_OK;
 }
 
-static void rg_chunk_set_awake(rg_world_t* world, rg_chunk_t* chunk, uint8_t awake)
+static rg_status_t rg_chunk_list_reserve(rg_world_t* world, rg_chunk_list_t* list, uint32_t min_capacity)
 {
-    if (world == NULL || chunk == NULL) {
-        return;
-    }
+    uint32_t new_capacity;
+    uint32_t* new_indices;
 
-    awake = (uint8_t)(awake != 0u);
-    if (chunk->awake == awake) {
-        return;
+    if (list->capacity >= min_capacity) {
+        return RG_STATUS_OK;
     }
 
-    chunk->awake = awake;
-    if (awake != 0u) {
-        world->active_chunk_count += 1u;
-    } else if (world->active_chunk_count > 0u) {
-        world->active_chunk_count -= 1u;
+    new_capacity = (list->capacity == 0u) ? RG_DEFAULT_INITIAL_CHUNKS : list->capacity;
+    while (new_capacity < min_capacity) {
+        if (new_capacity > UINT32_MAX / 2u) {
+            return RG_STATUS_CAPACITY_REACHED;
+        }
+        new_capacity *= 2u;
     }
-}
-
-static void rg_recompute_active_chunk_count(rg_world_t* world)
-{
-    uint32_t count;
-    uint32_t i;
 
-    if (world == NULL) {
-        return;
+    new_indices = (uint32_t*)rg_alloc_bytes(
+        &world->allocator,
+        (size_t)new_capacity * sizeof(*new_indices),
+        _Alignof(uint32_t));
+    if (new_indices == NULL) {
+        return RG_STATUS_ALLOCATION_FAILED;
     }
 
-    count = 0u;
-    for (i = 0u; i < world->chunk_count; ++i) {
-        rg_chunk_t* chunk;
-
-        chunk = world->chunks[i].chunk;
-        if (chunk != NULL && chunk->awake != 0u) {
-            count += 1u;
-        }
+    if (list->count > 0u) {
+        memcpy(new_indices, list->indices, (size_t)list->count * sizeof(*new_indices));
     }
+    rg_free_bytes(
+        &world->allocator,
+        list->indices,
+        (size_t)list->capacity * sizeof(*new_indices),
+        _Alignof(uint32_t));
 
-    world->active_chunk_count = count;
+    list->indices = new_indices;
+    list->capacity = new_capacity;
+    return RG_STATUS_OK;
 }
 
-static void rg_set_chunk_awake_for_mode(
-    rg_world_t* world,
-    rg_chunk_t* chunk,
-    uint8_t awake,
-    rg_task_output_t* task_output)
+static void rg_chunk_list_release(rg_world_t* world, rg_chunk_list_t* list)
 {
-    if (chunk == NULL) {
-        return;
-    }
-
-    if (task_output != NULL) {
-        chunk->awake = (uint8_t)(awake != 0u);
-    } else {
-        rg_chunk_set_awake(world, chunk, awake);
-    }
+    rg_free_bytes(
+        &world->allocator,
+        list->indices,
+        (size_t)list->capacity * sizeof(*list->indices),
+        _Alignof(uint32_t));
+    memset(list, 0, sizeof(*list));
 }
 
-static uint8_t rg_mask_test(const rg_chunk_t* chunk, uint32_t cell_index)
+/* Grows a scratch array without preserving its contents. */
+static rg_status_t rg_scratch_reserve(
+    rg_world_t* world,
+    void** buffer,
+    uint32_t* capacity,
+    uint32_t min_capacity,
+    size_t element_size,
+    size_t alignment)
 {
-    uint32_t byte_index;
-    uint32_t bit_index;
+    uint32_t new_capacity;
+    void* new_buffer;
 
-    if (chunk == NULL || chunk->updated_mask == NULL) {
-        return 0u;
+    if (*capacity >= min_capacity) {
+        return RG_STATUS_OK;
     }
 
-    byte_index = cell_index >> 3u;
-    bit_index = cell_index & 7u;
-    return (uint8_t)((chunk->updated_mask[byte_index] >> bit_index) & 1u);
-}
+    new_capacity = (*capacity == 0u) ? RG_DEFAULT_INITIAL_CHUNKS : *capacity;
+    while (new_capacity < min_capacity) {
+        if (new_capacity > UINT32_MAX / 2u) {
+            return RG_STATUS_CAPACITY_REACHED;
+        }
+        new_capacity *= 2u;
+    }
 
-static void rg_mask_set(rg_chunk_t* chunk, uint32_t cell_index)
-{
-    uint32_t byte_index;
-    uint32_t bit_index;
+    new_buffer = rg_alloc_bytes(&world->allocator, (size_t)new_capacity * element_size, alignment);
+    if (new_buffer == NULL) {
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
 
-    if (chunk == NULL || chunk->updated_mask == NULL) {
-        return;
+    rg_free_bytes(&world->allocator, *buffer, (size_t)*capacity * element_size, alignment);
+    *buffer = new_buffer;
+    *capacity = new_capacity;
+    if (world->scratch_reserving == 0u) {
+        world->step_scratch_allocs += 1u;
     }
+    return RG_STATUS_OK;
+}
 
-    byte_index = cell_index >> 3u;
-    bit_index = cell_index & 7u;
-    chunk->updated_mask[byte_index] = (uint8_t)(chunk->updated_mask[byte_index] | (uint8_t)(1u << bit_index));
+static rg_status_t rg_scratch_reserve_chunk_indices(rg_world_t* world, uint32_t min_capacity)
+{
+    return rg_scratch_reserve(
+        world,
+        (void**)&world->scratch_chunk_indices,
+        &world->scratch_chunk_index_capacity,
+        min_capacity,
+        sizeof(*world->scratch_chunk_indices),
+        _Alignof(uint32_t));
 }
 
-static void rg_mask_clear_all(rg_world_t* world, rg_chunk_t* chunk)
+/* Grown buffers are filled with UINT32_MAX, the state the map is kept in between steps. */
+static rg_status_t rg_scratch_reserve_chunk_tasks(rg_world_t* world, uint32_t min_capacity)
 {
-    size_t mask_bytes;
+    uint32_t old_capacity;
+    rg_status_t status;
 
-    if (world == NULL || chunk == NULL || chunk->updated_mask == NULL) {
-        return;
+    old_capacity = world->scratch_chunk_task_capacity;
+    status = rg_scratch_reserve(
+        world,
+        (void**)&world->scratch_chunk_tasks,
+        &world->scratch_chunk_task_capacity,
+        min_capacity,
+        sizeof(*world->scratch_chunk_tasks),
+        _Alignof(uint32_t));
+    if (status == RG_STATUS_OK && world->scratch_chunk_task_capacity != old_capacity) {
+        memset(
+            world->scratch_chunk_tasks,
+            0xFF,
+            (size_t)world->scratch_chunk_task_capacity * sizeof(*world->scratch_chunk_tasks));
     }
-
-    mask_bytes = ((size_t)world->cells_per_chunk + 7u) / 8u;
-    memset(chunk->updated_mask, 0, mask_bytes);
+    return status;
 }
 
-static void rg_prepare_step_masks(rg_world_t* world)
+/* Unlike the other scratch arrays, outputs carry their intent buffers over. */
+static rg_status_t rg_scratch_reserve_outputs(rg_world_t* world, uint32_t min_capacity)
 {
-    uint32_t i;
+    uint32_t new_capacity;
+    rg_task_output_t* new_outputs;
 
-    if (world == NULL) {
-        return;
+    if (world->scratch_output_capacity >= min_capacity) {
+        return RG_STATUS_OK;
     }
 
-    for (i = 0u; i < world->chunk_count; ++i) {
-        rg_mask_clear_all(world, world->chunks[i].chunk);
+    new_capacity = (world->scratch_output_capacity == 0u) ? RG_DEFAULT_INITIAL_CHUNKS : world->scratch_output_capacity;
+    while (new_capacity < min_capacity) {
+        if (new_capacity > UINT32_MAX / 2u) {
+            return RG_STATUS_CAPACITY_REACHED;
+        }
+        new_capacity *= 2u;
     }
-}
 
-static const rg_material_record_t* rg_material_get(
-    const rg_world_t* world,
-    rg_material_id_t material_id)
-{
-    if (world == NULL || material_id == 0u || material_id > world->material_count) {
-        return NULL;
-    }
-    if (world->materials[material_id].used == 0u) {
-        return NULL;
+    new_outputs = (rg_task_output_t*)rg_alloc_bytes(
+        &world->allocator,
+        (size_t)new_capacity * sizeof(*new_outputs),
+        _Alignof(rg_task_output_t));
+    if (new_outputs == NULL) {
+        return RG_STATUS_ALLOCATION_FAILED;
     }
-    return &world->materials[material_id];
-}
 
-static uint8_t rg_material_uses_overflow(
-    const rg_world_t* world,
-    const rg_material_record_t* material)
-{
-    if (world == NULL || material == NULL) {
-        return 0u;
+    memset(new_outputs, 0, (size_t)new_capacity * sizeof(*new_outputs));
+    if (world->scratch_output_capacity > 0u) {
+        memcpy(new_outputs, world->scratch_outputs, (size_t)world->scratch_output_capacity * sizeof(*new_outputs));
     }
-    return (uint8_t)(material->instance_size > world->inline_payload_bytes);
-}
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_outputs,
+        (size_t)world->scratch_output_capacity * sizeof(*new_outputs),
+        _Alignof(rg_task_output_t));
 
-static void* rg_chunk_payload_ptr(rg_world_t* world, rg_chunk_t* chunk, uint32_t cell_index)
-{
-    if (world == NULL || chunk == NULL || chunk->inline_payload == NULL || world->inline_payload_bytes == 0u) {
-        return NULL;
+    world->scratch_outputs = new_outputs;
+    world->scratch_output_capacity = new_capacity;
+    if (world->scratch_reserving == 0u) {
+        world->step_scratch_allocs += 1u;
     }
-    return chunk->inline_payload + ((size_t)cell_index * (size_t)world->inline_payload_bytes);
+    return RG_STATUS_OK;
 }
 
-static const void* rg_chunk_payload_ptr_const(
-    const rg_world_t* world,
-    const rg_chunk_t* chunk,
-    uint32_t cell_index)
+/* Cells on the rim of a width x height rectangle. */
+static uint32_t rg_rect_perimeter_cells(int32_t width, int32_t height)
 {
-    if (world == NULL || chunk == NULL || chunk->inline_payload == NULL || world->inline_payload_bytes == 0u) {
-        return NULL;
+    if (width <= 2 || height <= 2) {
+        return (uint32_t)width * (uint32_t)height;
     }
-    return chunk->inline_payload + ((size_t)cell_index * (size_t)world->inline_payload_bytes);
+    return 2u * (uint32_t)width + 2u * (uint32_t)height - 4u;
 }
 
-static void* rg_chunk_instance_ptr(
+/*
+ * Hands each output of a phase a fixed slice of the world-owned intent arena.
+ * A task visits each cell of its rectangle once and a cell emits at most one
+ * intent, and only rim cells can move out of the rectangle, so slots_per_output
+ * rim cells always suffice and tasks never allocate.
+ */
+static rg_status_t rg_scratch_bind_intents(
     rg_world_t* world,
-    rg_chunk_t* chunk,
-    uint32_t cell_index,
-    const rg_material_record_t* material)
+    rg_task_output_t* outputs,
+    uint32_t output_count,
+    uint32_t slots_per_output)
 {
-    if (world == NULL || chunk == NULL || material == NULL || material->instance_size == 0u) {
-        return NULL;
-    }
+    uint32_t i;
+    rg_status_t status;
 
-    if (rg_material_uses_overflow(world, material) != 0u) {
-        if (chunk->overflow_payloads == NULL) {
-            return NULL;
-        }
-        return chunk->overflow_payloads[cell_index];
+    if (output_count > 0u && slots_per_output > UINT32_MAX / output_count) {
+        return RG_STATUS_CAPACITY_REACHED;
+    }
+    status = rg_scratch_reserve(
+        world,
+        (void**)&world->scratch_intents,
+        &world->scratch_intent_capacity,
+        output_count * slots_per_output,
+        sizeof(*world->scratch_intents),
+        _Alignof(rg_cross_intent_t));
+    if (status != RG_STATUS_OK) {
+        return status;
     }
 
-    return rg_chunk_payload_ptr(world, chunk, cell_index);
+    for (i = 0u; i < output_count; ++i) {
+        outputs[i].intents = world->scratch_intents + (size_t)i * slots_per_output;
+        outputs[i].intent_capacity = slots_per_output;
+    }
+    return RG_STATUS_OK;
 }
 
-static const void* rg_chunk_instance_ptr_const(
-    const rg_world_t* world,
-    const rg_chunk_t* chunk,
-    uint32_t cell_index,
-    const rg_material_record_t* material)
+static void rg_scratch_release(rg_world_t* world)
 {
-    if (world == NULL || chunk == NULL || material == NULL || material->instance_size == 0u) {
-        return NULL;
-    }
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_intents,
+        (size_t)world->scratch_intent_capacity * sizeof(*world->scratch_intents),
+        _Alignof(rg_cross_intent_t));
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_outputs,
+        (size_t)world->scratch_output_capacity * sizeof(*world->scratch_outputs),
+        _Alignof(rg_task_output_t));
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_chunk_indices,
+        (size_t)world->scratch_chunk_index_capacity * sizeof(*world->scratch_chunk_indices),
+        _Alignof(uint32_t));
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_merged,
+        (size_t)world->scratch_merged_capacity * sizeof(*world->scratch_merged),
+        _Alignof(rg_cross_intent_t));
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_intent_sort,
+        (size_t)world->scratch_intent_sort_capacity * sizeof(*world->scratch_intent_sort),
+        _Alignof(rg_intent_sort_entry_t));
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_intent_buckets,
+        (size_t)world->scratch_intent_bucket_capacity * sizeof(*world->scratch_intent_buckets),
+        _Alignof(rg_intent_bucket_t));
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_merge_graph,
+        (size_t)world->scratch_merge_graph_capacity * sizeof(*world->scratch_merge_graph),
+        _Alignof(uint32_t));
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_chunk_tasks,
+        (size_t)world->scratch_chunk_task_capacity * sizeof(*world->scratch_chunk_tasks),
+        _Alignof(uint32_t));
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_budget_keys,
+        (size_t)world->scratch_budget_key_capacity * sizeof(*world->scratch_budget_keys),
+        _Alignof(rg_budget_key_t));
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_cost_keys,
+        (size_t)world->scratch_cost_key_capacity * sizeof(*world->scratch_cost_keys),
+        _Alignof(uint64_t));
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_block_offsets,
+        (size_t)world->scratch_block_offset_capacity * sizeof(*world->scratch_block_offsets),
+        _Alignof(uint32_t));
+    rg_free_bytes(
+        &world->allocator,
+        world->scratch_tile_chunks,
+        (size_t)world->scratch_tile_chunk_capacity * sizeof(*world->scratch_tile_chunks),
+        _Alignof(uint32_t));
+}
 
-    if (rg_material_uses_overflow(world, material) != 0u) {
-        if (chunk->overflow_payloads == NULL) {
-            return NULL;
-        }
-        return chunk->overflow_payloads[cell_index];
+/* Capacity is reserved at chunk load, so insertion never allocates. */
+static void rg_active_list_insert(rg_world_t* world, rg_chunk_t* chunk)
+{
+    rg_chunk_list_t* list;
+
+    list = &world->active_lists[chunk->color];
+    if (chunk->active_slot != UINT32_MAX || list->count >= list->capacity) {
+        return;
     }
 
-    return rg_chunk_payload_ptr_const(world, chunk, cell_index);
+    if (list->count > 0u && list->indices[list->count - 1u] > chunk->entry_index) {
+        list->unsorted = 1u;
+    }
+    chunk->active_slot = list->count;
+    list->indices[list->count] = chunk->entry_index;
+    list->count += 1u;
+    world->active_chunk_count += 1u;
 }
 
-static void rg_release_cell_instance(
-    rg_world_t* world,
-    rg_chunk_t* chunk,
-    uint32_t cell_index,
-    const rg_material_record_t* material)
+static void rg_active_list_remove(rg_world_t* world, rg_chunk_t* chunk)
 {
-    void* payload;
+    rg_chunk_list_t* list;
+    uint32_t last_index;
 
-    if (world == NULL || chunk == NULL || material == NULL || material->instance_size == 0u) {
+    if (chunk->active_slot == UINT32_MAX) {
         return;
     }
 
-    payload = rg_chunk_instance_ptr(world, chunk, cell_index, material);
-    if (payload != NULL && material->instance_dtor != NULL) {
-        material->instance_dtor(payload, material->user_data);
+    list = &world->active_lists[chunk->color];
+    last_index = list->indices[list->count - 1u];
+    if (chunk->active_slot + 1u < list->count) {
+        list->unsorted = 1u;
     }
+    list->indices[chunk->active_slot] = last_index;
+    world->chunks[last_index].chunk->active_slot = chunk->active_slot;
+    list->count -= 1u;
+    chunk->active_slot = UINT32_MAX;
+    world->active_chunk_count -= 1u;
+}
 
-    if (rg_material_uses_overflow(world, material) != 0u) {
-        if (chunk->overflow_payloads != NULL && chunk->overflow_payloads[cell_index] != NULL) {
-            rg_free_bytes(
-                &world->allocator,
-                chunk->overflow_payloads[cell_index],
-                material->instance_size,
-                material->instance_align);
-            chunk->overflow_payloads[cell_index] = NULL;
-            world->payload_overflow_frees += 1u;
-        }
+/*
+ * Adaptive sleep bookkeeping for an asleep -> awake transition. Waking within one
+ * threshold of falling asleep means the chunk settled too early (it oscillates or
+ * is still being fed), so it gets a longer grace period next time.
+ */
+static void rg_chunk_adapt_wake(const rg_world_t* world, rg_chunk_t* chunk)
+{
+    if (world->sleep_adaptive == 0u || chunk->sleep_tick == 0u) {
         return;
     }
 
-    if (payload != NULL) {
-        memset(payload, 0, (size_t)world->inline_payload_bytes);
+    chunk->woke_early = (uint8_t)(world->step_tick - chunk->sleep_tick <= (uint64_t)chunk->sleep_ticks);
+    if (chunk->woke_early != 0u) {
+        chunk->sleep_ticks = (chunk->sleep_ticks > world->sleep_ticks_max / 2u) ?
+            world->sleep_ticks_max :
+            chunk->sleep_ticks * 2u;
     }
 }
 
-static rg_status_t rg_write_cell_instance(
-    rg_world_t* world,
-    rg_chunk_t* chunk,
-    uint32_t cell_index,
-    const rg_material_record_t* material,
-    const void* instance_data)
+/*
+ * Adaptive sleep bookkeeping for an awake -> asleep transition. A chunk that was
+ * not woken early last time settles reliably and may sleep sooner. Chunks that
+ * sleep because they emptied out carry no signal and are not tracked.
+ */
+static void rg_chunk_adapt_sleep(const rg_world_t* world, rg_chunk_t* chunk)
 {
-    void* payload;
-
-    if (world == NULL || chunk == NULL || material == NULL) {
-        return RG_STATUS_INVALID_ARGUMENT;
+    if (world->sleep_adaptive == 0u) {
+        return;
     }
 
-    if (material->instance_size == 0u) {
-        return RG_STATUS_OK;
+    if (chunk->live_cells == 0u) {
+        chunk->sleep_tick = 0u;
+        return;
     }
 
-    if (rg_material_uses_overflow(world, material) != 0u) {
-        if (chunk->overflow_payloads == NULL) {
-            return RG_STATUS_ALLOCATION_FAILED;
-        }
+    if (chunk->woke_early == 0u) {
+        chunk->sleep_ticks = (chunk->sleep_ticks / 2u < world->sleep_ticks_min) ?
+            world->sleep_ticks_min :
+            chunk->sleep_ticks / 2u;
+    }
+    chunk->woke_early = 0u;
+    chunk->sleep_tick = world->step_tick;
+}
 
-        payload = rg_alloc_bytes(&world->allocator, material->instance_size, material->instance_align);
-        if (payload == NULL) {
-            return RG_STATUS_ALLOCATION_FAILED;
-        }
-        memset(payload, 0, material->instance_size);
+/* Transition notes of rg_chunk_sync_active; cross-phase graph tasks count in their outputs. */
+static void rg_chunk_note_wake(rg_world_t* world, rg_chunk_t* chunk)
+{
+    world->chunk_wakes_last_step += 1u;
+    world->chunk_wakes_total += 1u;
+    rg_chunk_adapt_wake(world, chunk);
+}
 
-        if (instance_data != NULL) {
-            memmove(payload, instance_data, material->instance_size);
-        } else if (material->instance_ctor != NULL) {
-            material->instance_ctor(payload, material->user_data);
-        }
+static void rg_chunk_note_sleep(rg_world_t* world, rg_chunk_t* chunk)
+{
+    world->chunk_sleeps_last_step += 1u;
+    world->chunk_sleeps_total += 1u;
+    rg_chunk_adapt_sleep(world, chunk);
+}
 
-        chunk->overflow_payloads[cell_index] = payload;
-        world->payload_overflow_allocs += 1u;
+static void rg_chunk_sync_active(rg_world_t* world, rg_chunk_t* chunk)
+{
+    if (chunk == NULL) {
+        return;
+    }
 
-        if (world->inline_payload_bytes > 0u && chunk->inline_payload != NULL) {
-            void* inline_payload;
-            inline_payload = rg_chunk_payload_ptr(world, chunk, cell_index);
-            if (inline_payload != NULL) {
-                memset(inline_payload, 0, (size_t)world->inline_payload_bytes);
-            }
+    if (chunk->awake != 0u) {
+        if (chunk->active_slot == UINT32_MAX) {
+            rg_chunk_note_wake(world, chunk);
         }
-        return RG_STATUS_OK;
+        rg_active_list_insert(world, chunk);
+    } else {
+        if (chunk->active_slot != UINT32_MAX) {
+            rg_chunk_note_sleep(world, chunk);
+        }
+        rg_active_list_remove(world, chunk);
     }
+}
 
-    payload = rg_chunk_payload_ptr(world, chunk, cell_index);
-    if (payload == NULL) {
-        return RG_STATUS_INVALID_ARGUMENT;
+static void rg_chunk_set_awake(rg_world_t* world, rg_chunk_t* chunk, uint8_t awake)
+{
+    if (world == NULL || chunk == NULL) {
+        return;
     }
 
-    memset(payload, 0, (size_t)world->inline_payload_bytes);
-    if (instance_data != NULL) {
-        memmove(payload, instance_data, material->instance_size);
-    } else if (material->instance_ctor != NULL) {
-        material->instance_ctor(payload, material->user_data);
+    chunk->awake = (uint8_t)(awake != 0u);
+    if (world->active_sync_deferred == 0u) {
+        rg_chunk_sync_active(world, chunk);
     }
+}
 
-    if (chunk->overflow_payloads != NULL) {
-        chunk->overflow_payloads[cell_index] = NULL;
+/*
+ * Chunk table insertion/removal at first_index moved every later entry by delta;
+ * refresh the cached entry indices and the active lists to match.
+ */
+static void rg_chunk_table_shifted(rg_world_t* world, uint32_t first_index, int32_t delta)
+{
+    uint32_t threshold;
+    uint32_t color;
+    uint32_t i;
+
+    for (i = first_index; i < world->chunk_count; ++i) {
+        world->chunks[i].chunk->entry_index = i;
     }
 
-    return RG_STATUS_OK;
+    threshold = (delta > 0) ? first_index : first_index + 1u;
+    for (color = 0u; color < 4u; ++color) {
+        rg_chunk_list_t* list;
+
+        list = &world->active_lists[color];
+        for (i = 0u; i < list->count; ++i) {
+            if (list->indices[i] >= threshold) {
+                list->indices[i] = (uint32_t)((int32_t)list->indices[i] + delta);
+            }
+        }
+    }
 }
 
-static void rg_update_live_counts(
-    rg_world_t* world,
-    rg_chunk_t* chunk,
-    rg_material_id_t old_material,
-    rg_material_id_t new_material)
+static const int8_t k_rg_dir_dx[RG_DIR_COUNT] = {-1, 0, 1, -1, 1, -1, 0, 1};
+static const int8_t k_rg_dir_dy[RG_DIR_COUNT] = {-1, -1, -1, 0, 0, 1, 1, 1};
+
+static uint32_t rg_dir_from_offset(int32_t dx, int32_t dy)
 {
-    if (world == NULL || chunk == NULL) {
-        return;
-    }
+    static const uint8_t k_dirs[3][3] = {
+        {RG_DIR_NW, RG_DIR_N, RG_DIR_NE},
+        {RG_DIR_W, RG_DIR_COUNT, RG_DIR_E},
+        {RG_DIR_SW, RG_DIR_S, RG_DIR_SE}
+    };
 
-    if (old_material == 0u && new_material != 0u) {
-        world->live_cells += 1u;
-        chunk->live_cells += 1u;
-        chunk->idle_steps = 0u;
-        rg_chunk_set_awake(world, chunk, 1u);
-        return;
-    }
+    return k_dirs[dy + 1][dx + 1];
+}
 
-    if (old_material != 0u && new_material == 0u) {
-        if (world->live_cells > 0u) {
-            world->live_cells -= 1u;
+/*
+ * Wakes the neighbors facing dirty borders of a chunk. A changed border cell may
+ * unblock (or newly block) cells across the edge, so a sleeping neighbor with
+ * material must re-run. Only the directions that actually changed are woken.
+ */
+static void rg_chunk_flush_border(rg_world_t* world, rg_chunk_t* chunk)
+{
+    uint32_t dir;
+    uint8_t dirty;
+
+    dirty = chunk->border_dirty;
+    chunk->border_dirty = 0u;
+    for (dir = 0u; dirty != 0u; ++dir, dirty = (uint8_t)(dirty >> 1u)) {
+        rg_chunk_t* neighbor;
+
+        if ((dirty & 1u) == 0u) {
+            continue;
         }
-        if (chunk->live_cells > 0u) {
-            chunk->live_cells -= 1u;
+
+        neighbor = chunk->neighbors[dir];
+        if (neighbor == NULL || neighbor->live_cells == 0u) {
+            continue;
         }
 
-        chunk->idle_steps = 0u;
-        if (chunk->live_cells == 0u) {
-            rg_chunk_set_awake(world, chunk, 0u);
-        } else {
-            rg_chunk_set_awake(world, chunk, 1u);
+        neighbor->idle_steps = 0u;
+        if (neighbor->awake == 0u) {
+            rg_chunk_set_awake(world, neighbor, 1u);
         }
+    }
+}
+
+static void rg_chunk_mark_border(rg_world_t* world, rg_chunk_t* chunk, uint32_t cell_index)
+{
+    uint8_t bits;
+
+    bits = world->cell_border_bits[cell_index];
+    if (bits == 0u) {
         return;
     }
 
-    if (old_material != 0u && new_material != 0u) {
-        chunk->idle_steps = 0u;
-        rg_chunk_set_awake(world, chunk, 1u);
+    chunk->border_dirty = (uint8_t)(chunk->border_dirty | bits);
+    if (world->active_sync_deferred == 0u) {
+        rg_chunk_flush_border(world, chunk);
     }
 }
 
-static rg_status_t rg_locate_cell(
-    const rg_world_t* world,
-    rg_cell_coord_t cell,
-    uint32_t* out_chunk_index,
-    uint32_t* out_cell_index)
+static void rg_chunk_link_neighbors(rg_world_t* world, rg_chunk_entry_t* entry)
 {
-    int32_t local_x;
-    int32_t local_y;
-    int32_t chunk_x;
-    int32_t chunk_y;
-    uint32_t chunk_index;
+    uint32_t dir;
 
-    if (world == NULL || out_chunk_index == NULL || out_cell_index == NULL) {
-        return RG_STATUS_INVALID_ARGUMENT;
+    for (dir = 0u; dir < RG_DIR_COUNT; ++dir) {
+        uint32_t neighbor_index;
+        rg_chunk_t* neighbor;
+
+        neighbor_index = rg_chunk_find_index(world, entry->chunk_x + k_rg_dir_dx[dir], entry->chunk_y + k_rg_dir_dy[dir]);
+        neighbor = (neighbor_index == UINT32_MAX) ? NULL : world->chunks[neighbor_index].chunk;
+        entry->chunk->neighbors[dir] = neighbor;
+        if (neighbor != NULL) {
+            neighbor->neighbors[RG_DIR_COUNT - 1u - dir] = entry->chunk;
+        }
     }
+}
 
-    rg_split_coord(cell.x, world->chunk_width, &chunk_x, &local_x);
-    rg_split_coord(cell.y, world->chunk_height, &chunk_y, &local_y);
+static void rg_chunk_unlink_neighbors(rg_chunk_t* chunk)
+{
+    uint32_t dir;
 
-    chunk_index = rg_chunk_find_index(world, chunk_x, chunk_y);
-    if (chunk_index == UINT32_MAX) {
-        return RG_STATUS_NOT_FOUND;
+    for (dir = 0u; dir < RG_DIR_COUNT; ++dir) {
+        if (chunk->neighbors[dir] != NULL) {
+            chunk->neighbors[dir]->neighbors[RG_DIR_COUNT - 1u - dir] = NULL;
+            chunk->neighbors[dir] = NULL;
+        }
     }
-
-    *out_chunk_index = chunk_index;
-    *out_cell_index = ((uint32_t)local_y * (uint32_t)world->chunk_width) + (uint32_t)local_x;
-    return RG_STATUS_OK;
 }
 
-static rg_status_t rg_chunk_create(rg_world_t* world, rg_chunk_t** out_chunk)
+static void rg_chunk_update_lod(rg_world_t* world, const rg_chunk_entry_t* entry)
 {
     rg_chunk_t* chunk;
-    size_t material_bytes;
-    size_t payload_bytes;
-    size_t overflow_bytes;
-    size_t mask_bytes;
+    uint32_t distance;
+    uint32_t band;
+    uint32_t i;
 
-    if (world == NULL || out_chunk == NULL) {
-        return RG_STATUS_INVALID_ARGUMENT;
+    chunk = entry->chunk;
+    distance = UINT32_MAX;
+    for (i = 0u; i < world->focus_count; ++i) {
+        uint32_t dx;
+        uint32_t dy;
+
+        dx = (uint32_t)rg_abs_i32(entry->chunk_x - world->focus_chunks[i].x);
+        dy = (uint32_t)rg_abs_i32(entry->chunk_y - world->focus_chunks[i].y);
+        if (dx < dy) {
+            dx = dy;
+        }
+        if (dx < distance) {
+            distance = dx;
+        }
     }
 
-    *out_chunk = NULL;
+    chunk->focus_distance = distance;
+    if (world->focus_count == 0u || distance <= world->lod_radius) {
+        chunk->lod_shift = 0u;
+        return;
+    }
 
-    chunk = (rg_chunk_t*)rg_alloc_bytes(&world->allocator, sizeof(*chunk), _Alignof(rg_chunk_t));
-    if (chunk == NULL) {
-        return RG_STATUS_ALLOCATION_FAILED;
+    band = 1u + ((distance - world->lod_radius - 1u) / world->lod_band);
+    chunk->lod_shift = (uint8_t)((band < world->lod_max_shift) ? band : world->lod_max_shift);
+}
+
+/*
+ * Chunks with the same period are spread over its ticks by a hash of their
+ * coordinates, so a distant band does not step all at once.
+ */
+static uint8_t rg_chunk_due(const rg_chunk_entry_t* entry, uint64_t tick)
+{
+    uint64_t phase;
+    uint64_t period_mask;
+
+    if (entry->chunk->lod_shift == 0u) {
+        return 1u;
     }
-    memset(chunk, 0, sizeof(*chunk));
 
-    material_bytes = (size_t)world->cells_per_chunk * sizeof(*chunk->material_ids);
-    chunk->material_ids = (uint16_t*)rg_alloc_bytes(
-        &world->allocator,
-        material_bytes,
-        _Alignof(uint16_t));
-    if (chunk->material_ids == NULL) {
-        rg_free_bytes(&world->allocator, chunk, sizeof(*chunk), _Alignof(rg_chunk_t));
-        return RG_STATUS_ALLOCATION_FAILED;
+    phase = rg_mix_u64(((uint64_t)(uint32_t)entry->chunk_x << 32u) | (uint64_t)(uint32_t)entry->chunk_y);
+    period_mask = (1ull << entry->chunk->lod_shift) - 1u;
+    return (uint8_t)(((tick + phase) & period_mask) == 0u);
+}
+
+static int rg_u32_compare(const void* lhs_void, const void* rhs_void)
+{
+    uint32_t lhs;
+    uint32_t rhs;
+
+    lhs = *(const uint32_t*)lhs_void;
+    rhs = *(const uint32_t*)rhs_void;
+    if (lhs < rhs) {
+        return -1;
     }
-    memset(chunk->material_ids, 0, material_bytes);
+    return (lhs > rhs) ? 1 : 0;
+}
 
-    payload_bytes = (size_t)world->cells_per_chunk * (size_t)world->inline_payload_bytes;
-    if (payload_bytes > 0u) {
-        chunk->inline_payload = (uint8_t*)rg_alloc_bytes(&world->allocator, payload_bytes, 1u);
-        if (chunk->inline_payload == NULL) {
-            rg_free_bytes(&world->allocator, chunk->material_ids, material_bytes, _Alignof(uint16_t));
-            rg_free_bytes(&world->allocator, chunk, sizeof(*chunk), _Alignof(rg_chunk_t));
-            return RG_STATUS_ALLOCATION_FAILED;
-        }
-        memset(chunk->inline_payload, 0, payload_bytes);
+static int rg_u64_compare(const void* lhs_void, const void* rhs_void)
+{
+    uint64_t lhs;
+    uint64_t rhs;
+
+    lhs = *(const uint64_t*)lhs_void;
+    rhs = *(const uint64_t*)rhs_void;
+    if (lhs < rhs) {
+        return -1;
     }
+    return (lhs > rhs) ? 1 : 0;
+}
 
-    overflow_bytes = (size_t)world->cells_per_chunk * sizeof(*chunk->overflow_payloads);
-    chunk->overflow_payloads = (void**)rg_alloc_bytes(
-        &world->allocator,
-        overflow_bytes,
-        _Alignof(void*));
-    if (chunk->overflow_payloads == NULL) {
-        rg_free_bytes(&world->allocator, chunk->inline_payload, payload_bytes, 1u);
-        rg_free_bytes(&world->allocator, chunk->material_ids, material_bytes, _Alignof(uint16_t));
-        rg_free_bytes(&world->allocator, chunk, sizeof(*chunk), _Alignof(rg_chunk_t));
-        return RG_STATUS_ALLOCATION_FAILED;
-    }
-    memset(chunk->overflow_payloads, 0, overflow_bytes);
+/* Restores chunk table order after wakes and sleeps reordered the list. */
+static void rg_active_list_sort(rg_world_t* world, rg_chunk_list_t* list)
+{
+    uint32_t i;
 
-    mask_bytes = ((size_t)world->cells_per_chunk + 7u) / 8u;
-    chunk->updated_mask = (uint8_t*)rg_alloc_bytes(&world->allocator, mask_bytes, 1u);
-    if (chunk->updated_mask == NULL) {
-        rg_free_bytes(&world->allocator, chunk->overflow_payloads, overflow_bytes, _Alignof(void*));
-        rg_free_bytes(&world->allocator, chunk->inline_payload, payload_bytes, 1u);
-        rg_free_bytes(&world->allocator, chunk->material_ids, material_bytes, _Alignof(uint16_t));
-        rg_free_bytes(&world->allocator, chunk, sizeof(*chunk), _Alignof(rg_chunk_t));
-        return RG_STATUS_ALLOCATION_FAILED;
+    if (list->unsorted == 0u) {
+        return;
     }
-    memset(chunk->updated_mask, 0, mask_bytes);
-    chunk->live_cells = 0u;
-    chunk->idle_steps = 0u;
-    chunk->awake = 0u;
 
-    *out_chunk = chunk;
-    return RG_STATUS_OK;
+    qsort(list->indices, (size_t)list->count, sizeof(*list->indices), rg_u32_compare);
+    for (i = 0u; i < list->count; ++i) {
+        world->chunks[list->indices[i]].chunk->active_slot = i;
+    }
+    list->unsorted = 0u;
 }
 
-static void rg_chunk_destroy(rg_world_t* world, rg_chunk_t* chunk)
+/*
+ * Copies the awake chunks of colors [first_color, first_color + color_count) into
+ * out_indices in chunk table order, which keeps iteration deterministic no matter
+ * in which order chunks woke up. The per-color lists are kept sorted between
+ * wakes and sleeps, so a steady world copies (or merges) them without sorting.
+ */
+static uint32_t rg_snapshot_active_chunks(
+    rg_world_t* world,
+    uint32_t first_color,
+    uint32_t color_count,
+    uint32_t* out_indices)
 {
-    size_t material_bytes;
-    size_t payload_bytes;
-    size_t overflow_bytes;
-    size_t mask_bytes;
-    uint32_t i;
+    uint32_t cursors[4];
+    uint32_t count;
+    uint32_t color;
 
-    if (world == NULL || chunk == NULL) {
-        return;
+    count = 0u;
+    for (color = first_color; color < first_color + color_count; ++color) {
+        rg_active_list_sort(world, &world->active_lists[color]);
+        cursors[color] = 0u;
+        count += world->active_lists[color].count;
     }
 
-    for (i = 0u; i < world->cells_per_chunk; ++i) {
-        rg_material_id_t material_id;
-        const rg_material_record_t* material;
-
-        material_id = chunk->material_ids[i];
-        if (material_id == 0u) {
-            continue;
-        }
-
-        material = rg_material_get(world, material_id);
-        if (material != NULL) {
-            rg_release_cell_instance(world, chunk, i, material);
+    if (color_count == 1u) {
+        if (count > 0u) {
+            memcpy(out_indices, world->active_lists[first_color].indices, (size_t)count * sizeof(*out_indices));
         }
+        return count;
     }
 
-    material_bytes = (size_t)world->cells_per_chunk * sizeof(*chunk->material_ids);
-    payload_bytes = (size_t)world->cells_per_chunk * (size_t)world->inline_payload_bytes;
-    overflow_bytes = (size_t)world->cells_per_chunk * sizeof(*chunk->overflow_payloads);
-    mask_bytes = ((size_t)world->cells_per_chunk + 7u) / 8u;
+    for (count = 0u;; ++count) {
+        uint32_t best_color;
+        uint32_t best_index;
 
-    rg_free_bytes(&world->allocator, chunk->updated_mask, mask_bytes, 1u);
-    rg_free_bytes(&world->allocator, chunk->overflow_payloads, overflow_bytes, _Alignof(void*));
-    rg_free_bytes(&world->allocator, chunk->inline_payload, payload_bytes, 1u);
-    rg_free_bytes(&world->allocator, chunk->material_ids, material_bytes, _Alignof(uint16_t));
-    rg_free_bytes(&world->allocator, chunk, sizeof(*chunk), _Alignof(rg_chunk_t));
+        best_color = UINT32_MAX;
+        best_index = UINT32_MAX;
+        for (color = first_color; color < first_color + color_count; ++color) {
+            const rg_chunk_list_t* list;
+
+            list = &world->active_lists[color];
+            if (cursors[color] < list->count && list->indices[cursors[color]] < best_index) {
+                best_color = color;
+                best_index = list->indices[cursors[color]];
+            }
+        }
+        if (best_color == UINT32_MAX) {
+            break;
+        }
+        out_indices[count] = best_index;
+        cursors[best_color] += 1u;
+    }
+    return count;
 }
 
-static uint32_t rg_chunk_insert_index(const rg_world_t* world, int32_t chunk_x, int32_t chunk_y)
+static void rg_set_chunk_awake_for_mode(
+    rg_world_t* world,
+    rg_chunk_t* chunk,
+    uint8_t awake,
+    rg_task_output_t* task_output)
 {
-    uint32_t i;
-
-    if (world == NULL) {
-        return 0u;
+    if (chunk == NULL) {
+        return;
     }
 
-    for (i = 0u; i < world->chunk_count; ++i) {
-        if (rg_chunk_coord_less(chunk_x, chunk_y, world->chunks[i].chunk_x, world->chunks[i].chunk_y) != 0u) {
-            return i;
+    if (task_output != NULL) {
+        if (task_output->tiled == 0u) {
+            chunk->awake = (uint8_t)(awake != 0u);
         }
+    } else {
+        rg_chunk_set_awake(world, chunk, awake);
     }
-    return world->chunk_count;
 }
 
-static uint32_t rg_step_random(
-    const rg_world_t* world,
-    uint64_t tick,
-    int32_t chunk_x,
-    int32_t chunk_y,
-    int32_t local_x,
-    int32_t local_y,
-    uint32_t salt)
+/* A cell of chunk changed: restart its idle count and keep it awake while it has material. */
+static void rg_chunk_note_activity(rg_world_t* world, rg_chunk_t* chunk, rg_task_output_t* task_output)
 {
-    uint64_t seed;
-    uint64_t key;
-
-    if (world == NULL) {
-        return 0u;
+    if (task_output != NULL && task_output->tiled != 0u) {
+        return;
     }
 
-    seed = world->deterministic_seed;
-    if (world->deterministic_mode == 0u) {
-        seed ^= (uint64_t)(uintptr_t)world;
+    chunk->idle_steps = 0u;
+    rg_set_chunk_awake_for_mode(world, chunk, (uint8_t)(chunk->live_cells > 0u), task_output);
+}
+
+static void rg_chunk_mark_border_for_mode(
+    rg_world_t* world,
+    rg_chunk_t* chunk,
+    uint32_t cell_index,
+    rg_task_output_t* task_output)
+{
+    if (task_output != NULL && task_output->tiled != 0u) {
+        task_output->border_dirty = (uint8_t)(task_output->border_dirty | world->cell_border_bits[cell_index]);
+        return;
     }
+    rg_chunk_mark_border(world, chunk, cell_index);
+}
 
-    key = seed;
-    key ^= tick * 0x9e3779b97f4a7c15ull;
-    key ^= ((uint64_t)(uint32_t)chunk_x << 32u) ^ (uint64_t)(uint32_t)chunk_y;
-    key ^= ((uint64_t)(uint32_t)local_x << 32u) ^ (uint64_t)(uint32_t)local_y;
-    key ^= (uint64_t)salt * 0xd6e8feb86659fd93ull;
+static uint8_t rg_chunks_share_block(
+    const rg_world_t* world,
+    const rg_chunk_entry_t* lhs,
+    const rg_chunk_entry_t* rhs)
+{
+    int32_t lhs_block;
+    int32_t rhs_block;
 
-    return (uint32_t)rg_mix_u64(key);
+    rg_split_coord(lhs->chunk_x, world->checkerboard_block, &lhs_block, NULL);
+    rg_split_coord(rhs->chunk_x, world->checkerboard_block, &rhs_block, NULL);
+    if (lhs_block != rhs_block) {
+        return 0u;
+    }
+    rg_split_coord(lhs->chunk_y, world->checkerboard_block, &lhs_block, NULL);
+    rg_split_coord(rhs->chunk_y, world->checkerboard_block, &rhs_block, NULL);
+    return (uint8_t)(lhs_block == rhs_block);
 }
 
-static rg_status_t rg_resolve_target(
+/*
+ * Whether a move target is outside what the stepping task owns: a chunk of
+ * another block (with checkerboard_block 1, any other chunk), or for tile
+ * tasks any cell outside the tile. Such moves become intents.
+ */
+static uint8_t rg_target_is_remote(
     const rg_world_t* world,
+    const rg_task_output_t* task_output,
     const rg_chunk_entry_t* source_entry,
-    int32_t source_local_x,
-    int32_t source_local_y,
-    int32_t dx,
-    int32_t dy,
-    rg_chunk_entry_t** out_target_entry,
-    uint32_t* out_target_chunk_index,
-    uint32_t* out_target_index,
-    int32_t* out_target_local_x,
-    int32_t* out_target_local_y)
+    const rg_chunk_entry_t* target_entry,
+    int32_t target_local_x,
+    int32_t target_local_y)
 {
-    int32_t target_chunk_x;
-    int32_t target_chunk_y;
-    int32_t target_local_x;
-    int32_t target_local_y;
-    uint32_t chunk_index;
-
-    if (world == NULL ||
-        source_entry == NULL ||
-        out_target_entry == NULL ||
-        out_target_chunk_index == NULL ||
-        out_target_index == NULL ||
-        out_target_local_x == NULL ||
-        out_target_local_y == NULL) {
-        return RG_STATUS_INVALID_ARGUMENT;
+    if (target_entry != source_entry) {
+        return (uint8_t)(task_output == NULL || task_output->tiled != 0u || world->checkerboard_block == 1 ||
+                         rg_chunks_share_block(world, source_entry, target_entry) == 0u);
+    }
+    if (task_output == NULL || task_output->tiled == 0u) {
+        return 0u;
     }
+    return (uint8_t)(target_local_x < task_output->tile_x0 || target_local_x >= task_output->tile_x1 ||
+                     target_local_y < task_output->tile_y0 || target_local_y >= task_output->tile_y1);
+}
 
-    target_chunk_x = source_entry->chunk_x;
-    target_chunk_y = source_entry->chunk_y;
-    target_local_x = source_local_x + dx;
-    target_local_y = source_local_y + dy;
+/*
+ * A block task committed a move into another chunk of its block in place; the
+ * chunk's wake state and border marks are synced after the barrier.
+ */
+static void rg_task_output_note_block_move(
+    rg_task_output_t* task_output,
+    const rg_chunk_entry_t* source_entry,
+    const rg_chunk_entry_t* target_entry)
+{
+    uint32_t dir;
 
-    if (target_local_x < 0) {
-        target_chunk_x -= 1;
-        target_local_x += world->chunk_width;
-    } else if (target_local_x >= world->chunk_width) {
-        target_chunk_x += 1;
-        target_local_x -= world->chunk_width;
+    if (task_output == NULL || target_entry == source_entry) {
+        return;
     }
 
-    if (target_local_y < 0) {
-        target_chunk_y -= 1;
-        target_local_y += world->chunk_height;
-    } else if (target_local_y >= world->chunk_height) {
-        target_chunk_y += 1;
-        target_local_y -= world->chunk_height;
+    dir = rg_dir_from_offset(target_entry->chunk_x - source_entry->chunk_x, target_entry->chunk_y - source_entry->chunk_y);
+    if (dir < RG_DIR_COUNT) {
+        task_output->neighbor_touched = (uint8_t)(task_output->neighbor_touched | (1u << dir));
     }
+}
 
-    chunk_index = rg_chunk_find_index(world, target_chunk_x, target_chunk_y);
-    if (chunk_index == UINT32_MAX) {
-        return RG_STATUS_NOT_FOUND;
+/*
+ * updated_mask is only meaningful for the tick stored in mask_tick. A chunk whose
+ * stamp is stale has no updated cells this tick, and its bits are cleared lazily
+ * on the first write, so sleeping chunks never pay for a clearing pass.
+ */
+static uint8_t rg_mask_test(const rg_world_t* world, const rg_chunk_t* chunk, uint32_t cell_index)
+{
+    uint32_t byte_index;
+    uint32_t bit_index;
+
+    if (chunk == NULL || chunk->updated_mask == NULL || chunk->mask_tick != world->step_tick) {
+        return 0u;
     }
 
-    *out_target_entry = &((rg_world_t*)world)->chunks[chunk_index];
-    *out_target_chunk_index = chunk_index;
-    *out_target_local_x = target_local_x;
-    *out_target_local_y = target_local_y;
-    *out_target_index = ((uint32_t)target_local_y * (uint32_t)world->chunk_width) + (uint32_t)target_local_x;
-    return RG_STATUS_OK;
+    byte_index = cell_index >> 3u;
+    bit_index = cell_index & 7u;
+    return (uint8_t)((chunk->updated_mask[byte_index] >> bit_index) & 1u);
 }
 
-static uint8_t rg_can_displace(
-    const rg_material_record_t* source_material,
-    const rg_material_record_t* target_material,
-    int32_t dy,
-    uint8_t allow_lateral_displace)
+/* Clears a stale mask up front so tile tasks sharing the chunk never race on the lazy clear. */
+static void rg_mask_prepare(const rg_world_t* world, rg_chunk_t* chunk)
 {
-    if (source_material == NULL || target_material == NULL) {
-        return 0u;
+    if (chunk->updated_mask != NULL && chunk->mask_tick != world->step_tick) {
+        memset(chunk->updated_mask, 0, ((size_t)world->cells_per_chunk + 7u) / 8u);
+        chunk->mask_tick = world->step_tick;
     }
-    if ((target_material->flags & RG_MATERIAL_STATIC) != 0u) {
-        return 0u;
+}
+
+static void rg_mask_set(const rg_world_t* world, rg_chunk_t* chunk, uint32_t cell_index)
+{
+    uint32_t byte_index;
+    uint32_t bit_index;
+
+    if (chunk == NULL || chunk->updated_mask == NULL) {
+        return;
     }
 
-    if (dy > 0) {
-        return (uint8_t)(source_material->density > target_material->density);
+    if (chunk->mask_tick != world->step_tick) {
+        memset(chunk->updated_mask, 0, ((size_t)world->cells_per_chunk + 7u) / 8u);
+        chunk->mask_tick = world->step_tick;
     }
-    if (dy < 0) {
-        return (uint8_t)(source_material->density < target_material->density);
+
+    byte_index = cell_index >> 3u;
+    bit_index = cell_index & 7u;
+    chunk->updated_mask[byte_index] = (uint8_t)(chunk->updated_mask[byte_index] | (uint8_t)(1u << bit_index));
+}
+
+static const rg_material_record_t* rg_material_get(
+    const rg_world_t* world,
+    rg_material_id_t material_id)
+{
+    if (world == NULL || material_id == 0u || material_id > world->material_count) {
+        return NULL;
     }
-    if (allow_lateral_displace != 0u) {
-        return (uint8_t)(source_material->density != target_material->density);
+    if (world->materials[material_id].used == 0u) {
+        return NULL;
     }
-    return 0u;
+    return &world->materials[material_id];
 }
 
-static uint8_t rg_task_output_push_intent(rg_task_output_t* output, const rg_cross_intent_t* intent)
+static uint8_t rg_material_uses_overflow(
+    const rg_world_t* world,
+    const rg_material_record_t* material)
 {
-    rg_cross_intent_t* new_intents;
-    uint32_t new_capacity;
-
-    if (output == NULL || intent == NULL) {
+    if (world == NULL || material == NULL) {
         return 0u;
     }
+    return (uint8_t)(material->instance_size > world->inline_payload_bytes);
+}
 
-    if (output->intent_count >= output->intent_capacity) {
-        new_capacity = (output->intent_capacity == 0u) ? 16u : (output->intent_capacity * 2u);
-        new_intents = (rg_cross_intent_t*)realloc(output->intents, (size_t)new_capacity * sizeof(*new_intents));
-        if (new_intents == NULL) {
-            return 0u;
-        }
-        output->intents = new_intents;
-        output->intent_capacity = new_capacity;
+static void* rg_chunk_payload_ptr(rg_world_t* world, rg_chunk_t* chunk, uint32_t cell_index)
+{
+    if (world == NULL || chunk == NULL || chunk->inline_payload == NULL || world->inline_payload_bytes == 0u) {
+        return NULL;
     }
-
-    output->intents[output->intent_count] = *intent;
-    output->intent_count += 1u;
-    return 1u;
+    return chunk->inline_payload + ((size_t)cell_index * (size_t)world->inline_payload_bytes);
 }
 
-static void rg_task_output_release(rg_task_output_t* output)
+static const void* rg_chunk_payload_ptr_const(
+    const rg_world_t* world,
+    const rg_chunk_t* chunk,
+    uint32_t cell_index)
 {
-    if (output == NULL) {
-        return;
+    if (world == NULL || chunk == NULL || chunk->inline_payload == NULL || world->inline_payload_bytes == 0u) {
+        return NULL;
     }
-
-    free(output->intents);
-    memset(output, 0, sizeof(*output));
+    return chunk->inline_payload + ((size_t)cell_index * (size_t)world->inline_payload_bytes);
 }
 
-static int rg_intent_compare_by_target(const void* lhs_void, const void* rhs_void)
+static void* rg_chunk_instance_ptr(
+    rg_world_t* world,
+    rg_chunk_t* chunk,
+    uint32_t cell_index,
+    const rg_material_record_t* material)
 {
-    const rg_cross_intent_t* lhs;
-    const rg_cross_intent_t* rhs;
-
-    lhs = (const rg_cross_intent_t*)lhs_void;
-    rhs = (const rg_cross_intent_t*)rhs_void;
-
-    if (lhs->target_chunk_index < rhs->target_chunk_index) {
-        return -1;
+    if (world == NULL || chunk == NULL || material == NULL || material->instance_size == 0u) {
+        return NULL;
     }
-    if (lhs->target_chunk_index > rhs->target_chunk_index) {
-        return 1;
-    }
-    if (lhs->target_cell_index < rhs->target_cell_index) {
-        return -1;
-    }
-    if (lhs->target_cell_index > rhs->target_cell_index) {
-        return 1;
-    }
-    if (lhs->source_chunk_index < rhs->source_chunk_index) {
-        return -1;
-    }
-    if (lhs->source_chunk_index > rhs->source_chunk_index) {
-        return 1;
-    }
-    if (lhs->source_cell_index < rhs->source_cell_index) {
-        return -1;
-    }
-    if (lhs->source_cell_index > rhs->source_cell_index) {
-        return 1;
+
+    if (rg_material_uses_overflow(world, material) != 0u) {
+        if (chunk->overflow_payloads == NULL) {
+            return NULL;
+        }
+        return chunk->overflow_payloads[cell_index];
     }
-    return 0;
+
+    return rg_chunk_payload_ptr(world, chunk, cell_index);
 }
 
-static void rg_payload_swap(
-    rg_world_t* world,
-    rg_chunk_t* chunk_a,
-    uint32_t index_a,
-    rg_chunk_t* chunk_b,
-    uint32_t index_b)
+static const void* rg_chunk_instance_ptr_const(
+    const rg_world_t* world,
+    const rg_chunk_t* chunk,
+    uint32_t cell_index,
+    const rg_material_record_t* material)
 {
-    void* payload_a;
-    void* payload_b;
-    void* overflow_a;
-    void* overflow_b;
-
-    if (world == NULL || chunk_a == NULL || chunk_b == NULL) {
-        return;
+    if (world == NULL || chunk == NULL || material == NULL || material->instance_size == 0u) {
+        return NULL;
     }
 
-    if (world->inline_payload_bytes > 0u && world->swap_payload != NULL) {
-        payload_a = rg_chunk_payload_ptr(world, chunk_a, index_a);
-        payload_b = rg_chunk_payload_ptr(world, chunk_b, index_b);
-        if (payload_a != NULL && payload_b != NULL) {
-            memmove(world->swap_payload, payload_a, (size_t)world->inline_payload_bytes);
-            memmove(payload_a, payload_b, (size_t)world->inline_payload_bytes);
-            memmove(payload_b, world->swap_payload, (size_t)world->inline_payload_bytes);
+    if (rg_material_uses_overflow(world, material) != 0u) {
+        if (chunk->overflow_payloads == NULL) {
+            return NULL;
         }
+        return chunk->overflow_payloads[cell_index];
     }
 
-    if (chunk_a->overflow_payloads != NULL && chunk_b->overflow_payloads != NULL) {
-        overflow_a = chunk_a->overflow_payloads[index_a];
-        overflow_b = chunk_b->overflow_payloads[index_b];
-        chunk_a->overflow_payloads[index_a] = overflow_b;
-        chunk_b->overflow_payloads[index_b] = overflow_a;
-    }
+    return rg_chunk_payload_ptr_const(world, chunk, cell_index);
 }
 
-static void rg_payload_move(
+static void rg_release_cell_instance(
     rg_world_t* world,
-    rg_chunk_t* source_chunk,
-    uint32_t source_index,
-    rg_chunk_t* target_chunk,
-    uint32_t target_index,
-    const rg_material_record_t* material)
+    rg_chunk_t* chunk,
+    uint32_t cell_index,
+    const rg_material_record_t* material,
+    rg_task_output_t* task_output)
 {
-    void* source_payload;
-    void* target_payload;
+    void* payload;
 
-    if (world == NULL || material == NULL || material->instance_size == 0u) {
+    if (world == NULL || chunk == NULL || material == NULL || material->instance_size == 0u) {
         return;
     }
 
-    if (rg_material_uses_overflow(world, material) != 0u) {
-        if (source_chunk != NULL &&
-            target_chunk != NULL &&
-            source_chunk->overflow_payloads != NULL &&
-            target_chunk->overflow_payloads != NULL) {
-            target_chunk->overflow_payloads[target_index] = source_chunk->overflow_payloads[source_index];
-            source_chunk->overflow_payloads[source_index] = NULL;
+    payload = rg_chunk_instance_ptr(world, chunk, cell_index, material);
+    if (payload != NULL && material->instance_dtor != NULL) {
+        material->instance_dtor(payload, material->user_data);
+    }
 
-            if (world->inline_payload_bytes > 0u) {
-                source_payload = rg_chunk_payload_ptr(world, source_chunk, source_index);
-                target_payload = rg_chunk_payload_ptr(world, target_chunk, target_index);
-                if (source_payload != NULL) {
-                    memset(source_payload, 0, (size_t)world->inline_payload_bytes);
-                }
-                if (target_payload != NULL) {
-                    memset(target_payload, 0, (size_t)world->inline_payload_bytes);
-                }
+    if (rg_material_uses_overflow(world, material) != 0u) {
+        if (chunk->overflow_payloads != NULL && chunk->overflow_payloads[cell_index] != NULL) {
+            rg_free_bytes(
+                &world->allocator,
+                chunk->overflow_payloads[cell_index],
+                material->instance_size,
+                material->instance_align);
+            chunk->overflow_payloads[cell_index] = NULL;
+            if (task_output != NULL) {
+                task_output->payload_overflow_frees += 1u;
+            } else {
+                world->payload_overflow_frees += 1u;
             }
         }
         return;
     }
 
-    source_payload = rg_chunk_payload_ptr(world, source_chunk, source_index);
-    target_payload = rg_chunk_payload_ptr(world, target_chunk, target_index);
-    if (source_payload == NULL || target_payload == NULL) {
-        return;
-    }
-
-    memset(target_payload, 0, (size_t)world->inline_payload_bytes);
-    if (material->instance_move != NULL) {
-        material->instance_move(target_payload, source_payload, material->user_data);
-    } else {
-        memmove(target_payload, source_payload, material->instance_size);
+    if (payload != NULL) {
+        memset(payload, 0, (size_t)world->inline_payload_bytes);
     }
-    memset(source_payload, 0, (size_t)world->inline_payload_bytes);
 }
 
-static uint8_t rg_apply_cross_intent(rg_world_t* world, const rg_cross_intent_t* intent)
+static rg_status_t rg_write_cell_instance(
+    rg_world_t* world,
+    rg_chunk_t* chunk,
+    uint32_t cell_index,
+    const rg_material_record_t* material,
+    const void* instance_data,
+    rg_task_output_t* task_output)
 {
-    rg_chunk_entry_t* source_entry;
-    rg_chunk_entry_t* target_entry;
-    rg_chunk_t* source_chunk;
-    rg_chunk_t* target_chunk;
-    rg_material_id_t source_material_id;
-    rg_material_id_t target_material_id;
-    const rg_material_record_t* source_material;
+    void* payload;
 
-    if (world == NULL || intent == NULL) {
-        return 0u;
-    }
-    if (intent->source_chunk_index >= world->chunk_count ||
-        intent->target_chunk_index >= world->chunk_count ||
-        intent->source_cell_index >= world->cells_per_chunk ||
-        intent->target_cell_index >= world->cells_per_chunk) {
-        return 0u;
+    if (world == NULL || chunk == NULL || material == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
     }
 
-    source_entry = &world->chunks[intent->source_chunk_index];
-    target_entry = &world->chunks[intent->target_chunk_index];
-    source_chunk = source_entry->chunk;
-    target_chunk = target_entry->chunk;
-    if (source_chunk == NULL || target_chunk == NULL) {
-        return 0u;
+    if (material->instance_size == 0u) {
+        return RG_STATUS_OK;
     }
 
-    source_material_id = source_chunk->material_ids[intent->source_cell_index];
-    target_material_id = target_chunk->material_ids[intent->target_cell_index];
-    if (source_material_id != intent->source_material_id ||
-        target_material_id != intent->target_material_id) {
-        return 0u;
-    }
+    if (rg_material_uses_overflow(world, material) != 0u) {
+        if (chunk->overflow_payloads == NULL) {
+            return RG_STATUS_ALLOCATION_FAILED;
+        }
 
-    if (intent->target_material_id == 0u) {
-        source_material = rg_material_get(world, source_material_id);
-        if (source_material == NULL) {
-            return 0u;
+        payload = rg_alloc_bytes(&world->allocator, material->instance_size, material->instance_align);
+        if (payload == NULL) {
+            return RG_STATUS_ALLOCATION_FAILED;
         }
+        memset(payload, 0, material->instance_size);
 
-        target_chunk->material_ids[intent->target_cell_index] = source_material_id;
-        source_chunk->material_ids[intent->source_cell_index] = 0u;
-        rg_payload_move(
-            world,
-            source_chunk,
-            intent->source_cell_index,
-            target_chunk,
-            intent->target_cell_index,
-            source_material);
+        if (instance_data != NULL) {
+            memmove(payload, instance_data, material->instance_size);
+        } else if (material->instance_ctor != NULL) {
+            material->instance_ctor(payload, material->user_data);
+        }
 
-        if (source_chunk != target_chunk) {
-            if (source_chunk->live_cells > 0u) {
-                source_chunk->live_cells -= 1u;
+        chunk->overflow_payloads[cell_index] = payload;
+        if (task_output != NULL) {
+            task_output->payload_overflow_allocs += 1u;
+        } else {
+            world->payload_overflow_allocs += 1u;
+        }
+
+        if (world->inline_payload_bytes > 0u && chunk->inline_payload != NULL) {
+            void* inline_payload;
+            inline_payload = rg_chunk_payload_ptr(world, chunk, cell_index);
+            if (inline_payload != NULL) {
+                memset(inline_payload, 0, (size_t)world->inline_payload_bytes);
             }
-            target_chunk->live_cells += 1u;
         }
-    } else {
-        target_chunk->material_ids[intent->target_cell_index] = source_material_id;
-        source_chunk->material_ids[intent->source_cell_index] = intent->target_material_id;
-        rg_payload_swap(
-            world,
-            source_chunk,
-            intent->source_cell_index,
-            target_chunk,
-            intent->target_cell_index);
+        return RG_STATUS_OK;
     }
 
-    rg_mask_set(target_chunk, intent->target_cell_index);
-    source_chunk->idle_steps = 0u;
-    target_chunk->idle_steps = 0u;
-    source_chunk->awake = (uint8_t)(source_chunk->live_cells > 0u);
-    target_chunk->awake = (uint8_t)(target_chunk->live_cells > 0u);
-    return 1u;
-}
-
-static rg_status_t rg_merge_cross_intents(
-    rg_world_t* world,
-    rg_task_output_t* outputs,
-    uint32_t output_count)
-{
-    rg_cross_intent_t* merged;
-    uint32_t total_intents;
-    uint32_t write_cursor;
-    uint32_t i;
-
-    if (world == NULL) {
+    payload = rg_chunk_payload_ptr(world, chunk, cell_index);
+    if (payload == NULL) {
         return RG_STATUS_INVALID_ARGUMENT;
     }
-    if (outputs == NULL || output_count == 0u) {
-        return RG_STATUS_OK;
+
+    memset(payload, 0, (size_t)world->inline_payload_bytes);
+    if (instance_data != NULL) {
+        memmove(payload, instance_data, material->instance_size);
+    } else if (material->instance_ctor != NULL) {
+        material->instance_ctor(payload, material->user_data);
     }
 
-    total_intents = 0u;
-    for (i = 0u; i < output_count; ++i) {
-        if (outputs[i].intent_count > UINT32_MAX - total_intents) {
-            return RG_STATUS_CAPACITY_REACHED;
-        }
-        total_intents += outputs[i].intent_count;
+    if (chunk->overflow_payloads != NULL) {
+        chunk->overflow_payloads[cell_index] = NULL;
     }
 
-    if (total_intents == 0u) {
-        return RG_STATUS_OK;
+    return RG_STATUS_OK;
+}
+
+static void rg_update_live_counts(
+    rg_world_t* world,
+    rg_chunk_t* chunk,
+    rg_material_id_t old_material,
+    rg_material_id_t new_material,
+    rg_task_output_t* task_output)
+{
+    if (world == NULL || chunk == NULL) {
+        return;
     }
 
-    merged = (rg_cross_intent_t*)malloc((size_t)total_intents * sizeof(*merged));
-    if (merged == NULL) {
-        return RG_STATUS_ALLOCATION_FAILED;
+    if (task_output != NULL && task_output->tiled != 0u) {
+        int64_t delta;
+
+        delta = (int64_t)(new_material != 0u) - (int64_t)(old_material != 0u);
+        task_output->live_cell_delta += delta;
+        task_output->chunk_live_delta += delta;
+        return;
     }
 
-    write_cursor = 0u;
-    for (i = 0u; i < output_count; ++i) {
-        if (outputs[i].intent_count == 0u) {
-            continue;
+    if (old_material == 0u && new_material != 0u) {
+        if (task_output != NULL) {
+            task_output->live_cell_delta += 1;
+        } else {
+            world->live_cells += 1u;
         }
-        memcpy(
-            &merged[write_cursor],
-            outputs[i].intents,
-            (size_t)outputs[i].intent_count * sizeof(*merged));
-        write_cursor += outputs[i].intent_count;
+        chunk->live_cells += 1u;
+        chunk->idle_steps = 0u;
+        rg_chunk_set_awake(world, chunk, 1u);
+        return;
     }
 
-    qsort(merged, (size_t)total_intents, sizeof(*merged), rg_intent_compare_by_target);
-
-    i = 0u;
-    while (i < total_intents) {
-        uint32_t j;
-        uint8_t applied;
-
-        j = i + 1u;
-        while (j < total_intents &&
-               merged[j].target_chunk_index == merged[i].target_chunk_index &&
-               merged[j].target_cell_index == merged[i].target_cell_index) {
-            j += 1u;
+    if (old_material != 0u && new_material == 0u) {
+        if (task_output != NULL) {
+            task_output->live_cell_delta -= 1;
+        } else if (world->live_cells > 0u) {
+            world->live_cells -= 1u;
         }
-
-        if (j > i + 1u) {
-            world->intent_conflicts_last_step += (uint64_t)(j - i - 1u);
+        if (chunk->live_cells > 0u) {
+            chunk->live_cells -= 1u;
         }
 
-        applied = 0u;
-        while (i < j) {
-            if (applied == 0u && rg_apply_cross_intent(world, &merged[i]) != 0u) {
-                applied = 1u;
-            }
-            i += 1u;
+        chunk->idle_steps = 0u;
+        if (chunk->live_cells == 0u) {
+            rg_chunk_set_awake(world, chunk, 0u);
+        } else {
+            rg_chunk_set_awake(world, chunk, 1u);
         }
+        return;
     }
 
-    free(merged);
-    return RG_STATUS_OK;
+    if (old_material != 0u && new_material != 0u) {
+        chunk->idle_steps = 0u;
+        rg_chunk_set_awake(world, chunk, 1u);
+    }
 }
 
-static uint8_t rg_attempt_move(
-    rg_world_t* world,
-    uint32_t source_chunk_index,
-    rg_chunk_entry_t* source_entry,
-    int32_t source_local_x,
-    int32_t source_local_y,
-    uint32_t source_index,
-    rg_material_id_t source_material_id,
-    const rg_material_record_t* source_material,
-    int32_t dx,
-    int32_t dy,
-    uint8_t allow_lateral_displace,
-    uint8_t emit_cross_intents,
-    rg_task_output_t* task_output)
+static rg_status_t rg_locate_cell(
+    const rg_world_t* world,
+    rg_cell_coord_t cell,
+    uint32_t* out_chunk_index,
+    uint32_t* out_cell_index)
 {
-    rg_status_t status;
-    rg_chunk_entry_t* target_entry;
-    uint32_t target_chunk_index;
-    int32_t target_local_x;
-    int32_t target_local_y;
-    uint32_t target_index;
-    rg_chunk_t* source_chunk;
-    rg_chunk_t* target_chunk;
-    rg_material_id_t target_material_id;
-    const rg_material_record_t* target_material;
+    int32_t local_x;
+    int32_t local_y;
+    int32_t chunk_x;
+    int32_t chunk_y;
+    uint32_t chunk_index;
 
-    if (world == NULL || source_entry == NULL || source_material == NULL || source_material_id == 0u) {
-        return 0u;
+    if (world == NULL || out_chunk_index == NULL || out_cell_index == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
     }
 
-    status = rg_resolve_target(
-        world,
-        source_entry,
-        source_local_x,
-        source_local_y,
-        dx,
-        dy,
-        &target_entry,
-        &target_chunk_index,
-        &target_index,
-        &target_local_x,
-        &target_local_y);
-    if (status != RG_STATUS_OK) {
-        return 0u;
-    }
+    rg_split_coord(cell.x, world->chunk_width, &chunk_x, &local_x);
+    rg_split_coord(cell.y, world->chunk_height, &chunk_y, &local_y);
 
-    source_chunk = source_entry->chunk;
-    target_chunk = target_entry->chunk;
-    if (source_chunk == NULL || target_chunk == NULL) {
-        return 0u;
+    chunk_index = rg_chunk_find_index(world, chunk_x, chunk_y);
+    if (chunk_index == UINT32_MAX) {
+        return RG_STATUS_NOT_FOUND;
     }
 
-    target_material_id = target_chunk->material_ids[target_index];
-    if (target_material_id != 0u) {
-        target_material = rg_material_get(world, target_material_id);
-        if (target_material == NULL) {
-            return 0u;
-        }
-        if (rg_can_displace(source_material, target_material, dy, allow_lateral_displace) == 0u) {
-            return 0u;
-        }
-
-        if (emit_cross_intents != 0u && target_chunk_index != source_chunk_index) {
-            rg_cross_intent_t intent;
-
-            if (task_output == NULL) {
-                return 0u;
-            }
-
-            intent.source_chunk_index = source_chunk_index;
-            intent.target_chunk_index = target_chunk_index;
-            intent.source_cell_index = source_index;
-            intent.target_cell_index = target_index;
-            intent.source_material_id = source_material_id;
-            intent.target_material_id = target_material_id;
-            if (rg_task_output_push_intent(task_output, &intent) == 0u) {
-                return 0u;
-            }
-            task_output->emitted_move_count += 1u;
-            return 1u;
-        }
+    *out_chunk_index = chunk_index;
+    *out_cell_index = ((uint32_t)local_y * (uint32_t)world->chunk_width) + (uint32_t)local_x;
+    return RG_STATUS_OK;
+}
 
-        target_chunk->material_ids[target_index] = source_material_id;
-        source_chunk->material_ids[source_index] = target_material_id;
-        rg_payload_swap(world, source_chunk, source_index, target_chunk, target_index);
-    } else {
-        if (emit_cross_intents != 0u && target_chunk_index != source_chunk_index) {
-            rg_cross_intent_t intent;
+static rg_status_t rg_chunk_create(rg_world_t* world, rg_chunk_t** out_chunk)
+{
+    rg_chunk_t* chunk;
+    size_t material_bytes;
+    size_t payload_bytes;
+    size_t overflow_bytes;
+    size_t mask_bytes;
 
-            if (task_output == NULL) {
-                return 0u;
-            }
+    if (world == NULL || out_chunk == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
 
-            intent.source_chunk_index = source_chunk_index;
-            intent.target_chunk_index = target_chunk_index;
-            intent.source_cell_index = source_index;
-            intent.target_cell_index = target_index;
-            intent.source_material_id = source_material_id;
-            intent.target_material_id = 0u;
-            if (rg_task_output_push_intent(task_output, &intent) == 0u) {
-                return 0u;
-            }
-            task_output->emitted_move_count += 1u;
-            return 1u;
-        }
+    *out_chunk = NULL;
 
-        target_chunk->material_ids[target_index] = source_material_id;
-        source_chunk->material_ids[source_index] = 0u;
-        rg_payload_move(world, source_chunk, source_index, target_chunk, target_index, source_material);
+    chunk = (rg_chunk_t*)rg_alloc_bytes(&world->allocator, sizeof(*chunk), _Alignof(rg_chunk_t));
+    if (chunk == NULL) {
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+    memset(chunk, 0, sizeof(*chunk));
+    chunk->sleep_ticks = world->sleep_ticks;
 
-        if (source_chunk != target_chunk) {
-            if (source_chunk->live_cells > 0u) {
-                source_chunk->live_cells -= 1u;
-            }
-            target_chunk->live_cells += 1u;
+    material_bytes = (size_t)world->cells_per_chunk * sizeof(*chunk->material_ids);
+    chunk->material_ids = (uint16_t*)rg_alloc_bytes(
+        &world->allocator,
+        material_bytes,
+        _Alignof(uint16_t));
+    if (chunk->material_ids == NULL) {
+        rg_free_bytes(&world->allocator, chunk, sizeof(*chunk), _Alignof(rg_chunk_t));
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+    memset(chunk->material_ids, 0, material_bytes);
 
-            if (source_chunk->live_cells == 0u) {
-                source_chunk->idle_steps = 0u;
-                rg_chunk_set_awake(world, source_chunk, 0u);
-            }
+    payload_bytes = (size_t)world->cells_per_chunk * (size_t)world->inline_payload_bytes;
+    if (payload_bytes > 0u) {
+        chunk->inline_payload = (uint8_t*)rg_alloc_bytes(&world->allocator, payload_bytes, 1u);
+        if (chunk->inline_payload == NULL) {
+            rg_free_bytes(&world->allocator, chunk->material_ids, material_bytes, _Alignof(uint16_t));
+            rg_free_bytes(&world->allocator, chunk, sizeof(*chunk), _Alignof(rg_chunk_t));
+            return RG_STATUS_ALLOCATION_FAILED;
         }
+        memset(chunk->inline_payload, 0, payload_bytes);
     }
 
-    source_chunk->idle_steps = 0u;
-    target_chunk->idle_steps = 0u;
-    rg_set_chunk_awake_for_mode(
-        world,
-        source_chunk,
-        (uint8_t)(source_chunk->live_cells > 0u),
-        task_output);
-    rg_set_chunk_awake_for_mode(
-        world,
-        target_chunk,
-        (uint8_t)(target_chunk->live_cells > 0u),
-        task_output);
-    rg_mask_set(target_chunk, target_index);
+    overflow_bytes = (size_t)world->cells_per_chunk * sizeof(*chunk->overflow_payloads);
+    chunk->overflow_payloads = (void**)rg_alloc_bytes(
+        &world->allocator,
+        overflow_bytes,
+        _Alignof(void*));
+    if (chunk->overflow_payloads == NULL) {
+        rg_free_bytes(&world->allocator, chunk->inline_payload, payload_bytes, 1u);
+        rg_free_bytes(&world->allocator, chunk->material_ids, material_bytes, _Alignof(uint16_t));
+        rg_free_bytes(&world->allocator, chunk, sizeof(*chunk), _Alignof(rg_chunk_t));
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+    memset(chunk->overflow_payloads, 0, overflow_bytes);
 
-    if (task_output != NULL) {
-        task_output->emitted_move_count += 1u;
-    } else {
-        world->intents_emitted_last_step += 1u;
+    mask_bytes = ((size_t)world->cells_per_chunk + 7u) / 8u;
+    chunk->updated_mask = (uint8_t*)rg_alloc_bytes(&world->allocator, mask_bytes, 1u);
+    if (chunk->updated_mask == NULL) {
+        rg_free_bytes(&world->allocator, chunk->overflow_payloads, overflow_bytes, _Alignof(void*));
+        rg_free_bytes(&world->allocator, chunk->inline_payload, payload_bytes, 1u);
+        rg_free_bytes(&world->allocator, chunk->material_ids, material_bytes, _Alignof(uint16_t));
+        rg_free_bytes(&world->allocator, chunk, sizeof(*chunk), _Alignof(rg_chunk_t));
+        return RG_STATUS_ALLOCATION_FAILED;
     }
-    (void)target_local_x;
-    (void)target_local_y;
-    return 1u;
+    memset(chunk->updated_mask, 0, mask_bytes);
+    chunk->live_cells = 0u;
+    chunk->idle_steps = 0u;
+    chunk->active_slot = UINT32_MAX;
+    chunk->awake = 0u;
+
+    *out_chunk = chunk;
+    return RG_STATUS_OK;
 }
 
-static uint8_t rg_step_powder(
-    rg_world_t* world,
-    uint32_t source_chunk_index,
-    rg_chunk_entry_t* source_entry,
-    int32_t source_local_x,
-    int32_t source_local_y,
-    uint32_t source_index,
-    rg_material_id_t source_material_id,
-    const rg_material_record_t* source_material,
-    uint8_t primary_left,
-    uint8_t emit_cross_intents,
-    rg_task_output_t* task_output)
+static void rg_chunk_destroy(rg_world_t* world, rg_chunk_t* chunk)
 {
-    int32_t first_dx;
-    int32_t second_dx;
+    size_t material_bytes;
+    size_t payload_bytes;
+    size_t overflow_bytes;
+    size_t mask_bytes;
+    uint32_t i;
+
+    if (world == NULL || chunk == NULL) {
+        return;
+    }
+
+    for (i = 0u; i < world->cells_per_chunk; ++i) {
+        rg_material_id_t material_id;
+        const rg_material_record_t* material;
+
+        material_id = chunk->material_ids[i];
+        if (material_id == 0u) {
+            continue;
+        }
+
+        material = rg_material_get(world, material_id);
+        if (material != NULL) {
+            rg_release_cell_instance(world, chunk, i, material, NULL);
+        }
+    }
+
+    material_bytes = (size_t)world->cells_per_chunk * sizeof(*chunk->material_ids);
+    payload_bytes = (size_t)world->cells_per_chunk * (size_t)world->inline_payload_bytes;
+    overflow_bytes = (size_t)world->cells_per_chunk * sizeof(*chunk->overflow_payloads);
+    mask_bytes = ((size_t)world->cells_per_chunk + 7u) / 8u;
+
+    rg_free_bytes(&world->allocator, chunk->updated_mask, mask_bytes, 1u);
+    rg_free_bytes(&world->allocator, chunk->overflow_payloads, overflow_bytes, _Alignof(void*));
+    rg_free_bytes(&world->allocator, chunk->inline_payload, payload_bytes, 1u);
+    rg_free_bytes(&world->allocator, chunk->material_ids, material_bytes, _Alignof(uint16_t));
+    rg_free_bytes(&world->allocator, chunk, sizeof(*chunk), _Alignof(rg_chunk_t));
+}
+
+static uint32_t rg_chunk_insert_index(const rg_world_t* world, int32_t chunk_x, int32_t chunk_y)
+{
+    if (world == NULL) {
+        return 0u;
+    }
+    return rg_chunk_lower_bound(world, chunk_x, chunk_y);
+}
+
+static uint64_t rg_step_seed(const rg_world_t* world)
+{
+    uint64_t seed;
+
+    seed = world->deterministic_seed;
+    if (world->deterministic_mode == 0u) {
+        seed ^= (uint64_t)(uintptr_t)world;
+    }
+    return seed;
+}
+
+static uint32_t rg_step_random(
+    const rg_world_t* world,
+    uint64_t tick,
+    int32_t chunk_x,
+    int32_t chunk_y,
+    int32_t local_x,
+    int32_t local_y,
+    uint32_t salt)
+{
+    uint64_t key;
+
+    if (world == NULL) {
+        return 0u;
+    }
+
+    key = rg_step_seed(world);
+    key ^= tick * 0x9e3779b97f4a7c15ull;
+    key ^= ((uint64_t)(uint32_t)chunk_x << 32u) ^ (uint64_t)(uint32_t)chunk_y;
+    key ^= ((uint64_t)(uint32_t)local_x << 32u) ^ (uint64_t)(uint32_t)local_y;
+    key ^= (uint64_t)salt * 0xd6e8feb86659fd93ull;
+
+    return (uint32_t)rg_mix_u64(key);
+}
+
+static void rg_random_fill_words(uint64_t key, uint32_t first_word, uint32_t word_count, uint64_t* out_words)
+{
+    uint32_t i;
+
+    for (i = 0u; i < word_count; ++i) {
+        out_words[i] = rg_mix_u64(key + ((uint64_t)(first_word + i) + 1u) * 0x9e3779b97f4a7c15ull);
+    }
+}
+
+static void rg_random_stream_init(
+    rg_random_stream_t* stream,
+    const rg_world_t* world,
+    uint64_t tick,
+    int32_t chunk_x,
+    int32_t chunk_y,
+    uint32_t salt)
+{
+    uint64_t key;
+
+    key = rg_step_seed(world);
+    key ^= tick * 0x9e3779b97f4a7c15ull;
+    key ^= ((uint64_t)(uint32_t)chunk_x << 32u) ^ (uint64_t)(uint32_t)chunk_y;
+    key ^= (uint64_t)salt * 0xd6e8feb86659fd93ull;
+
+    stream->key = rg_mix_u64(key);
+    stream->block_index = UINT32_MAX;
+}
+
+static uint8_t rg_random_stream_bit(rg_random_stream_t* stream, uint32_t bit_index)
+{
+    uint32_t word_index;
+    uint32_t block_index;
+
+    word_index = bit_index >> 6u;
+    block_index = word_index / RG_RANDOM_BLOCK_WORDS;
+    if (block_index != stream->block_index) {
+        rg_random_fill_words(
+            stream->key,
+            block_index * RG_RANDOM_BLOCK_WORDS,
+            RG_RANDOM_BLOCK_WORDS,
+            stream->words);
+        stream->block_index = block_index;
+    }
+
+    return (uint8_t)((stream->words[word_index % RG_RANDOM_BLOCK_WORDS] >> (bit_index & 63u)) & 1u);
+}
+
+static rg_status_t rg_resolve_target(
+    const rg_world_t* world,
+    const rg_chunk_entry_t* source_entry,
+    int32_t source_local_x,
+    int32_t source_local_y,
+    int32_t dx,
+    int32_t dy,
+    rg_chunk_entry_t** out_target_entry,
+    uint32_t* out_target_chunk_index,
+    uint32_t* out_target_index,
+    int32_t* out_target_local_x,
+    int32_t* out_target_local_y)
+{
+    int32_t target_local_x;
+    int32_t target_local_y;
+    int32_t chunk_dx;
+    int32_t chunk_dy;
+    rg_chunk_t* target_chunk;
+
+    if (world == NULL ||
+        source_entry == NULL ||
+        out_target_entry == NULL ||
+        out_target_chunk_index == NULL ||
+        out_target_index == NULL ||
+        out_target_local_x == NULL ||
+        out_target_local_y == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+
+    chunk_dx = 0;
+    chunk_dy = 0;
+    target_local_x = source_local_x + dx;
+    target_local_y = source_local_y + dy;
+
+    if (target_local_x < 0) {
+        chunk_dx = -1;
+        target_local_x += world->chunk_width;
+    } else if (target_local_x >= world->chunk_width) {
+        chunk_dx = 1;
+        target_local_x -= world->chunk_width;
+    }
+
+    if (target_local_y < 0) {
+        chunk_dy = -1;
+        target_local_y += world->chunk_height;
+    } else if (target_local_y >= world->chunk_height) {
+        chunk_dy = 1;
+        target_local_y -= world->chunk_height;
+    }
+
+    if (chunk_dx == 0 && chunk_dy == 0) {
+        target_chunk = source_entry->chunk;
+    } else {
+        target_chunk = source_entry->chunk->neighbors[rg_dir_from_offset(chunk_dx, chunk_dy)];
+        if (target_chunk == NULL) {
+            return RG_STATUS_NOT_FOUND;
+        }
+    }
+
+    *out_target_entry = &((rg_world_t*)world)->chunks[target_chunk->entry_index];
+    *out_target_chunk_index = target_chunk->entry_index;
+    *out_target_local_x = target_local_x;
+    *out_target_local_y = target_local_y;
+    *out_target_index = ((uint32_t)target_local_y * (uint32_t)world->chunk_width) + (uint32_t)target_local_x;
+    return RG_STATUS_OK;
+}
+
+static uint8_t rg_can_displace(
+    const rg_material_record_t* source_material,
+    const rg_material_record_t* target_material,
+    int32_t dy,
+    uint8_t allow_lateral_displace)
+{
+    if (source_material == NULL || target_material == NULL) {
+        return 0u;
+    }
+    if ((target_material->flags & RG_MATERIAL_STATIC) != 0u) {
+        return 0u;
+    }
+
+    if (dy > 0) {
+        return (uint8_t)(source_material->density > target_material->density);
+    }
+    if (dy < 0) {
+        return (uint8_t)(source_material->density < target_material->density);
+    }
+    if (allow_lateral_displace != 0u) {
+        return (uint8_t)(source_material->density != target_material->density);
+    }
+    return 0u;
+}
+
+/* Slices are sized so this never fills; a full slice drops the move rather than allocate. */
+static uint8_t rg_task_output_push_intent(rg_task_output_t* output, const rg_cross_intent_t* intent)
+{
+    if (output == NULL || intent == NULL || output->intent_count >= output->intent_capacity) {
+        return 0u;
+    }
+
+    output->intents[output->intent_count] = *intent;
+    output->intent_count += 1u;
+    return 1u;
+}
+
+/* Keeps the intent slice; rg_scratch_bind_intents assigns it per phase. */
+static void rg_task_output_reset(rg_task_output_t* output)
+{
+    output->intent_count = 0u;
+    output->emitted_move_count = 0u;
+    output->live_cell_delta = 0;
+    output->payload_overflow_allocs = 0u;
+    output->payload_overflow_frees = 0u;
+    output->chunk_live_delta = 0;
+    output->border_dirty = 0u;
+    output->tiled = 0u;
+    output->changed = 0u;
+    output->skipped = 0u;
+    output->remote_commit = (uint8_t)RG_REMOTE_COMMIT_INTENTS;
+    output->neighbor_touched = 0u;
+    memset(output->neighbor_border_dirty, 0, sizeof(output->neighbor_border_dirty));
+    memset(output->neighbor_live_delta, 0, sizeof(output->neighbor_live_delta));
+    output->neighbor_flushed = 0u;
+    output->lod_skipped = 0u;
+    output->cross_intent_count = 0u;
+    output->intent_conflicts = 0u;
+    output->chunk_wakes = 0u;
+    output->chunk_sleeps = 0u;
+}
+
+static int rg_intent_compare_by_target(const void* lhs_void, const void* rhs_void)
+{
+    const rg_cross_intent_t* lhs;
+    const rg_cross_intent_t* rhs;
+
+    lhs = (const rg_cross_intent_t*)lhs_void;
+    rhs = (const rg_cross_intent_t*)rhs_void;
+
+    if (lhs->target_chunk_index < rhs->target_chunk_index) {
+        return -1;
+    }
+    if (lhs->target_chunk_index > rhs->target_chunk_index) {
+        return 1;
+    }
+    if (lhs->target_cell_index < rhs->target_cell_index) {
+        return -1;
+    }
+    if (lhs->target_cell_index > rhs->target_cell_index) {
+        return 1;
+    }
+    if (lhs->source_chunk_index < rhs->source_chunk_index) {
+        return -1;
+    }
+    if (lhs->source_chunk_index > rhs->source_chunk_index) {
+        return 1;
+    }
+    if (lhs->source_cell_index < rhs->source_cell_index) {
+        return -1;
+    }
+    if (lhs->source_cell_index > rhs->source_cell_index) {
+        return 1;
+    }
+    return 0;
+}
+
+/*
+ * Stable LSD radix sort on 8-bit digits over the low key_bits of each key.
+ * Digits every key shares are skipped. Returns whichever buffer holds the result.
+ */
+static rg_intent_sort_entry_t* rg_radix_sort_intents(
+    rg_intent_sort_entry_t* entries,
+    rg_intent_sort_entry_t* temp,
+    uint32_t count,
+    uint32_t key_bits)
+{
+    uint32_t shift;
+    uint32_t i;
+
+    for (shift = 0u; shift < key_bits; shift += 8u) {
+        uint32_t counts[256];
+        uint32_t offset;
+        uint32_t digit;
+        rg_intent_sort_entry_t* swap;
+
+        memset(counts, 0, sizeof(counts));
+        for (i = 0u; i < count; ++i) {
+            counts[(entries[i].key >> shift) & 0xFFu] += 1u;
+        }
+        if (counts[(entries[0].key >> shift) & 0xFFu] == count) {
+            continue;
+        }
+
+        offset = 0u;
+        for (digit = 0u; digit < 256u; ++digit) {
+            uint32_t digit_count;
+
+            digit_count = counts[digit];
+            counts[digit] = offset;
+            offset += digit_count;
+        }
+        for (i = 0u; i < count; ++i) {
+            temp[counts[(entries[i].key >> shift) & 0xFFu]++] = entries[i];
+        }
+
+        swap = entries;
+        entries = temp;
+        temp = swap;
+    }
+
+    return entries;
+}
+
+static void rg_payload_swap(
+    rg_world_t* world,
+    rg_chunk_t* chunk_a,
+    uint32_t index_a,
+    rg_chunk_t* chunk_b,
+    uint32_t index_b)
+{
+    uint8_t* payload_a;
+    uint8_t* payload_b;
+    void* overflow_a;
+    void* overflow_b;
+
+    if (world == NULL || chunk_a == NULL || chunk_b == NULL) {
+        return;
+    }
+
+    /* Swapped through a stack buffer: tasks on different workers swap concurrently. */
+    if (world->inline_payload_bytes > 0u) {
+        payload_a = (uint8_t*)rg_chunk_payload_ptr(world, chunk_a, index_a);
+        payload_b = (uint8_t*)rg_chunk_payload_ptr(world, chunk_b, index_b);
+        if (payload_a != NULL && payload_b != NULL) {
+            uint8_t scratch[64];
+            size_t offset;
+
+            for (offset = 0u; offset < (size_t)world->inline_payload_bytes; offset += sizeof(scratch)) {
+                size_t length;
+
+                length = (size_t)world->inline_payload_bytes - offset;
+                if (length > sizeof(scratch)) {
+                    length = sizeof(scratch);
+                }
+                memcpy(scratch, payload_a + offset, length);
+                memcpy(payload_a + offset, payload_b + offset, length);
+                memcpy(payload_b + offset, scratch, length);
+            }
+        }
+    }
+
+    if (chunk_a->overflow_payloads != NULL && chunk_b->overflow_payloads != NULL) {
+        overflow_a = chunk_a->overflow_payloads[index_a];
+        overflow_b = chunk_b->overflow_payloads[index_b];
+        chunk_a->overflow_payloads[index_a] = overflow_b;
+        chunk_b->overflow_payloads[index_b] = overflow_a;
+    }
+}
+
+static void rg_payload_move(
+    rg_world_t* world,
+    rg_chunk_t* source_chunk,
+    uint32_t source_index,
+    rg_chunk_t* target_chunk,
+    uint32_t target_index,
+    const rg_material_record_t* material)
+{
+    void* source_payload;
+    void* target_payload;
+
+    if (world == NULL || material == NULL || material->instance_size == 0u) {
+        return;
+    }
+
+    if (rg_material_uses_overflow(world, material) != 0u) {
+        if (source_chunk != NULL &&
+            target_chunk != NULL &&
+            source_chunk->overflow_payloads != NULL &&
+            target_chunk->overflow_payloads != NULL) {
+            target_chunk->overflow_payloads[target_index] = source_chunk->overflow_payloads[source_index];
+            source_chunk->overflow_payloads[source_index] = NULL;
+
+            if (world->inline_payload_bytes > 0u) {
+                source_payload = rg_chunk_payload_ptr(world, source_chunk, source_index);
+                target_payload = rg_chunk_payload_ptr(world, target_chunk, target_index);
+                if (source_payload != NULL) {
+                    memset(source_payload, 0, (size_t)world->inline_payload_bytes);
+                }
+                if (target_payload != NULL) {
+                    memset(target_payload, 0, (size_t)world->inline_payload_bytes);
+                }
+            }
+        }
+        return;
+    }
+
+    source_payload = rg_chunk_payload_ptr(world, source_chunk, source_index);
+    target_payload = rg_chunk_payload_ptr(world, target_chunk, target_index);
+    if (source_payload == NULL || target_payload == NULL) {
+        return;
+    }
+
+    memset(target_payload, 0, (size_t)world->inline_payload_bytes);
+    if (material->instance_move != NULL) {
+        material->instance_move(target_payload, source_payload, material->user_data);
+    } else {
+        memmove(target_payload, source_payload, material->instance_size);
+    }
+    memset(source_payload, 0, (size_t)world->inline_payload_bytes);
+}
+
+static uint8_t rg_has_parallel_runner(const rg_world_t* world)
+{
+    if (world == NULL || world->runner == NULL || world->runner->vtable == NULL) {
+        return 0u;
+    }
+    return (uint8_t)(world->runner->vtable->parallel_for != NULL);
+}
+
+static uint8_t rg_has_graph_runner(const rg_world_t* world)
+{
+    return (uint8_t)(rg_has_parallel_runner(world) != 0u && world->runner->vtable->run_graph != NULL);
+}
+
+/* Words of scratch_merge_graph for bucket_count buckets; a bucket has at most 8 neighbors. */
+static uint64_t rg_merge_graph_words(uint32_t bucket_count)
+{
+    return 2u * ((uint64_t)bucket_count + 1u) + 8u * (uint64_t)bucket_count;
+}
+
+/*
+ * Moves or swaps an intent's cells if both still hold what the intent saw.
+ * Reads and writes only those two cells; returns 1 when the intent applied.
+ */
+static uint8_t rg_swap_cross_intent_cells(rg_world_t* world, const rg_cross_intent_t* intent)
+{
+    rg_chunk_t* source_chunk;
+    rg_chunk_t* target_chunk;
+    rg_material_id_t source_material_id;
+    rg_material_id_t target_material_id;
+    const rg_material_record_t* source_material;
+
+    if (world == NULL || intent == NULL) {
+        return 0u;
+    }
+    if (intent->source_chunk_index >= world->chunk_count ||
+        intent->target_chunk_index >= world->chunk_count ||
+        intent->source_cell_index >= world->cells_per_chunk ||
+        intent->target_cell_index >= world->cells_per_chunk) {
+        return 0u;
+    }
+
+    source_chunk = world->chunks[intent->source_chunk_index].chunk;
+    target_chunk = world->chunks[intent->target_chunk_index].chunk;
+    if (source_chunk == NULL || target_chunk == NULL) {
+        return 0u;
+    }
+
+    source_material_id = source_chunk->material_ids[intent->source_cell_index];
+    target_material_id = target_chunk->material_ids[intent->target_cell_index];
+    if (source_material_id != intent->source_material_id ||
+        target_material_id != intent->target_material_id) {
+        return 0u;
+    }
+
+    if (intent->target_material_id == 0u) {
+        source_material = rg_material_get(world, source_material_id);
+        if (source_material == NULL) {
+            return 0u;
+        }
+
+        target_chunk->material_ids[intent->target_cell_index] = source_material_id;
+        source_chunk->material_ids[intent->source_cell_index] = 0u;
+        rg_payload_move(
+            world,
+            source_chunk,
+            intent->source_cell_index,
+            target_chunk,
+            intent->target_cell_index,
+            source_material);
+    } else {
+        target_chunk->material_ids[intent->target_cell_index] = source_material_id;
+        source_chunk->material_ids[intent->source_cell_index] = intent->target_material_id;
+        rg_payload_swap(
+            world,
+            source_chunk,
+            intent->source_cell_index,
+            target_chunk,
+            intent->target_cell_index);
+    }
+    return 1u;
+}
+
+/*
+ * Cell half of applying an intent: reads and writes only the source and target
+ * cells and the target chunk's update mask. Returns 1 when the intent applied.
+ */
+static uint8_t rg_apply_cross_intent_cells(rg_world_t* world, const rg_cross_intent_t* intent)
+{
+    if (rg_swap_cross_intent_cells(world, intent) == 0u) {
+        return 0u;
+    }
+    rg_mask_set(world, world->chunks[intent->target_chunk_index].chunk, intent->target_cell_index);
+    return 1u;
+}
+
+/*
+ * Chunk half of an applied intent: live counts, wake state and border marks.
+ * Source chunks are shared between buckets, so this runs serially.
+ */
+static void rg_apply_cross_intent_chunks(rg_world_t* world, const rg_cross_intent_t* intent)
+{
+    rg_chunk_t* source_chunk;
+    rg_chunk_t* target_chunk;
+
+    source_chunk = world->chunks[intent->source_chunk_index].chunk;
+    target_chunk = world->chunks[intent->target_chunk_index].chunk;
+    if (intent->target_material_id == 0u && source_chunk != target_chunk) {
+        if (source_chunk->live_cells > 0u) {
+            source_chunk->live_cells -= 1u;
+        }
+        target_chunk->live_cells += 1u;
+    }
+
+    source_chunk->idle_steps = 0u;
+    target_chunk->idle_steps = 0u;
+    rg_chunk_set_awake(world, source_chunk, (uint8_t)(source_chunk->live_cells > 0u));
+    rg_chunk_set_awake(world, target_chunk, (uint8_t)(target_chunk->live_cells > 0u));
+    rg_chunk_mark_border(world, source_chunk, intent->source_cell_index);
+    rg_chunk_mark_border(world, target_chunk, intent->target_cell_index);
+}
+
+/* Applies one target chunk's bucket; the first intent that applies wins each target cell. */
+static void rg_intent_apply_task_callback(uint32_t task_index, uint32_t worker_index, void* user_data)
+{
+    rg_intent_apply_ctx_t* ctx;
+    const rg_intent_bucket_t* bucket;
+    uint32_t i;
+
+    (void)worker_index;
+
+    ctx = (rg_intent_apply_ctx_t*)user_data;
+    if (ctx == NULL || task_index >= ctx->bucket_count) {
+        return;
+    }
+
+    bucket = &ctx->buckets[task_index];
+    i = bucket->begin;
+    while (i < bucket->end) {
+        uint32_t target_cell_index;
+        uint8_t applied;
+
+        target_cell_index = ctx->merged[ctx->sorted[i].intent_index].target_cell_index;
+        applied = 0u;
+        while (i < bucket->end &&
+               ctx->merged[ctx->sorted[i].intent_index].target_cell_index == target_cell_index) {
+            if (applied == 0u &&
+                rg_apply_cross_intent_cells(ctx->world, &ctx->merged[ctx->sorted[i].intent_index]) != 0u) {
+                ctx->sorted[i].applied = 1u;
+                applied = 1u;
+            }
+            i += 1u;
+        }
+    }
+}
+
+/* Folds the chunk halves of a round's applied intents, in bucket order. */
+static void rg_fold_applied_intents(rg_world_t* world, const rg_intent_apply_ctx_t* apply_ctx)
+{
+    uint32_t bucket;
+    uint32_t i;
+
+    for (bucket = 0u; bucket < apply_ctx->bucket_count; ++bucket) {
+        for (i = apply_ctx->buckets[bucket].begin; i < apply_ctx->buckets[bucket].end; ++i) {
+            if (apply_ctx->sorted[i].applied != 0u) {
+                rg_apply_cross_intent_chunks(world, &apply_ctx->merged[apply_ctx->sorted[i].intent_index]);
+            }
+        }
+    }
+}
+
+static uint32_t rg_bucket_target_chunk(const rg_intent_apply_ctx_t* apply_ctx, uint32_t bucket)
+{
+    return apply_ctx->merged[apply_ctx->sorted[apply_ctx->buckets[bucket].begin].intent_index].target_chunk_index;
+}
+
+/* Task of the chunk in direction dir of task's chunk if it is a lower task, else UINT32_MAX. */
+typedef uint32_t (*rg_graph_neighbor_fn)(const void* user, uint32_t task, uint32_t dir);
+
+/*
+ * Builds a task graph in scratch_merge_graph over tasks that each own one
+ * chunk: a task depends on the lower tasks of its adjacent chunks. A chunk has
+ * eight neighbors, so there are at most four edges per task.
+ */
+static rg_status_t rg_build_neighbor_graph(
+    rg_world_t* world,
+    uint32_t task_count,
+    rg_graph_neighbor_fn neighbor_task,
+    const void* user,
+    rg_task_graph_t* graph)
+{
+    uint32_t* dependency_offsets;
+    uint32_t* dependencies;
+    uint32_t* successor_offsets;
+    uint32_t* successors;
+    uint32_t edge_count;
+    uint32_t i;
+    uint64_t words;
+    rg_status_t status;
+
+    words = rg_merge_graph_words(task_count);
+    if (words > UINT32_MAX) {
+        return RG_STATUS_CAPACITY_REACHED;
+    }
+    status = rg_scratch_reserve(
+        world,
+        (void**)&world->scratch_merge_graph,
+        &world->scratch_merge_graph_capacity,
+        (uint32_t)words,
+        sizeof(*world->scratch_merge_graph),
+        _Alignof(uint32_t));
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+
+    dependency_offsets = world->scratch_merge_graph;
+    dependencies = dependency_offsets + task_count + 1u;
+    successor_offsets = dependencies + 4u * task_count;
+    successors = successor_offsets + task_count + 1u;
+
+    memset(successor_offsets, 0, ((size_t)task_count + 1u) * sizeof(*successor_offsets));
+    edge_count = 0u;
+    for (i = 0u; i < task_count; ++i) {
+        uint32_t dir;
+
+        dependency_offsets[i] = edge_count;
+        for (dir = 0u; dir < RG_DIR_COUNT; ++dir) {
+            uint32_t neighbor;
+
+            neighbor = neighbor_task(user, i, dir);
+            if (neighbor < i) {
+                dependencies[edge_count] = neighbor;
+                edge_count += 1u;
+                successor_offsets[neighbor + 1u] += 1u;
+            }
+        }
+    }
+    dependency_offsets[task_count] = edge_count;
+
+    /* Successor lists: prefix sums, then fill using each start as a cursor and shift back. */
+    for (i = 1u; i <= task_count; ++i) {
+        successor_offsets[i] += successor_offsets[i - 1u];
+    }
+    for (i = 0u; i < task_count; ++i) {
+        uint32_t edge;
+
+        for (edge = dependency_offsets[i]; edge < dependency_offsets[i + 1u]; ++edge) {
+            successors[successor_offsets[dependencies[edge]]] = i;
+            successor_offsets[dependencies[edge]] += 1u;
+        }
+    }
+    for (i = task_count; i > 0u; --i) {
+        successor_offsets[i] = successor_offsets[i - 1u];
+    }
+    successor_offsets[0] = 0u;
+
+    graph->task_count = task_count;
+    graph->dependency_offsets = dependency_offsets;
+    graph->dependencies = dependencies;
+    graph->successor_offsets = successor_offsets;
+    graph->successors = successors;
+    return RG_STATUS_OK;
+}
+
+/*
+ * Within a color, buckets are in target chunk order, so a neighbor's bucket is
+ * found by binary search in its color's range. Adjacent chunks differ in
+ * color; only colors of earlier rounds are searched.
+ */
+static uint32_t rg_bucket_graph_neighbor(const void* user, uint32_t bucket, uint32_t dir)
+{
+    const rg_intent_apply_ctx_t* apply_ctx;
+    const rg_world_t* world;
+    const rg_chunk_t* chunk;
+    const rg_chunk_entry_t* neighbor_entry;
+    uint32_t neighbor_color;
+    uint32_t low;
+    uint32_t high;
+
+    apply_ctx = (const rg_intent_apply_ctx_t*)user;
+    world = apply_ctx->world;
+    chunk = world->chunks[rg_bucket_target_chunk(apply_ctx, bucket)].chunk;
+    if (chunk->neighbors[dir] == NULL) {
+        return UINT32_MAX;
+    }
+    neighbor_entry = &world->chunks[chunk->neighbors[dir]->entry_index];
+    neighbor_color = ((uint32_t)neighbor_entry->chunk_x & 1u) | (((uint32_t)neighbor_entry->chunk_y & 1u) << 1u);
+    low = apply_ctx->color_offsets[neighbor_color];
+    high = apply_ctx->color_offsets[neighbor_color + 1u];
+    if (high > bucket) {
+        return UINT32_MAX;
+    }
+    while (low < high) {
+        uint32_t mid;
+
+        mid = low + (high - low) / 2u;
+        if (rg_bucket_target_chunk(apply_ctx, mid) < chunk->neighbors[dir]->entry_index) {
+            low = mid + 1u;
+        } else {
+            high = mid;
+        }
+    }
+    if (low < apply_ctx->color_offsets[neighbor_color + 1u] &&
+        rg_bucket_target_chunk(apply_ctx, low) == chunk->neighbors[dir]->entry_index) {
+        return low;
+    }
+    return UINT32_MAX;
+}
+
+/*
+ * Runs all apply rounds as one task graph over the color-ordered buckets. A
+ * bucket touches only cells within one cell of its target chunk, so with chunks
+ * of at least 2x2 it can only conflict with buckets of adjacent target chunks,
+ * which have other colors. Each bucket depends on its adjacent buckets from
+ * earlier rounds: those pairs keep the round order and all others are disjoint,
+ * so cells end up exactly as with barriers between rounds.
+ */
+static rg_status_t rg_apply_intent_graph(rg_world_t* world, rg_intent_apply_ctx_t* apply_ctx)
+{
+    rg_task_graph_t graph;
+    rg_status_t status;
+
+    status = rg_build_neighbor_graph(world, apply_ctx->bucket_count, rg_bucket_graph_neighbor, apply_ctx, &graph);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+    graph.task = rg_intent_apply_task_callback;
+    graph.task_user_data = apply_ctx;
+    return world->runner->vtable->run_graph(world->runner->user, &graph);
+}
+
+/*
+ * Applies all cross-chunk intents of a phase in (target cell, source chunk,
+ * source cell) order; the first intent that applies wins its target. Chunk and
+ * cell indices pack into global cell ids, so the ordering is one 64-bit key and
+ * sorts in linear time whenever two ids fit. Larger worlds fall back to qsort.
+ *
+ * Intents are then bucketed by target chunk and applied in four rounds by the
+ * target chunk's color. Moves span one cell, so buckets of one color touch
+ * disjoint cells and run in parallel; the result depends only on the sort.
+ * Runners with run_graph get the rounds as one graph instead of four barriers.
+ */
+static rg_status_t rg_merge_cross_intents(
+    rg_world_t* world,
+    rg_task_output_t* outputs,
+    uint32_t output_count)
+{
+    rg_cross_intent_t* merged;
+    rg_intent_sort_entry_t* sorted;
+    rg_intent_bucket_t* buckets;
+    rg_intent_bucket_t* color_buckets;
+    rg_intent_apply_ctx_t apply_ctx;
+    uint32_t color_offsets[5];
+    uint64_t cell_id_count;
+    uint32_t cell_id_bits;
+    uint32_t total_intents;
+    uint32_t bucket_count;
+    uint32_t round_count;
+    uint32_t write_cursor;
+    uint32_t color;
+    uint32_t i;
+    rg_status_t status;
+
+    if (world == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (outputs == NULL || output_count == 0u) {
+        return RG_STATUS_OK;
+    }
+
+    total_intents = 0u;
+    for (i = 0u; i < output_count; ++i) {
+        if (outputs[i].intent_count > UINT32_MAX - total_intents) {
+            return RG_STATUS_CAPACITY_REACHED;
+        }
+        total_intents += outputs[i].intent_count;
+    }
+
+    if (total_intents == 0u) {
+        return RG_STATUS_OK;
+    }
+    if (total_intents > UINT32_MAX / 2u) {
+        return RG_STATUS_CAPACITY_REACHED;
+    }
+    world->cross_intents_last_step += total_intents;
+
+    status = rg_scratch_reserve(
+        world,
+        (void**)&world->scratch_merged,
+        &world->scratch_merged_capacity,
+        total_intents,
+        sizeof(*world->scratch_merged),
+        _Alignof(rg_cross_intent_t));
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+    status = rg_scratch_reserve(
+        world,
+        (void**)&world->scratch_intent_sort,
+        &world->scratch_intent_sort_capacity,
+        total_intents * 2u,
+        sizeof(*world->scratch_intent_sort),
+        _Alignof(rg_intent_sort_entry_t));
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+    bucket_count = (total_intents < world->chunk_count) ? total_intents : world->chunk_count;
+    status = rg_scratch_reserve(
+        world,
+        (void**)&world->scratch_intent_buckets,
+        &world->scratch_intent_bucket_capacity,
+        bucket_count * 2u,
+        sizeof(*world->scratch_intent_buckets),
+        _Alignof(rg_intent_bucket_t));
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+    merged = world->scratch_merged;
+
+    write_cursor = 0u;
+    for (i = 0u; i < output_count; ++i) {
+        if (outputs[i].intent_count == 0u) {
+            continue;
+        }
+        memcpy(
+            &merged[write_cursor],
+            outputs[i].intents,
+            (size_t)outputs[i].intent_count * sizeof(*merged));
+        write_cursor += outputs[i].intent_count;
+    }
+
+    cell_id_count = (uint64_t)world->chunk_count * (uint64_t)world->cells_per_chunk;
+    cell_id_bits = 1u;
+    while (cell_id_bits < 32u && (UINT64_C(1) << cell_id_bits) < cell_id_count) {
+        cell_id_bits += 1u;
+    }
+
+    sorted = world->scratch_intent_sort;
+    if ((UINT64_C(1) << cell_id_bits) >= cell_id_count) {
+        for (i = 0u; i < total_intents; ++i) {
+            uint64_t target_id;
+            uint64_t source_id;
+
+            target_id = (uint64_t)merged[i].target_chunk_index * world->cells_per_chunk +
+                        merged[i].target_cell_index;
+            source_id = (uint64_t)merged[i].source_chunk_index * world->cells_per_chunk +
+                        merged[i].source_cell_index;
+            sorted[i].key = (target_id << cell_id_bits) | source_id;
+            sorted[i].intent_index = i;
+            sorted[i].applied = 0u;
+        }
+        sorted = rg_radix_sort_intents(
+            sorted,
+            world->scratch_intent_sort + world->scratch_intent_sort_capacity / 2u,
+            total_intents,
+            cell_id_bits * 2u);
+    } else {
+        qsort(merged, (size_t)total_intents, sizeof(*merged), rg_intent_compare_by_target);
+        for (i = 0u; i < total_intents; ++i) {
+            sorted[i].key = 0u;
+            sorted[i].intent_index = i;
+            sorted[i].applied = 0u;
+        }
+    }
+
+    /* Sorted entries split into per-target-chunk buckets, counted by color. */
+    buckets = world->scratch_intent_buckets;
+    memset(color_offsets, 0, sizeof(color_offsets));
+    bucket_count = 0u;
+    for (i = 0u; i < total_intents; ++i) {
+        const rg_cross_intent_t* intent;
+        const rg_cross_intent_t* previous;
+        const rg_chunk_entry_t* target_entry;
+
+        intent = &merged[sorted[i].intent_index];
+        previous = (i > 0u) ? &merged[sorted[i - 1u].intent_index] : NULL;
+        if (previous != NULL && previous->target_chunk_index == intent->target_chunk_index) {
+            if (previous->target_cell_index == intent->target_cell_index) {
+                world->intent_conflicts_last_step += 1u;
+            }
+            buckets[bucket_count - 1u].end = i + 1u;
+            continue;
+        }
+
+        target_entry = &world->chunks[intent->target_chunk_index];
+        buckets[bucket_count].begin = i;
+        buckets[bucket_count].end = i + 1u;
+        bucket_count += 1u;
+        color_offsets[1u + (((uint32_t)target_entry->chunk_x & 1u) |
+                            (((uint32_t)target_entry->chunk_y & 1u) << 1u))] += 1u;
+    }
+    for (color = 1u; color < 5u; ++color) {
+        color_offsets[color] += color_offsets[color - 1u];
+    }
+
+    color_buckets = world->scratch_intent_buckets + world->scratch_intent_bucket_capacity / 2u;
+    {
+        uint32_t cursors[4];
+
+        memcpy(cursors, color_offsets, sizeof(cursors));
+        for (i = 0u; i < bucket_count; ++i) {
+            const rg_chunk_entry_t* target_entry;
+
+            target_entry = &world->chunks[merged[sorted[buckets[i].begin].intent_index].target_chunk_index];
+            color = ((uint32_t)target_entry->chunk_x & 1u) | (((uint32_t)target_entry->chunk_y & 1u) << 1u);
+            color_buckets[cursors[color]] = buckets[i];
+            cursors[color] += 1u;
+        }
+    }
+
+    memset(&apply_ctx, 0, sizeof(apply_ctx));
+    apply_ctx.world = world;
+    apply_ctx.merged = merged;
+    apply_ctx.sorted = sorted;
+
+    round_count = 0u;
+    for (color = 0u; color < 4u; ++color) {
+        round_count += (uint32_t)(color_offsets[color + 1u] > color_offsets[color]);
+    }
+    if (round_count > 1u && rg_has_graph_runner(world) != 0u && world->chunk_width >= 2 &&
+        world->chunk_height >= 2) {
+        apply_ctx.buckets = color_buckets;
+        apply_ctx.bucket_count = bucket_count;
+        apply_ctx.color_offsets = color_offsets;
+        status = rg_apply_intent_graph(world, &apply_ctx);
+        rg_fold_applied_intents(world, &apply_ctx);
+        return status;
+    }
+
+    for (color = 0u; color < 4u; ++color) {
+        apply_ctx.buckets = &color_buckets[color_offsets[color]];
+        apply_ctx.bucket_count = color_offsets[color + 1u] - color_offsets[color];
+        if (apply_ctx.bucket_count == 0u) {
+            continue;
+        }
+
+        if (apply_ctx.bucket_count > 1u && rg_has_parallel_runner(world) != 0u) {
+            status = world->runner->vtable->parallel_for(
+                world->runner->user,
+                apply_ctx.bucket_count,
+                rg_intent_apply_task_callback,
+                &apply_ctx);
+        } else {
+            for (i = 0u; i < apply_ctx.bucket_count; ++i) {
+                rg_intent_apply_task_callback(i, 0u, &apply_ctx);
+            }
+        }
+
+        rg_fold_applied_intents(world, &apply_ctx);
+        if (status != RG_STATUS_OK) {
+            return status;
+        }
+    }
+
+    return RG_STATUS_OK;
+}
+
+/*
+ * Atomic and halo modes: commits a move or swap into a neighbor chunk in place.
+ * The neighbor's owner is idle during the phase, so the only other writers are
+ * same-color chunks bordering it from the other side. With chunks at least 2x2
+ * they reach disjoint cells, but they share update-mask bytes. Atomic mode
+ * claims the target cell with a compare-and-swap on its material id and sets
+ * its mask bit with an atomic or; the mask was cleared for this tick before the
+ * phase. Halo mode stores plainly and lists the cell in the task output, so its
+ * mask bit is set after the barrier.
+ */
+static uint8_t rg_commit_remote_move(
+    rg_world_t* world,
+    rg_task_output_t* task_output,
+    const rg_chunk_entry_t* source_entry,
+    uint32_t source_index,
+    rg_material_id_t source_material_id,
+    const rg_material_record_t* source_material,
+    const rg_chunk_entry_t* target_entry,
+    uint32_t target_index,
+    rg_material_id_t target_material_id)
+{
+    rg_chunk_t* source_chunk;
+    rg_chunk_t* target_chunk;
+    uint32_t dir;
+
+    source_chunk = source_entry->chunk;
+    target_chunk = target_entry->chunk;
+    dir = rg_dir_from_offset(target_entry->chunk_x - source_entry->chunk_x, target_entry->chunk_y - source_entry->chunk_y);
+    if (dir >= RG_DIR_COUNT) {
+        return 0u;
+    }
+
+    if (task_output->remote_commit == (uint8_t)RG_REMOTE_COMMIT_HALO) {
+        rg_cross_intent_t written;
+
+        written.source_chunk_index = source_chunk->entry_index;
+        written.target_chunk_index = target_chunk->entry_index;
+        written.source_cell_index = source_index;
+        written.target_cell_index = target_index;
+        written.source_material_id = source_material_id;
+        written.target_material_id = target_material_id;
+        if (rg_task_output_push_intent(task_output, &written) == 0u) {
+            return 0u;
+        }
+        target_chunk->material_ids[target_index] = source_material_id;
+    } else {
+#if RG_HAVE_ATOMICS
+        rg_material_id_t expected;
+
+        expected = target_material_id;
+        if (!atomic_compare_exchange_strong_explicit(
+                (_Atomic rg_material_id_t*)&target_chunk->material_ids[target_index],
+                &expected,
+                source_material_id,
+                memory_order_relaxed,
+                memory_order_relaxed)) {
+            return 0u;
+        }
+        (void)atomic_fetch_or_explicit(
+            (_Atomic uint8_t*)&target_chunk->updated_mask[target_index >> 3u],
+            (uint8_t)(1u << (target_index & 7u)),
+            memory_order_relaxed);
+#else
+        return 0u;
+#endif
+    }
+    source_chunk->material_ids[source_index] = target_material_id;
+
+    if (target_material_id == 0u) {
+        rg_payload_move(world, source_chunk, source_index, target_chunk, target_index, source_material);
+        if (source_chunk->live_cells > 0u) {
+            source_chunk->live_cells -= 1u;
+        }
+        task_output->neighbor_live_delta[dir] += 1;
+    } else {
+        rg_payload_swap(world, source_chunk, source_index, target_chunk, target_index);
+    }
+
+    task_output->neighbor_touched = (uint8_t)(task_output->neighbor_touched | (1u << dir));
+    task_output->neighbor_border_dirty[dir] =
+        (uint8_t)(task_output->neighbor_border_dirty[dir] | world->cell_border_bits[target_index]);
+
+    rg_chunk_note_activity(world, source_chunk, task_output);
+    rg_chunk_mark_border_for_mode(world, source_chunk, source_index, task_output);
+    task_output->emitted_move_count += 1u;
+    return 1u;
+}
+
+static uint8_t rg_attempt_move(
+    rg_world_t* world,
+    uint32_t source_chunk_index,
+    rg_chunk_entry_t* source_entry,
+    int32_t source_local_x,
+    int32_t source_local_y,
+    uint32_t source_index,
+    rg_material_id_t source_material_id,
+    const rg_material_record_t* source_material,
+    int32_t dx,
+    int32_t dy,
+    uint8_t allow_lateral_displace,
+    uint8_t emit_cross_intents,
+    rg_task_output_t* task_output)
+{
+    rg_status_t status;
+    rg_chunk_entry_t* target_entry;
+    uint32_t target_chunk_index;
+    int32_t target_local_x;
+    int32_t target_local_y;
+    uint32_t target_index;
+    rg_chunk_t* source_chunk;
+    rg_chunk_t* target_chunk;
+    rg_material_id_t target_material_id;
+    const rg_material_record_t* target_material;
+
+    if (world == NULL || source_entry == NULL || source_material == NULL || source_material_id == 0u) {
+        return 0u;
+    }
+
+    status = rg_resolve_target(
+        world,
+        source_entry,
+        source_local_x,
+        source_local_y,
+        dx,
+        dy,
+        &target_entry,
+        &target_chunk_index,
+        &target_index,
+        &target_local_x,
+        &target_local_y);
+    if (status != RG_STATUS_OK) {
+        return 0u;
+    }
+
+    source_chunk = source_entry->chunk;
+    target_chunk = target_entry->chunk;
+    if (source_chunk == NULL || target_chunk == NULL) {
+        return 0u;
+    }
+
+    target_material_id = target_chunk->material_ids[target_index];
+    if (target_material_id != 0u) {
+        target_material = rg_material_get(world, target_material_id);
+        if (target_material == NULL) {
+            return 0u;
+        }
+        if (rg_can_displace(source_material, target_material, dy, allow_lateral_displace) == 0u) {
+            return 0u;
+        }
+
+        if (emit_cross_intents != 0u &&
+            rg_target_is_remote(world, task_output, source_entry, target_entry, target_local_x, target_local_y) != 0u) {
+            rg_cross_intent_t intent;
+
+            if (task_output == NULL) {
+                return 0u;
+            }
+            if (task_output->remote_commit != (uint8_t)RG_REMOTE_COMMIT_INTENTS) {
+                return rg_commit_remote_move(
+                    world,
+                    task_output,
+                    source_entry,
+                    source_index,
+                    source_material_id,
+                    source_material,
+                    target_entry,
+                    target_index,
+                    target_material_id);
+            }
+
+            intent.source_chunk_index = source_chunk_index;
+            intent.target_chunk_index = target_chunk_index;
+            intent.source_cell_index = source_index;
+            intent.target_cell_index = target_index;
+            intent.source_material_id = source_material_id;
+            intent.target_material_id = target_material_id;
+            if (rg_task_output_push_intent(task_output, &intent) == 0u) {
+                return 0u;
+            }
+            task_output->emitted_move_count += 1u;
+            return 1u;
+        }
+
+        target_chunk->material_ids[target_index] = source_material_id;
+        source_chunk->material_ids[source_index] = target_material_id;
+        rg_payload_swap(world, source_chunk, source_index, target_chunk, target_index);
+    } else {
+        if (emit_cross_intents != 0u &&
+            rg_target_is_remote(world, task_output, source_entry, target_entry, target_local_x, target_local_y) != 0u) {
+            rg_cross_intent_t intent;
+
+            if (task_output == NULL) {
+                return 0u;
+            }
+            if (task_output->remote_commit != (uint8_t)RG_REMOTE_COMMIT_INTENTS) {
+                return rg_commit_remote_move(
+                    world,
+                    task_output,
+                    source_entry,
+                    source_index,
+                    source_material_id,
+                    source_material,
+                    target_entry,
+                    target_index,
+                    0u);
+            }
+
+            intent.source_chunk_index = source_chunk_index;
+            intent.target_chunk_index = target_chunk_index;
+            intent.source_cell_index = source_index;
+            intent.target_cell_index = target_index;
+            intent.source_material_id = source_material_id;
+            intent.target_material_id = 0u;
+            if (rg_task_output_push_intent(task_output, &intent) == 0u) {
+                return 0u;
+            }
+            task_output->emitted_move_count += 1u;
+            return 1u;
+        }
+
+        target_chunk->material_ids[target_index] = source_material_id;
+        source_chunk->material_ids[source_index] = 0u;
+        rg_payload_move(world, source_chunk, source_index, target_chunk, target_index, source_material);
+
+        if (source_chunk != target_chunk) {
+            if (source_chunk->live_cells > 0u) {
+                source_chunk->live_cells -= 1u;
+            }
+            target_chunk->live_cells += 1u;
+
+            if (source_chunk->live_cells == 0u) {
+                source_chunk->idle_steps = 0u;
+                rg_chunk_set_awake(world, source_chunk, 0u);
+            }
+        }
+    }
+
+    rg_chunk_note_activity(world, source_chunk, task_output);
+    rg_chunk_note_activity(world, target_chunk, task_output);
+    rg_mask_set(world, target_chunk, target_index);
+    rg_chunk_mark_border_for_mode(world, source_chunk, source_index, task_output);
+    rg_chunk_mark_border_for_mode(world, target_chunk, target_index, task_output);
+    rg_task_output_note_block_move(task_output, source_entry, target_entry);
+
+    if (task_output != NULL) {
+        task_output->emitted_move_count += 1u;
+    } else {
+        world->intents_emitted_last_step += 1u;
+    }
+    return 1u;
+}
+
+#ifndef RG_INTERIOR_FAST_PATH
+#define RG_INTERIOR_FAST_PATH 1
+#endif
+
+/*
+ * Interior kernels: the source cell and every neighbor it may move into live in
+ * the same chunk, so targets are plain offsets into material_ids and the chunk
+ * table is never consulted. Callers must only use these for cells with
+ * 0 < x < chunk_width - 1 and 0 < y < chunk_height - 1.
+ */
+static uint8_t rg_attempt_move_interior(
+    rg_world_t* world,
+    rg_chunk_t* chunk,
+    uint32_t source_index,
+    rg_material_id_t source_material_id,
+    const rg_material_record_t* source_material,
+    int32_t offset,
+    int32_t dy,
+    rg_task_output_t* task_output)
+{
+    uint32_t target_index;
+    rg_material_id_t target_material_id;
+
+    target_index = (uint32_t)((int32_t)source_index + offset);
+    target_material_id = chunk->material_ids[target_index];
+    if (target_material_id != 0u) {
+        const rg_material_record_t* target_material;
+
+        target_material = rg_material_get(world, target_material_id);
+        if (target_material == NULL) {
+            return 0u;
+        }
+        if (rg_can_displace(source_material, target_material, dy, 0u) == 0u) {
+            return 0u;
+        }
+
+        chunk->material_ids[target_index] = source_material_id;
+        chunk->material_ids[source_index] = target_material_id;
+        rg_payload_swap(world, chunk, source_index, chunk, target_index);
+    } else {
+        chunk->material_ids[target_index] = source_material_id;
+        chunk->material_ids[source_index] = 0u;
+        rg_payload_move(world, chunk, source_index, chunk, target_index, source_material);
+    }
+
+    rg_chunk_note_activity(world, chunk, task_output);
+    rg_mask_set(world, chunk, target_index);
+    rg_chunk_mark_border_for_mode(world, chunk, target_index, task_output);
+
+    if (task_output != NULL) {
+        task_output->emitted_move_count += 1u;
+    } else {
+        world->intents_emitted_last_step += 1u;
+    }
+    return 1u;
+}
+
+static uint8_t rg_step_powder_interior(
+    rg_world_t* world,
+    rg_chunk_t* chunk,
+    uint32_t source_index,
+    rg_material_id_t source_material_id,
+    const rg_material_record_t* source_material,
+    uint8_t primary_left,
+    rg_task_output_t* task_output)
+{
+    int32_t below;
+    int32_t first_dx;
+    int32_t second_dx;
+
+    below = world->chunk_width;
+    first_dx = (primary_left != 0u) ? -1 : 1;
+    second_dx = -first_dx;
+
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            below,
+            1,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            below + first_dx,
+            1,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            below + second_dx,
+            1,
+            task_output) != 0u) {
+        return 1u;
+    }
+
+    return 0u;
+}
+
+static uint8_t rg_step_liquid_interior(
+    rg_world_t* world,
+    rg_chunk_t* chunk,
+    uint32_t source_index,
+    rg_material_id_t source_material_id,
+    const rg_material_record_t* source_material,
+    uint8_t primary_left,
+    rg_task_output_t* task_output)
+{
+    int32_t below;
+    int32_t first_dx;
+    int32_t second_dx;
+
+    below = world->chunk_width;
+    first_dx = (primary_left != 0u) ? -1 : 1;
+    second_dx = -first_dx;
+
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            below,
+            1,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            first_dx,
+            0,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            second_dx,
+            0,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            below + first_dx,
+            1,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            below + second_dx,
+            1,
+            task_output) != 0u) {
+        return 1u;
+    }
+
+    return 0u;
+}
+
+static uint8_t rg_step_gas_interior(
+    rg_world_t* world,
+    rg_chunk_t* chunk,
+    uint32_t source_index,
+    rg_material_id_t source_material_id,
+    const rg_material_record_t* source_material,
+    uint8_t primary_left,
+    rg_task_output_t* task_output)
+{
+    int32_t above;
+    int32_t first_dx;
+    int32_t second_dx;
+
+    above = -world->chunk_width;
+    first_dx = (primary_left != 0u) ? -1 : 1;
+    second_dx = -first_dx;
+
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            above,
+            -1,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            first_dx,
+            0,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            second_dx,
+            0,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            above + first_dx,
+            -1,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move_interior(
+            world,
+            chunk,
+            source_index,
+            source_material_id,
+            source_material,
+            above + second_dx,
+            -1,
+            task_output) != 0u) {
+        return 1u;
+    }
+
+    return 0u;
+}
+
+static uint8_t rg_step_powder(
+    rg_world_t* world,
+    uint32_t source_chunk_index,
+    rg_chunk_entry_t* source_entry,
+    int32_t source_local_x,
+    int32_t source_local_y,
+    uint32_t source_index,
+    rg_material_id_t source_material_id,
+    const rg_material_record_t* source_material,
+    uint8_t primary_left,
+    uint8_t emit_cross_intents,
+    rg_task_output_t* task_output)
+{
+    int32_t first_dx;
+    int32_t second_dx;
+
+    first_dx = (primary_left != 0u) ? -1 : 1;
+    second_dx = -first_dx;
+
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            0,
+            1,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            first_dx,
+            1,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            second_dx,
+            1,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+
+    return 0u;
+}
+
+static uint8_t rg_step_liquid(
+    rg_world_t* world,
+    uint32_t source_chunk_index,
+    rg_chunk_entry_t* source_entry,
+    int32_t source_local_x,
+    int32_t source_local_y,
+    uint32_t source_index,
+    rg_material_id_t source_material_id,
+    const rg_material_record_t* source_material,
+    uint8_t primary_left,
+    uint8_t emit_cross_intents,
+    rg_task_output_t* task_output)
+{
+    int32_t first_dx;
+    int32_t second_dx;
+
+    first_dx = (primary_left != 0u) ? -1 : 1;
+    second_dx = -first_dx;
+
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            0,
+            1,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            first_dx,
+            0,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            second_dx,
+            0,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            first_dx,
+            1,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            second_dx,
+            1,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+
+    return 0u;
+}
+
+static uint8_t rg_step_gas(
+    rg_world_t* world,
+    uint32_t source_chunk_index,
+    rg_chunk_entry_t* source_entry,
+    int32_t source_local_x,
+    int32_t source_local_y,
+    uint32_t source_index,
+    rg_material_id_t source_material_id,
+    const rg_material_record_t* source_material,
+    uint8_t primary_left,
+    uint8_t emit_cross_intents,
+    rg_task_output_t* task_output)
+{
+    int32_t first_dx;
+    int32_t second_dx;
 
     first_dx = (primary_left != 0u) ? -1 : 1;
     second_dx = -first_dx;
 
-    if (rg_attempt_move(
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            0,
+            -1,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            first_dx,
+            0,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            second_dx,
+            0,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            first_dx,
+            -1,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+    if (rg_attempt_move(
+            world,
+            source_chunk_index,
+            source_entry,
+            source_local_x,
+            source_local_y,
+            source_index,
+            source_material_id,
+            source_material,
+            second_dx,
+            -1,
+            0u,
+            emit_cross_intents,
+            task_output) != 0u) {
+        return 1u;
+    }
+
+    return 0u;
+}
+
+/*
+ * Steps the cells of [x0, x1) x [y0, y1) in one chunk: rows bottom-up, each row
+ * in a per-row random direction. The interior kernels are only used for cells
+ * whose whole neighborhood is inside the rectangle.
+ */
+static uint8_t rg_step_cells(
+    rg_world_t* world,
+    uint32_t source_chunk_index,
+    rg_chunk_entry_t* entry,
+    uint64_t tick,
+    int32_t x0,
+    int32_t y0,
+    int32_t x1,
+    int32_t y1,
+    uint8_t emit_cross_intents,
+    rg_task_output_t* task_output)
+{
+    rg_chunk_t* chunk;
+    rg_random_stream_t row_direction_bits;
+    rg_random_stream_t lateral_bits;
+    int32_t y;
+    uint8_t changed;
+
+    chunk = entry->chunk;
+    changed = 0u;
+    rg_random_stream_init(&row_direction_bits, world, tick, entry->chunk_x, entry->chunk_y, 0x71u);
+    rg_random_stream_init(&lateral_bits, world, tick, entry->chunk_x, entry->chunk_y, 0xabu);
+
+    for (y = y1 - 1; y >= y0; --y) {
+        int32_t x_step;
+        uint8_t left_to_right;
+        uint8_t row_interior;
+
+        left_to_right = rg_random_stream_bit(&row_direction_bits, (uint32_t)y);
+        row_interior = (uint8_t)(RG_INTERIOR_FAST_PATH != 0 && y > y0 && y < y1 - 1);
+        for (x_step = x0; x_step < x1; ++x_step) {
+            int32_t x;
+            uint32_t index;
+            rg_material_id_t material_id;
+            const rg_material_record_t* material;
+            uint8_t primary_left;
+            uint8_t moved;
+
+            x = (left_to_right != 0u) ? x_step : (x0 + x1 - 1 - x_step);
+            index = ((uint32_t)y * (uint32_t)world->chunk_width) + (uint32_t)x;
+
+            if (rg_mask_test(world, chunk, index) != 0u) {
+                continue;
+            }
+
+            material_id = chunk->material_ids[index];
+            if (material_id == 0u) {
+                continue;
+            }
+
+            material = rg_material_get(world, material_id);
+            if (material == NULL) {
+                continue;
+            }
+            if ((material->flags & RG_MATERIAL_STATIC) != 0u) {
+                continue;
+            }
+
+            primary_left = rg_random_stream_bit(&lateral_bits, index);
+            moved = 0u;
+            if (material->update_fn != NULL) {
+                rg_update_ctx_t update_ctx;
+                void* instance_data;
+
+                memset(&update_ctx, 0, sizeof(update_ctx));
+                update_ctx.world = world;
+                update_ctx.tick = tick;
+                update_ctx.source_chunk_index = source_chunk_index;
+                update_ctx.source_entry = entry;
+                update_ctx.source_local_x = x;
+                update_ctx.source_local_y = y;
+                update_ctx.source_cell_index = index;
+                update_ctx.source_cell.x = (entry->chunk_x * world->chunk_width) + x;
+                update_ctx.source_cell.y = (entry->chunk_y * world->chunk_height) + y;
+                update_ctx.emit_cross_intents = emit_cross_intents;
+                update_ctx.task_output = task_output;
+
+                instance_data = NULL;
+                if (material->instance_size > 0u) {
+                    instance_data = rg_chunk_instance_ptr(world, chunk, index, material);
+                }
+
+                material->update_fn(
+                    &update_ctx,
+                    update_ctx.source_cell,
+                    material_id,
+                    instance_data,
+                    material->user_data);
+
+                moved = update_ctx.changed;
+            } else if (row_interior != 0u && x > x0 && x < x1 - 1) {
+                if ((material->flags & RG_MATERIAL_GAS) != 0u) {
+                    moved = rg_step_gas_interior(
+                        world,
+                        chunk,
+                        index,
+                        material_id,
+                        material,
+                        primary_left,
+                        task_output);
+                } else if ((material->flags & RG_MATERIAL_LIQUID) != 0u) {
+                    moved = rg_step_liquid_interior(
+                        world,
+                        chunk,
+                        index,
+                        material_id,
+                        material,
+                        primary_left,
+                        task_output);
+                } else if ((material->flags & RG_MATERIAL_POWDER) != 0u) {
+                    moved = rg_step_powder_interior(
+                        world,
+                        chunk,
+                        index,
+                        material_id,
+                        material,
+                        primary_left,
+                        task_output);
+                }
+            } else if ((material->flags & RG_MATERIAL_GAS) != 0u) {
+                moved = rg_step_gas(
+                    world,
+                    source_chunk_index,
+                    entry,
+                    x,
+                    y,
+                    index,
+                    material_id,
+                    material,
+                    primary_left,
+                    emit_cross_intents,
+                    task_output);
+            } else if ((material->flags & RG_MATERIAL_LIQUID) != 0u) {
+                moved = rg_step_liquid(
+                    world,
+                    source_chunk_index,
+                    entry,
+                    x,
+                    y,
+                    index,
+                    material_id,
+                    material,
+                    primary_left,
+                    emit_cross_intents,
+                    task_output);
+            } else if ((material->flags & RG_MATERIAL_POWDER) != 0u) {
+                moved = rg_step_powder(
+                    world,
+                    source_chunk_index,
+                    entry,
+                    x,
+                    y,
+                    index,
+                    material_id,
+                    material,
+                    primary_left,
+                    emit_cross_intents,
+                    task_output);
+            }
+
+            if (moved != 0u) {
+                changed = 1u;
+            }
+        }
+    }
+
+    return changed;
+}
+
+/* End-of-step idle/sleep bookkeeping for a chunk that was stepped this tick. */
+static void rg_chunk_finish_step(
+    rg_world_t* world,
+    rg_chunk_t* chunk,
+    uint8_t changed,
+    rg_task_output_t* task_output)
+{
+    if (chunk->live_cells == 0u) {
+        chunk->idle_steps = 0u;
+        rg_set_chunk_awake_for_mode(world, chunk, 0u, task_output);
+    } else if (changed != 0u) {
+        chunk->idle_steps = 0u;
+        rg_set_chunk_awake_for_mode(world, chunk, 1u, task_output);
+    } else {
+        if (chunk->idle_steps < UINT32_MAX) {
+            chunk->idle_steps += 1u;
+        }
+        if (chunk->idle_steps >= chunk->sleep_ticks) {
+            rg_set_chunk_awake_for_mode(world, chunk, 0u, task_output);
+        }
+    }
+}
+
+static uint8_t rg_step_chunk_serial(
+    rg_world_t* world,
+    uint32_t source_chunk_index,
+    uint64_t tick,
+    uint8_t emit_cross_intents,
+    rg_task_output_t* task_output)
+{
+    rg_chunk_entry_t* entry;
+    rg_chunk_t* chunk;
+    uint8_t changed;
+
+    if (world == NULL || source_chunk_index >= world->chunk_count) {
+        return 0u;
+    }
+
+    entry = &world->chunks[source_chunk_index];
+    if (entry->chunk == NULL) {
+        return 0u;
+    }
+
+    chunk = entry->chunk;
+    chunk->deferred_age = 0u;
+    if (chunk->live_cells == 0u) {
+        chunk->idle_steps = 0u;
+        rg_chunk_set_awake(world, chunk, 0u);
+        return 0u;
+    }
+
+    changed = rg_step_cells(
+        world,
+        source_chunk_index,
+        entry,
+        tick,
+        0,
+        0,
+        world->chunk_width,
+        world->chunk_height,
+        emit_cross_intents,
+        task_output);
+
+    if (emit_cross_intents != 0u && task_output != NULL && task_output->intent_count > 0u) {
+        changed = 1u;
+    }
+
+    rg_chunk_finish_step(world, chunk, changed, task_output);
+    if (task_output != NULL) {
+        task_output->changed = changed;
+    }
+    return changed;
+}
+
+static rg_status_t rg_step_full_scan_serial(rg_world_t* world, uint64_t tick)
+{
+    uint32_t i;
+    uint64_t simulate_start_ns;
+
+    if (world == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+
+    simulate_start_ns = rg_default_clock_now_ns(NULL);
+    for (i = 0u; i < world->chunk_count; ++i) {
+        if (rg_chunk_due(&world->chunks[i], tick) == 0u) {
+            world->lod_skipped_chunks_last_step += 1u;
+            continue;
+        }
+        (void)rg_step_chunk_serial(world, i, tick, 0u, NULL);
+    }
+    world->step_simulate_ns_last_step += rg_elapsed_ns(simulate_start_ns, rg_default_clock_now_ns(NULL));
+
+    return RG_STATUS_OK;
+}
+
+static rg_status_t rg_step_chunk_scan_serial(rg_world_t* world, uint64_t tick)
+{
+    uint32_t* chunk_indices;
+    uint32_t chunk_count;
+    uint32_t i;
+    uint64_t setup_start_ns;
+    uint64_t simulate_start_ns;
+    rg_status_t status;
+
+    if (world == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (world->active_chunk_count == 0u) {
+        return RG_STATUS_OK;
+    }
+
+    setup_start_ns = rg_default_clock_now_ns(NULL);
+    status = rg_scratch_reserve_chunk_indices(world, world->active_chunk_count);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+    chunk_indices = world->scratch_chunk_indices;
+    chunk_count = rg_snapshot_active_chunks(world, 0u, 4u, chunk_indices);
+    simulate_start_ns = rg_default_clock_now_ns(NULL);
+    world->step_setup_ns_last_step += rg_elapsed_ns(setup_start_ns, simulate_start_ns);
+
+    /*
+     * Chunks woken during the pass step from the next pass on. Whatever woke them
+     * is already stamped for this tick, so a same-pass step would only count idle.
+     */
+    for (i = 0u; i < chunk_count; ++i) {
+        rg_chunk_t* chunk;
+
+        chunk = world->chunks[chunk_indices[i]].chunk;
+        if (chunk == NULL || chunk->awake == 0u) {
+            continue;
+        }
+        if (rg_chunk_due(&world->chunks[chunk_indices[i]], tick) == 0u) {
+            world->lod_skipped_chunks_last_step += 1u;
+            continue;
+        }
+        (void)rg_step_chunk_serial(world, chunk_indices[i], tick, 0u, NULL);
+    }
+
+    world->step_simulate_ns_last_step += rg_elapsed_ns(simulate_start_ns, rg_default_clock_now_ns(NULL));
+    return RG_STATUS_OK;
+}
+
+static void rg_task_output_fold_counters(rg_world_t* world, const rg_task_output_t* output)
+{
+    if (output->live_cell_delta < 0 && (uint64_t)(-output->live_cell_delta) > world->live_cells) {
+        world->live_cells = 0u;
+    } else {
+        world->live_cells = (uint64_t)((int64_t)world->live_cells + output->live_cell_delta);
+    }
+    world->payload_overflow_allocs += output->payload_overflow_allocs;
+    world->payload_overflow_frees += output->payload_overflow_frees;
+}
+
+static void rg_checkerboard_step_position(const rg_checkerboard_task_ctx_t* ctx, uint32_t position)
+{
+    if (ctx->budget != NULL &&
+        (position > 0u || ctx->budget->run_first == 0u) &&
+        ctx->budget->clock_now_ns(ctx->budget->clock_user) >= ctx->budget->deadline_ns) {
+        ctx->outputs[position].skipped = 1u;
+        return;
+    }
+
+    (void)rg_step_chunk_serial(
+        ctx->world,
+        ctx->chunk_indices[position],
+        ctx->tick,
+        1u,
+        &ctx->outputs[position]);
+}
+
+static void rg_checkerboard_task_callback(uint32_t task_index, uint32_t worker_index, void* user_data)
+{
+    rg_checkerboard_task_ctx_t* ctx;
+    uint32_t position;
+    uint32_t block;
+
+    (void)worker_index;
+
+    ctx = (rg_checkerboard_task_ctx_t*)user_data;
+    if (ctx == NULL || task_index >= ctx->task_count || ctx->outputs == NULL) {
+        return;
+    }
+
+    if (ctx->block_offsets == NULL) {
+        /* Strided so a task's chunks spread over the cost order instead of clumping. */
+        for (position = task_index; position < ctx->chunk_count; position += ctx->task_count) {
+            rg_checkerboard_step_position(ctx, position);
+        }
+        return;
+    }
+
+    /* A block's chunks run in table order on one task, which owns all of them. */
+    for (block = task_index; block < ctx->block_count; block += ctx->task_count) {
+        for (position = ctx->block_offsets[block]; position < ctx->block_offsets[block + 1u]; ++position) {
+            rg_checkerboard_step_position(ctx, position);
+        }
+    }
+}
+
+/*
+ * Reorders a phase's chunks heaviest first (live cells, ties by chunk index) so
+ * runners that hand out tasks in index order start the expensive chunks early
+ * and finish on cheap ones. Results do not depend on the order: outputs are
+ * per chunk and intents are merged in a canonical order.
+ */
+static rg_status_t rg_sort_tasks_by_cost(rg_world_t* world, uint32_t* chunk_indices, uint32_t chunk_count)
+{
+    uint64_t* keys;
+    uint32_t i;
+    rg_status_t status;
+
+    status = rg_scratch_reserve(
+        world,
+        (void**)&world->scratch_cost_keys,
+        &world->scratch_cost_key_capacity,
+        chunk_count,
+        sizeof(*world->scratch_cost_keys),
+        _Alignof(uint64_t));
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+
+    keys = world->scratch_cost_keys;
+    for (i = 0u; i < chunk_count; ++i) {
+        uint32_t live_cells;
+
+        live_cells = world->chunks[chunk_indices[i]].chunk->live_cells;
+        keys[i] = ((uint64_t)(UINT32_MAX - live_cells) << 32u) | (uint64_t)chunk_indices[i];
+    }
+    qsort(keys, (size_t)chunk_count, sizeof(*keys), rg_u64_compare);
+    for (i = 0u; i < chunk_count; ++i) {
+        chunk_indices[i] = (uint32_t)(keys[i] & UINT32_MAX);
+    }
+    return RG_STATUS_OK;
+}
+
+/*
+ * Block tasks: orders a phase's chunks by block, table order within a block,
+ * and records the block ranges in scratch_block_offsets. Block coordinates are
+ * keyed by their low 16 bits; blocks that alias share a task, which only
+ * serializes them.
+ */
+static rg_status_t rg_group_chunks_by_block(
+    rg_world_t* world,
+    uint32_t* chunk_indices,
+    uint32_t chunk_count,
+    uint32_t* out_block_count)
+{
+    uint64_t* keys;
+    uint32_t* offsets;
+    uint32_t block_count;
+    uint32_t i;
+    rg_status_t status;
+
+    status = rg_scratch_reserve(
+        world,
+        (void**)&world->scratch_cost_keys,
+        &world->scratch_cost_key_capacity,
+        chunk_count,
+        sizeof(*world->scratch_cost_keys),
+        _Alignof(uint64_t));
+    if (status == RG_STATUS_OK) {
+        status = rg_scratch_reserve(
+            world,
+            (void**)&world->scratch_block_offsets,
+            &world->scratch_block_offset_capacity,
+            chunk_count + 1u,
+            sizeof(*world->scratch_block_offsets),
+            _Alignof(uint32_t));
+    }
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+
+    keys = world->scratch_cost_keys;
+    for (i = 0u; i < chunk_count; ++i) {
+        const rg_chunk_entry_t* entry;
+        int32_t block_x;
+        int32_t block_y;
+        uint32_t block_key;
+
+        entry = &world->chunks[chunk_indices[i]];
+        rg_split_coord(entry->chunk_x, world->checkerboard_block, &block_x, NULL);
+        rg_split_coord(entry->chunk_y, world->checkerboard_block, &block_y, NULL);
+        block_key = (((uint32_t)block_y & 0xFFFFu) << 16u) | ((uint32_t)block_x & 0xFFFFu);
+        keys[i] = ((uint64_t)block_key << 32u) | (uint64_t)chunk_indices[i];
+    }
+    qsort(keys, (size_t)chunk_count, sizeof(*keys), rg_u64_compare);
+
+    offsets = world->scratch_block_offsets;
+    block_count = 0u;
+    for (i = 0u; i < chunk_count; ++i) {
+        if (i == 0u || (keys[i] >> 32u) != (keys[i - 1u] >> 32u)) {
+            offsets[block_count] = i;
+            block_count += 1u;
+        }
+        chunk_indices[i] = (uint32_t)(keys[i] & UINT32_MAX);
+    }
+    offsets[block_count] = chunk_count;
+    *out_block_count = block_count;
+    return RG_STATUS_OK;
+}
+
+/*
+ * Sets up one checkerboard phase over chunk_indices (all of one color): resets
+ * and binds the task outputs and fills ctx for rg_checkerboard_task_callback.
+ * With a budget, tasks past the deadline are skipped. remote_commit selects
+ * whether tasks emit intents for moves into neighbor chunks or commit them in
+ * place (atomic or halo mode). On success the world is left in deferred active-list mode until
+ * rg_finish_checkerboard_phase.
+ */
+static rg_status_t rg_prepare_checkerboard_phase(
+    rg_world_t* world,
+    uint64_t tick,
+    uint32_t* chunk_indices,
+    uint32_t task_count,
+    const rg_step_budget_t* budget,
+    rg_remote_commit_t remote_commit,
+    rg_checkerboard_task_ctx_t* ctx)
+{
+    rg_task_output_t* outputs;
+    uint32_t block_count;
+    uint32_t i;
+    uint64_t setup_start_ns;
+    rg_status_t status;
+
+    setup_start_ns = rg_default_clock_now_ns(NULL);
+    block_count = 0u;
+    status = rg_scratch_reserve_outputs(world, task_count);
+    if (status == RG_STATUS_OK && world->checkerboard_block > 1) {
+        status = rg_group_chunks_by_block(world, chunk_indices, task_count, &block_count);
+    }
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+    outputs = world->scratch_outputs;
+    for (i = 0u; i < task_count; ++i) {
+        rg_task_output_reset(&outputs[i]);
+        outputs[i].remote_commit = (uint8_t)remote_commit;
+    }
+    if (remote_commit == RG_REMOTE_COMMIT_ATOMIC) {
+        /* Remote writers only set mask bits, so neighbor masks are cleared for this tick up front. */
+        for (i = 0u; i < task_count; ++i) {
+            rg_chunk_t* chunk;
+            uint32_t dir;
+
+            chunk = world->chunks[chunk_indices[i]].chunk;
+            for (dir = 0u; dir < RG_DIR_COUNT; ++dir) {
+                if (chunk->neighbors[dir] != NULL) {
+                    rg_mask_prepare(world, chunk->neighbors[dir]);
+                }
+            }
+        }
+    } else {
+        /* Intents, or in halo mode the neighbor cells written; either way at most one per rim cell. */
+        status = rg_scratch_bind_intents(
+            world,
+            outputs,
+            task_count,
+            rg_rect_perimeter_cells(world->chunk_width, world->chunk_height));
+        if (status != RG_STATUS_OK) {
+            return status;
+        }
+    }
+
+    memset(ctx, 0, sizeof(*ctx));
+    ctx->world = world;
+    ctx->tick = tick;
+    ctx->chunk_indices = chunk_indices;
+    ctx->chunk_count = task_count;
+    ctx->task_count = (task_count + world->checkerboard_grain - 1u) / world->checkerboard_grain;
+    if (world->checkerboard_block > 1) {
+        ctx->block_offsets = world->scratch_block_offsets;
+        ctx->block_count = block_count;
+        ctx->task_count = (block_count + world->checkerboard_grain - 1u) / world->checkerboard_grain;
+    }
+    ctx->outputs = outputs;
+    ctx->budget = budget;
+    ctx->remote_commit = remote_commit;
+
+    ctx->simulate_start_ns = rg_default_clock_now_ns(NULL);
+    world->step_setup_ns_last_step += rg_elapsed_ns(setup_start_ns, ctx->simulate_start_ns);
+    world->active_sync_deferred = 1u;
+    return RG_STATUS_OK;
+}
+
+/*
+ * Closes a phase after its tasks ran (dispatch_status is what the runner
+ * reported): folds outputs into chunks and world, applies neighbor bookkeeping
+ * of in-place commits and merges intents. Skipped chunks get their deferred age bumped
+ * and are counted in out_skipped.
+ */
+static rg_status_t rg_finish_checkerboard_phase(
+    rg_world_t* world,
+    const rg_checkerboard_task_ctx_t* ctx,
+    rg_status_t dispatch_status,
+    uint32_t* out_skipped)
+{
+    const uint32_t* chunk_indices;
+    rg_task_output_t* outputs;
+    uint32_t task_count;
+    uint32_t skipped;
+    uint32_t i;
+    rg_status_t status;
+
+    world->active_sync_deferred = 0u;
+    chunk_indices = ctx->chunk_indices;
+    outputs = ctx->outputs;
+    task_count = ctx->chunk_count;
+    skipped = 0u;
+    status = dispatch_status;
+
+    /*
+     * Reconcile the stepped chunks first; chunks a task committed into in place
+     * (neighbors in atomic and halo modes, block mates with checkerboard_block)
+     * are marked in neighbor_touched and synced below. Border wake-ups were
+     * recorded during the phase and land here.
+     */
+    for (i = 0u; i < task_count; ++i) {
+        rg_chunk_t* chunk;
+
+        chunk = world->chunks[chunk_indices[i]].chunk;
+        if (outputs[i].skipped != 0u) {
+            chunk->deferred_age += 1u;
+            skipped += 1u;
+        }
+        rg_task_output_fold_counters(world, &outputs[i]);
+        rg_chunk_sync_active(world, chunk);
+        rg_chunk_flush_border(world, chunk);
+    }
+    for (i = 0u; i < task_count; ++i) {
+        rg_chunk_t* chunk;
+        uint32_t dir;
+        uint32_t written;
+
+        chunk = world->chunks[chunk_indices[i]].chunk;
+        for (written = 0u; written < outputs[i].intent_count && ctx->remote_commit == RG_REMOTE_COMMIT_HALO; ++written) {
+            rg_mask_set(
+                world,
+                world->chunks[outputs[i].intents[written].target_chunk_index].chunk,
+                outputs[i].intents[written].target_cell_index);
+        }
+        for (dir = 0u; dir < RG_DIR_COUNT; ++dir) {
+            rg_chunk_t* neighbor;
+
+            neighbor = chunk->neighbors[dir];
+            if ((outputs[i].neighbor_touched & (1u << dir)) == 0u || neighbor == NULL) {
+                continue;
+            }
+            neighbor->live_cells = (uint32_t)((int64_t)neighbor->live_cells + outputs[i].neighbor_live_delta[dir]);
+            neighbor->idle_steps = 0u;
+            rg_chunk_set_awake(world, neighbor, (uint8_t)(neighbor->live_cells > 0u));
+            neighbor->border_dirty = (uint8_t)(neighbor->border_dirty | outputs[i].neighbor_border_dirty[dir]);
+            rg_chunk_flush_border(world, neighbor);
+        }
+    }
+
+    if (status == RG_STATUS_OK) {
+        for (i = 0u; i < task_count; ++i) {
+            world->intents_emitted_last_step += outputs[i].emitted_move_count;
+        }
+        if (ctx->remote_commit == RG_REMOTE_COMMIT_INTENTS) {
+            status = rg_merge_cross_intents(world, outputs, task_count);
+        }
+    }
+
+    world->step_simulate_ns_last_step += rg_elapsed_ns(ctx->simulate_start_ns, rg_default_clock_now_ns(NULL));
+    if (out_skipped != NULL) {
+        *out_skipped = skipped;
+    }
+    return status;
+}
+
+/* Runs one checkerboard phase over chunk_indices and merges its intents. */
+static rg_status_t rg_run_checkerboard_tasks(
+    rg_world_t* world,
+    uint64_t tick,
+    uint32_t* chunk_indices,
+    uint32_t task_count,
+    const rg_step_budget_t* budget,
+    rg_remote_commit_t remote_commit,
+    uint32_t* out_skipped)
+{
+    rg_checkerboard_task_ctx_t task_ctx;
+    uint32_t i;
+    rg_status_t status;
+
+    status = rg_prepare_checkerboard_phase(world, tick, chunk_indices, task_count, budget, remote_commit, &task_ctx);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+
+    if (rg_has_parallel_runner(world) != 0u) {
+        status = world->runner->vtable->parallel_for(
+            world->runner->user,
+            task_ctx.task_count,
+            rg_checkerboard_task_callback,
+            &task_ctx);
+    } else {
+        for (i = 0u; i < task_ctx.task_count; ++i) {
+            rg_checkerboard_task_callback(i, 0u, &task_ctx);
+        }
+    }
+
+    return rg_finish_checkerboard_phase(world, &task_ctx, status, out_skipped);
+}
+
+/*
+ * Collects the due, non-empty chunks of one color into
+ * world->scratch_chunk_indices, heaviest first when a runner will split them.
+ */
+static rg_status_t rg_select_checkerboard_chunks(
+    rg_world_t* world,
+    uint64_t tick,
+    uint32_t color,
+    uint32_t* out_count)
+{
+    uint32_t* chunk_indices;
+    uint32_t snapshot_count;
+    uint32_t task_count;
+    uint32_t i;
+    uint64_t setup_start_ns;
+    rg_status_t status;
+
+    *out_count = 0u;
+    if (world->active_lists[color].count == 0u) {
+        return RG_STATUS_OK;
+    }
+
+    setup_start_ns = rg_default_clock_now_ns(NULL);
+    status = rg_scratch_reserve_chunk_indices(world, world->active_lists[color].count);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+    chunk_indices = world->scratch_chunk_indices;
+
+    task_count = 0u;
+    snapshot_count = rg_snapshot_active_chunks(world, color, 1u, chunk_indices);
+    for (i = 0u; i < snapshot_count; ++i) {
+        rg_chunk_t* chunk;
+
+        chunk = world->chunks[chunk_indices[i]].chunk;
+        if (chunk == NULL || chunk->live_cells == 0u) {
+            continue;
+        }
+        if (rg_chunk_due(&world->chunks[chunk_indices[i]], tick) == 0u) {
+            world->lod_skipped_chunks_last_step += 1u;
+            continue;
+        }
+        chunk_indices[task_count] = chunk_indices[i];
+        task_count += 1u;
+    }
+
+    /* Block tasks are regrouped by block when the phase is prepared. */
+    if (task_count > 1u && rg_has_parallel_runner(world) != 0u && world->checkerboard_block == 1) {
+        status = rg_sort_tasks_by_cost(world, chunk_indices, task_count);
+        if (status != RG_STATUS_OK) {
+            return status;
+        }
+    }
+
+    world->step_setup_ns_last_step += rg_elapsed_ns(setup_start_ns, rg_default_clock_now_ns(NULL));
+    *out_count = task_count;
+    return RG_STATUS_OK;
+}
+
+static rg_status_t rg_execute_checkerboard_phase(
+    rg_world_t* world,
+    uint64_t tick,
+    uint32_t color_x,
+    uint32_t color_y,
+    rg_remote_commit_t remote_commit)
+{
+    uint32_t task_count;
+    rg_status_t status;
+
+    if (world == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+
+    status = rg_select_checkerboard_chunks(world, tick, color_x | (color_y << 1u), &task_count);
+    if (status == RG_STATUS_OK && task_count > 0u) {
+        status = rg_run_checkerboard_tasks(
+            world,
+            tick,
+            world->scratch_chunk_indices,
+            task_count,
+            NULL,
+            remote_commit,
+            NULL);
+    }
+    return status;
+}
+
+/*
+ * Cross-phase graph steps keep the active lists untouched while tasks run, so
+ * a task tracks whether its chunk is listed itself and notes the transitions
+ * the barrier path's syncs would have noted.
+ */
+static void rg_graph_sync_awake(
+    const rg_world_t* world,
+    rg_chunk_t* chunk,
+    uint8_t* listed,
+    rg_task_output_t* output)
+{
+    if (chunk->awake != 0u && *listed == 0u) {
+        output->chunk_wakes += 1u;
+        rg_chunk_adapt_wake(world, chunk);
+    } else if (chunk->awake == 0u && *listed != 0u) {
+        output->chunk_sleeps += 1u;
+        rg_chunk_adapt_sleep(world, chunk);
+    }
+    *listed = chunk->awake;
+}
+
+/* A border flush of a neighbor reached chunk, as in rg_chunk_flush_border. */
+static void rg_graph_apply_flush(rg_world_t* world, rg_chunk_t* chunk)
+{
+    if (chunk->live_cells == 0u) {
+        return;
+    }
+    chunk->idle_steps = 0u;
+    if (chunk->awake == 0u) {
+        rg_chunk_set_awake(world, chunk, 1u);
+    }
+}
+
+/* Target chunk half of an applied intent, plus the target cell's mask bit. */
+static void rg_graph_apply_target(rg_world_t* world, rg_chunk_t* chunk, const rg_cross_intent_t* intent)
+{
+    if (intent->target_material_id == 0u) {
+        chunk->live_cells += 1u;
+    }
+    chunk->idle_steps = 0u;
+    rg_chunk_set_awake(world, chunk, (uint8_t)(chunk->live_cells > 0u));
+    rg_mask_set(world, chunk, intent->target_cell_index);
+}
+
+/* Whether the task of chunk, if any, already took in what tasks of color did to it. */
+static uint8_t rg_graph_task_gathered(const rg_checkerboard_graph_ctx_t* ctx, const rg_chunk_t* chunk, uint32_t color)
+{
+    return (uint8_t)(ctx->chunk_tasks[chunk->entry_index] != UINT32_MAX && chunk->color > color);
+}
+
+/*
+ * Takes in what the tasks of an earlier color did to chunk: flushes first, then
+ * intents. Within a phase a flush finds the chunk's live count before any
+ * intent landed, unless one did, which wakes the chunk anyway, so this is the
+ * state the barrier path leaves.
+ */
+static void rg_graph_gather_phase(
+    const rg_checkerboard_graph_ctx_t* ctx,
+    rg_chunk_t* chunk,
+    uint32_t color,
+    uint8_t* listed,
+    rg_task_output_t* output)
+{
+    const rg_task_output_t* neighbor_outputs[RG_DIR_COUNT];
+    uint32_t dir;
+    uint8_t flushed;
+
+    flushed = 0u;
+    for (dir = 0u; dir < RG_DIR_COUNT; ++dir) {
+        const rg_chunk_t* neighbor;
+        uint32_t task;
+
+        neighbor_outputs[dir] = NULL;
+        neighbor = chunk->neighbors[dir];
+        if (neighbor == NULL || neighbor->color != color) {
+            continue;
+        }
+        task = ctx->chunk_tasks[neighbor->entry_index];
+        if (task == UINT32_MAX) {
+            continue;
+        }
+        neighbor_outputs[dir] = &ctx->outputs[task];
+        flushed = (uint8_t)(flushed | ((neighbor_outputs[dir]->neighbor_flushed >> (RG_DIR_COUNT - 1u - dir)) & 1u));
+    }
+
+    if (flushed != 0u) {
+        rg_graph_apply_flush(ctx->world, chunk);
+    }
+    for (dir = 0u; dir < RG_DIR_COUNT; ++dir) {
+        uint32_t i;
+
+        for (i = 0u; neighbor_outputs[dir] != NULL && i < neighbor_outputs[dir]->intent_count; ++i) {
+            if (neighbor_outputs[dir]->intents[i].target_chunk_index == chunk->entry_index) {
+                rg_graph_apply_target(ctx->world, chunk, &neighbor_outputs[dir]->intents[i]);
+            }
+        }
+    }
+    rg_graph_sync_awake(ctx->world, chunk, listed, output);
+}
+
+/*
+ * Applies a stepped chunk's own intents in (target cell, source cell) order,
+ * first applier wins. With chunks of at least 2x2 every cell next to a chunk
+ * borders exactly one chunk of each other color, so all intents for a target
+ * cell come from one source chunk and this is the order of the phase-wide
+ * merge. Applied intents are compacted to the front of output->intents; the
+ * source half and the border flushes are done here, the target halves by
+ * whoever gathers them.
+ */
+static void rg_graph_merge_intents(
+    rg_world_t* world,
+    const rg_chunk_entry_t* entry,
+    uint8_t* listed,
+    rg_task_output_t* output)
+{
+    rg_chunk_t* chunk;
+    uint32_t applied_count;
+    uint32_t previous_chunk;
+    uint32_t previous_cell;
+    uint8_t target_applied;
+    uint32_t i;
+
+    chunk = entry->chunk;
+    output->cross_intent_count = output->intent_count;
+    if (output->intent_count > 1u) {
+        qsort(output->intents, (size_t)output->intent_count, sizeof(*output->intents), rg_intent_compare_by_target);
+    }
+
+    applied_count = 0u;
+    previous_chunk = UINT32_MAX;
+    previous_cell = UINT32_MAX;
+    target_applied = 0u;
+    for (i = 0u; i < output->intent_count; ++i) {
+        rg_cross_intent_t intent;
+        const rg_chunk_entry_t* target_entry;
+        uint8_t bits;
+        uint32_t dir;
+
+        intent = output->intents[i];
+        if (intent.target_chunk_index == previous_chunk && intent.target_cell_index == previous_cell) {
+            output->intent_conflicts += 1u;
+        } else {
+            target_applied = 0u;
+        }
+        previous_chunk = intent.target_chunk_index;
+        previous_cell = intent.target_cell_index;
+        if (target_applied != 0u || rg_swap_cross_intent_cells(world, &intent) == 0u) {
+            continue;
+        }
+        target_applied = 1u;
+        output->intents[applied_count] = intent;
+        applied_count += 1u;
+
+        if (intent.target_material_id == 0u && chunk->live_cells > 0u) {
+            chunk->live_cells -= 1u;
+        }
+        chunk->idle_steps = 0u;
+        rg_chunk_set_awake(world, chunk, (uint8_t)(chunk->live_cells > 0u));
+        rg_graph_sync_awake(world, chunk, listed, output);
+        output->neighbor_flushed = (uint8_t)(output->neighbor_flushed | world->cell_border_bits[intent.source_cell_index]);
+
+        /* The target's flush reaches chunks around the target cell, all adjacent to this one. */
+        target_entry = &world->chunks[intent.target_chunk_index];
+        bits = world->cell_border_bits[intent.target_cell_index];
+        for (dir = 0u; bits != 0u; ++dir, bits = (uint8_t)(bits >> 1u)) {
+            int32_t dx;
+            int32_t dy;
+
+            dx = target_entry->chunk_x - entry->chunk_x + k_rg_dir_dx[dir];
+            dy = target_entry->chunk_y - entry->chunk_y + k_rg_dir_dy[dir];
+            if ((bits & 1u) == 0u || (dx == 0 && dy == 0) || rg_abs_i32(dx) > 1 || rg_abs_i32(dy) > 1) {
+                continue;
+            }
+            output->neighbor_flushed = (uint8_t)(output->neighbor_flushed | (1u << rg_dir_from_offset(dx, dy)));
+        }
+    }
+    output->intent_count = applied_count;
+}
+
+/*
+ * One chunk of a cross-phase graph step: takes in what its earlier-color
+ * neighbors did, then, if the chunk would be in its phase's snapshot, steps it
+ * and merges its intents. Everything it writes lies within one cell of the
+ * chunk, and so does everything it reads, so it only has to wait for the tasks
+ * of adjacent chunks in earlier phases.
+ */
+static void rg_checkerboard_graph_task_callback(uint32_t task_index, uint32_t worker_index, void* user_data)
+{
+    const rg_checkerboard_graph_ctx_t* ctx;
+    rg_chunk_entry_t* entry;
+    rg_chunk_t* chunk;
+    rg_task_output_t* output;
+    uint32_t color;
+    uint8_t listed;
+
+    (void)worker_index;
+
+    ctx = (const rg_checkerboard_graph_ctx_t*)user_data;
+    entry = &ctx->world->chunks[ctx->chunk_indices[task_index]];
+    chunk = entry->chunk;
+    output = &ctx->outputs[task_index];
+    listed = chunk->awake;
+    for (color = 0u; color < chunk->color; ++color) {
+        rg_graph_gather_phase(ctx, chunk, color, &listed, output);
+    }
+
+    if (chunk->awake == 0u || chunk->live_cells == 0u) {
+        return;
+    }
+    if (rg_chunk_due(entry, ctx->tick) == 0u) {
+        output->lod_skipped = 1u;
+        return;
+    }
+
+    (void)rg_step_chunk_serial(ctx->world, ctx->chunk_indices[task_index], ctx->tick, 1u, output);
+    rg_graph_sync_awake(ctx->world, chunk, &listed, output);
+    output->neighbor_flushed = (uint8_t)(output->neighbor_flushed | chunk->border_dirty);
+    chunk->border_dirty = 0u;
+    rg_graph_merge_intents(ctx->world, entry, &listed, output);
+}
+
+static uint32_t rg_checkerboard_graph_neighbor(const void* user, uint32_t task, uint32_t dir)
+{
+    const rg_checkerboard_graph_ctx_t* ctx;
+    const rg_chunk_t* neighbor;
+
+    ctx = (const rg_checkerboard_graph_ctx_t*)user;
+    neighbor = ctx->world->chunks[ctx->chunk_indices[task]].chunk->neighbors[dir];
+    return (neighbor == NULL) ? UINT32_MAX : ctx->chunk_tasks[neighbor->entry_index];
+}
+
+/*
+ * Picks the tasks of a cross-phase graph step, by color: the awake chunks of a
+ * color plus its chunks next to an earlier task, the only ones an earlier
+ * phase can wake. Fills the chunk task map and binds one output per task.
+ */
+static rg_status_t rg_prepare_checkerboard_graph(
+    rg_world_t* world,
+    uint32_t* color_offsets,
+    uint32_t* out_task_count)
+{
+    uint32_t* chunk_indices;
+    uint32_t* chunk_tasks;
+    uint32_t task_count;
+    uint32_t color;
+    uint32_t i;
+    rg_status_t status;
+
+    *out_task_count = 0u;
+    status = rg_scratch_reserve_chunk_indices(world, world->chunk_count);
+    if (status == RG_STATUS_OK) {
+        status = rg_scratch_reserve_chunk_tasks(world, world->chunk_count);
+    }
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+    chunk_indices = world->scratch_chunk_indices;
+    chunk_tasks = world->scratch_chunk_tasks;
+
+    task_count = 0u;
+    for (color = 0u; color < 4u; ++color) {
+        uint32_t earlier_count;
+
+        color_offsets[color] = task_count;
+        earlier_count = task_count;
+        task_count += rg_snapshot_active_chunks(world, color, 1u, chunk_indices + task_count);
+        for (i = earlier_count; i < task_count; ++i) {
+            chunk_tasks[chunk_indices[i]] = i;
+        }
+        for (i = 0u; i < earlier_count; ++i) {
+            const rg_chunk_t* chunk;
+            uint32_t dir;
+
+            chunk = world->chunks[chunk_indices[i]].chunk;
+            for (dir = 0u; dir < RG_DIR_COUNT; ++dir) {
+                const rg_chunk_t* neighbor;
+
+                neighbor = chunk->neighbors[dir];
+                if (neighbor != NULL && neighbor->color == color && chunk_tasks[neighbor->entry_index] == UINT32_MAX) {
+                    chunk_tasks[neighbor->entry_index] = task_count;
+                    chunk_indices[task_count] = neighbor->entry_index;
+                    task_count += 1u;
+                }
+            }
+        }
+    }
+    color_offsets[4] = task_count;
+
+    status = rg_scratch_reserve_outputs(world, task_count);
+    if (status == RG_STATUS_OK) {
+        status = rg_scratch_bind_intents(
             world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            0,
-            1,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+            world->scratch_outputs,
+            task_count,
+            rg_rect_perimeter_cells(world->chunk_width, world->chunk_height));
     }
-    if (rg_attempt_move(
+    for (i = 0u; i < task_count; ++i) {
+        if (status == RG_STATUS_OK) {
+            rg_task_output_reset(&world->scratch_outputs[i]);
+        } else {
+            chunk_tasks[chunk_indices[i]] = UINT32_MAX;
+        }
+    }
+    *out_task_count = (status == RG_STATUS_OK) ? task_count : 0u;
+    return status;
+}
+
+/*
+ * Stepping thread, after the graph: syncs the active lists, folds the task
+ * counters and, phase by phase, applies what tasks did to chunks no later task
+ * gathered. Leaves the chunk task map cleared.
+ */
+static void rg_finish_checkerboard_graph(
+    rg_world_t* world,
+    const rg_checkerboard_graph_ctx_t* ctx,
+    const uint32_t* color_offsets)
+{
+    uint32_t color;
+    uint32_t i;
+
+    world->active_sync_deferred = 0u;
+    for (i = 0u; i < color_offsets[4]; ++i) {
+        rg_chunk_t* chunk;
+        const rg_task_output_t* output;
+
+        chunk = world->chunks[ctx->chunk_indices[i]].chunk;
+        output = &ctx->outputs[i];
+        if (chunk->awake != 0u) {
+            rg_active_list_insert(world, chunk);
+        } else {
+            rg_active_list_remove(world, chunk);
+        }
+        rg_task_output_fold_counters(world, output);
+        world->intents_emitted_last_step += output->emitted_move_count;
+        world->cross_intents_last_step += output->cross_intent_count;
+        world->intent_conflicts_last_step += output->intent_conflicts;
+        world->lod_skipped_chunks_last_step += output->lod_skipped;
+        world->chunk_wakes_last_step += output->chunk_wakes;
+        world->chunk_wakes_total += output->chunk_wakes;
+        world->chunk_sleeps_last_step += output->chunk_sleeps;
+        world->chunk_sleeps_total += output->chunk_sleeps;
+    }
+
+    for (color = 0u; color < 4u; ++color) {
+        for (i = color_offsets[color]; i < color_offsets[color + 1u]; ++i) {
+            const rg_chunk_t* chunk;
+            uint32_t dir;
+            uint8_t flushed;
+
+            chunk = world->chunks[ctx->chunk_indices[i]].chunk;
+            flushed = ctx->outputs[i].neighbor_flushed;
+            for (dir = 0u; flushed != 0u; ++dir, flushed = (uint8_t)(flushed >> 1u)) {
+                rg_chunk_t* neighbor;
+
+                neighbor = chunk->neighbors[dir];
+                if ((flushed & 1u) != 0u && neighbor != NULL && rg_graph_task_gathered(ctx, neighbor, color) == 0u) {
+                    rg_graph_apply_flush(world, neighbor);
+                }
+            }
+        }
+        for (i = color_offsets[color]; i < color_offsets[color + 1u]; ++i) {
+            const rg_task_output_t* output;
+            uint32_t intent;
+
+            output = &ctx->outputs[i];
+            for (intent = 0u; intent < output->intent_count; ++intent) {
+                rg_chunk_t* target;
+
+                target = world->chunks[output->intents[intent].target_chunk_index].chunk;
+                if (rg_graph_task_gathered(ctx, target, color) == 0u) {
+                    rg_graph_apply_target(world, target, &output->intents[intent]);
+                }
+            }
+        }
+    }
+
+    for (i = 0u; i < color_offsets[4]; ++i) {
+        world->scratch_chunk_tasks[ctx->chunk_indices[i]] = UINT32_MAX;
+    }
+}
+
+/*
+ * Checkerboard step as one task graph for runners with run_graph: a chunk's
+ * task depends only on the tasks of adjacent chunks in earlier phases, so a
+ * chunk of phase N + 1 starts as soon as its neighbors' phase N steps and
+ * merges are done instead of waiting for the whole phase. Results, stats and
+ * active lists match the barrier path.
+ */
+static rg_status_t rg_step_checkerboard_graph(rg_world_t* world, uint64_t tick)
+{
+    rg_checkerboard_graph_ctx_t ctx;
+    rg_task_graph_t graph;
+    uint32_t color_offsets[5];
+    uint32_t task_count;
+    uint64_t setup_start_ns;
+    uint64_t simulate_start_ns;
+    rg_status_t status;
+
+    setup_start_ns = rg_default_clock_now_ns(NULL);
+    status = rg_prepare_checkerboard_graph(world, color_offsets, &task_count);
+    if (status != RG_STATUS_OK || task_count == 0u) {
+        return status;
+    }
+
+    ctx.world = world;
+    ctx.tick = tick;
+    ctx.chunk_indices = world->scratch_chunk_indices;
+    ctx.chunk_tasks = world->scratch_chunk_tasks;
+    ctx.outputs = world->scratch_outputs;
+    status = rg_build_neighbor_graph(world, task_count, rg_checkerboard_graph_neighbor, &ctx, &graph);
+    simulate_start_ns = rg_default_clock_now_ns(NULL);
+    world->step_setup_ns_last_step += rg_elapsed_ns(setup_start_ns, simulate_start_ns);
+    if (status == RG_STATUS_OK) {
+        graph.task = rg_checkerboard_graph_task_callback;
+        graph.task_user_data = &ctx;
+        world->active_sync_deferred = 1u;
+        status = world->runner->vtable->run_graph(world->runner->user, &graph);
+    }
+
+    rg_finish_checkerboard_graph(world, &ctx, color_offsets);
+    world->step_simulate_ns_last_step += rg_elapsed_ns(simulate_start_ns, rg_default_clock_now_ns(NULL));
+    return status;
+}
+
+static rg_status_t rg_step_checkerboard_parallel(rg_world_t* world, uint64_t tick, rg_remote_commit_t remote_commit)
+{
+    uint32_t color_index;
+    rg_status_t status;
+
+    if (world == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (remote_commit == RG_REMOTE_COMMIT_INTENTS && rg_has_graph_runner(world) != 0u &&
+        world->checkerboard_block == 1 && world->chunk_width >= 2 && world->chunk_height >= 2) {
+        return rg_step_checkerboard_graph(world, tick);
+    }
+
+    for (color_index = 0u; color_index < 4u; ++color_index) {
+        uint32_t color_x;
+        uint32_t color_y;
+
+        color_x = color_index & 1u;
+        color_y = (color_index >> 1u) & 1u;
+
+        status = rg_execute_checkerboard_phase(world, tick, color_x, color_y, remote_commit);
+        if (status != RG_STATUS_OK) {
+            return status;
+        }
+    }
+
+    return RG_STATUS_OK;
+}
+
+static void rg_tile_task_callback(uint32_t task_index, uint32_t worker_index, void* user_data)
+{
+    rg_tile_task_ctx_t* ctx;
+    rg_task_output_t* output;
+    uint32_t chunk_index;
+
+    (void)worker_index;
+
+    ctx = (rg_tile_task_ctx_t*)user_data;
+    if (ctx == NULL || task_index >= ctx->task_count || ctx->outputs == NULL) {
+        return;
+    }
+
+    chunk_index = ctx->chunk_indices[task_index];
+    output = &ctx->outputs[task_index];
+    output->changed = rg_step_cells(
+        ctx->world,
+        chunk_index,
+        &ctx->world->chunks[chunk_index],
+        ctx->tick,
+        output->tile_x0,
+        output->tile_y0,
+        output->tile_x1,
+        output->tile_y1,
+        1u,
+        output);
+}
+
+/*
+ * One tile color phase: every tile of the stepping chunks whose global tile
+ * coordinate has the given parity becomes a task. Same-colored tiles are never
+ * adjacent, so a task only writes its own tile and reads at most one cell into
+ * tiles that are idle this phase.
+ */
+static rg_status_t rg_execute_tile_phase(
+    rg_world_t* world,
+    uint64_t tick,
+    const uint32_t* chunk_indices,
+    uint32_t chunk_count,
+    uint32_t color)
+{
+    rg_task_output_t* outputs;
+    rg_tile_task_ctx_t task_ctx;
+    uint32_t tiles_x;
+    uint32_t tiles_y;
+    uint32_t task_count;
+    uint32_t i;
+    uint64_t setup_start_ns;
+    uint64_t simulate_start_ns;
+    rg_status_t status;
+
+    setup_start_ns = rg_default_clock_now_ns(NULL);
+    tiles_x = (uint32_t)(world->chunk_width / world->tile_width);
+    tiles_y = (uint32_t)(world->chunk_height / world->tile_height);
+    outputs = world->scratch_outputs;
+    task_count = 0u;
+    for (i = 0u; i < chunk_count; ++i) {
+        const rg_chunk_entry_t* entry;
+        uint32_t tx;
+        uint32_t ty;
+
+        entry = &world->chunks[chunk_indices[i]];
+        for (ty = 0u; ty < tiles_y; ++ty) {
+            for (tx = 0u; tx < tiles_x; ++tx) {
+                uint32_t tile_color;
+                rg_task_output_t* output;
+
+                tile_color = (((uint32_t)entry->chunk_x * tiles_x + tx) & 1u) |
+                    ((((uint32_t)entry->chunk_y * tiles_y + ty) & 1u) << 1u);
+                if (tile_color != color) {
+                    continue;
+                }
+
+                output = &outputs[task_count];
+                rg_task_output_reset(output);
+                output->tiled = 1u;
+                output->tile_x0 = (int32_t)tx * world->tile_width;
+                output->tile_y0 = (int32_t)ty * world->tile_height;
+                output->tile_x1 = output->tile_x0 + world->tile_width;
+                output->tile_y1 = output->tile_y0 + world->tile_height;
+                world->scratch_tile_chunks[task_count] = chunk_indices[i];
+                task_count += 1u;
+            }
+        }
+    }
+
+    status = rg_scratch_bind_intents(
+        world,
+        outputs,
+        task_count,
+        rg_rect_perimeter_cells(world->tile_width, world->tile_height));
+    simulate_start_ns = rg_default_clock_now_ns(NULL);
+    world->step_setup_ns_last_step += rg_elapsed_ns(setup_start_ns, simulate_start_ns);
+    if (status != RG_STATUS_OK || task_count == 0u) {
+        return status;
+    }
+
+    memset(&task_ctx, 0, sizeof(task_ctx));
+    task_ctx.world = world;
+    task_ctx.tick = tick;
+    task_ctx.chunk_indices = world->scratch_tile_chunks;
+    task_ctx.task_count = task_count;
+    task_ctx.outputs = outputs;
+
+    status = RG_STATUS_OK;
+    world->active_sync_deferred = 1u;
+    if (rg_has_parallel_runner(world) != 0u) {
+        status = world->runner->vtable->parallel_for(
+            world->runner->user,
+            task_count,
+            rg_tile_task_callback,
+            &task_ctx);
+    } else {
+        for (i = 0u; i < task_count; ++i) {
+            rg_tile_task_callback(i, 0u, &task_ctx);
+        }
+    }
+    world->active_sync_deferred = 0u;
+
+    for (i = 0u; i < task_count; ++i) {
+        rg_chunk_t* chunk;
+        const rg_task_output_t* output;
+
+        output = &outputs[i];
+        chunk = world->chunks[world->scratch_tile_chunks[i]].chunk;
+        rg_task_output_fold_counters(world, output);
+        if (output->chunk_live_delta < 0 && (uint64_t)(-output->chunk_live_delta) > chunk->live_cells) {
+            chunk->live_cells = 0u;
+        } else {
+            chunk->live_cells = (uint32_t)((int64_t)chunk->live_cells + output->chunk_live_delta);
+        }
+        chunk->border_dirty = (uint8_t)(chunk->border_dirty | output->border_dirty);
+        if (output->changed != 0u || output->intent_count > 0u) {
+            chunk->tile_changed = 1u;
+        }
+    }
+    for (i = 0u; i < task_count; ++i) {
+        rg_chunk_flush_border(world, world->chunks[world->scratch_tile_chunks[i]].chunk);
+    }
+
+    if (status == RG_STATUS_OK) {
+        for (i = 0u; i < task_count; ++i) {
+            world->intents_emitted_last_step += outputs[i].emitted_move_count;
+        }
+        status = rg_merge_cross_intents(world, outputs, task_count);
+    }
+
+    world->step_simulate_ns_last_step += rg_elapsed_ns(simulate_start_ns, rg_default_clock_now_ns(NULL));
+    return status;
+}
+
+/*
+ * Tile checkerboard: the chunks due this tick are split into tile_width x
+ * tile_height tiles stepped in four tile-color phases, so a few large chunks
+ * still spread over all workers. Per-chunk idle/sleep bookkeeping runs once
+ * after the last phase.
+ */
+static rg_status_t rg_step_tile_checkerboard(rg_world_t* world, uint64_t tick)
+{
+    uint32_t* chunk_indices;
+    uint32_t snapshot_count;
+    uint32_t chunk_count;
+    uint32_t tiles_per_chunk;
+    uint32_t color;
+    uint32_t i;
+    uint64_t setup_start_ns;
+    rg_status_t status;
+
+    if (world->active_chunk_count == 0u) {
+        return RG_STATUS_OK;
+    }
+
+    setup_start_ns = rg_default_clock_now_ns(NULL);
+    status = rg_scratch_reserve_chunk_indices(world, world->active_chunk_count);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+    chunk_indices = world->scratch_chunk_indices;
+
+    snapshot_count = rg_snapshot_active_chunks(world, 0u, 4u, chunk_indices);
+    chunk_count = 0u;
+    for (i = 0u; i < snapshot_count; ++i) {
+        rg_chunk_t* chunk;
+
+        chunk = world->chunks[chunk_indices[i]].chunk;
+        if (chunk == NULL || chunk->live_cells == 0u) {
+            continue;
+        }
+        if (rg_chunk_due(&world->chunks[chunk_indices[i]], tick) == 0u) {
+            world->lod_skipped_chunks_last_step += 1u;
+            continue;
+        }
+        chunk->tile_changed = 0u;
+        chunk->deferred_age = 0u;
+        rg_mask_prepare(world, chunk);
+        chunk_indices[chunk_count] = chunk_indices[i];
+        chunk_count += 1u;
+    }
+
+    tiles_per_chunk = (uint32_t)(world->chunk_width / world->tile_width) *
+        (uint32_t)(world->chunk_height / world->tile_height);
+    if (chunk_count > 0u && tiles_per_chunk > UINT32_MAX / chunk_count) {
+        return RG_STATUS_CAPACITY_REACHED;
+    }
+    status = rg_scratch_reserve_outputs(world, chunk_count * tiles_per_chunk);
+    if (status == RG_STATUS_OK) {
+        status = rg_scratch_reserve(
             world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            first_dx,
-            1,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+            (void**)&world->scratch_tile_chunks,
+            &world->scratch_tile_chunk_capacity,
+            chunk_count * tiles_per_chunk,
+            sizeof(*world->scratch_tile_chunks),
+            _Alignof(uint32_t));
+    }
+    world->step_setup_ns_last_step += rg_elapsed_ns(setup_start_ns, rg_default_clock_now_ns(NULL));
+    if (status != RG_STATUS_OK || chunk_count == 0u) {
+        return status;
+    }
+
+    for (color = 0u; color < 4u; ++color) {
+        status = rg_execute_tile_phase(world, tick, chunk_indices, chunk_count, color);
+        if (status != RG_STATUS_OK) {
+            return status;
+        }
+    }
+
+    for (i = 0u; i < chunk_count; ++i) {
+        rg_chunk_t* chunk;
+
+        chunk = world->chunks[chunk_indices[i]].chunk;
+        rg_chunk_finish_step(world, chunk, chunk->tile_changed, NULL);
+    }
+    return RG_STATUS_OK;
+}
+
+/*
+ * Precomputes which neighbor chunks each local cell borders: edge cells map to
+ * one side, corner cells to two sides plus the diagonal. Interior cells are 0.
+ */
+static rg_status_t rg_build_border_bits(rg_world_t* world)
+{
+    int32_t x;
+    int32_t y;
+
+    world->cell_border_bits = (uint8_t*)rg_alloc_bytes(&world->allocator, (size_t)world->cells_per_chunk, 1u);
+    if (world->cell_border_bits == NULL) {
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+
+    for (y = 0; y < world->chunk_height; ++y) {
+        for (x = 0; x < world->chunk_width; ++x) {
+            int32_t dx;
+            int32_t dy;
+            uint8_t bits;
+
+            bits = 0u;
+            for (dy = -1; dy <= 1; ++dy) {
+                for (dx = -1; dx <= 1; ++dx) {
+                    uint8_t touches_x;
+                    uint8_t touches_y;
+
+                    if (dx == 0 && dy == 0) {
+                        continue;
+                    }
+                    touches_x = (uint8_t)(dx == 0 || (dx < 0 && x == 0) || (dx > 0 && x == world->chunk_width - 1));
+                    touches_y = (uint8_t)(dy == 0 || (dy < 0 && y == 0) || (dy > 0 && y == world->chunk_height - 1));
+                    if (touches_x != 0u && touches_y != 0u) {
+                        bits = (uint8_t)(bits | (1u << rg_dir_from_offset(dx, dy)));
+                    }
+                }
+            }
+            world->cell_border_bits[((uint32_t)y * (uint32_t)world->chunk_width) + (uint32_t)x] = bits;
+        }
+    }
+
+    return RG_STATUS_OK;
+}
+
+rg_status_t rg_world_create(const rg_world_config_t* cfg, rg_world_t** out_world)
+{
+    rg_world_config_t resolved_cfg;
+    rg_allocator_t allocator;
+    rg_world_t* world;
+    size_t material_capacity;
+    rg_status_t status;
+
+    if (out_world == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    *out_world = NULL;
+
+    memset(&resolved_cfg, 0, sizeof(resolved_cfg));
+    if (cfg != NULL) {
+        resolved_cfg = *cfg;
+    }
+
+    if (resolved_cfg.chunk_width == 0) {
+        resolved_cfg.chunk_width = RG_DEFAULT_CHUNK_WIDTH;
+    }
+    if (resolved_cfg.chunk_height == 0) {
+        resolved_cfg.chunk_height = RG_DEFAULT_CHUNK_HEIGHT;
+    }
+    if (resolved_cfg.inline_payload_bytes == 0u) {
+        resolved_cfg.inline_payload_bytes = RG_DEFAULT_INLINE_PAYLOAD_BYTES;
+    }
+    if (resolved_cfg.max_materials == 0u) {
+        resolved_cfg.max_materials = RG_DEFAULT_MAX_MATERIALS;
+    }
+    if (resolved_cfg.initial_chunk_capacity == 0u) {
+        resolved_cfg.initial_chunk_capacity = RG_DEFAULT_INITIAL_CHUNKS;
+    }
+    if (resolved_cfg.lod_band_width == 0u) {
+        resolved_cfg.lod_band_width = RG_DEFAULT_LOD_BAND_WIDTH;
+    }
+    if (resolved_cfg.lod_max_period == 0u) {
+        resolved_cfg.lod_max_period = RG_DEFAULT_LOD_MAX_PERIOD;
+    }
+    if (resolved_cfg.checkerboard_grain == 0u) {
+        resolved_cfg.checkerboard_grain = 1u;
+    }
+    if (resolved_cfg.checkerboard_block == 0u) {
+        resolved_cfg.checkerboard_block = 1u;
     }
-    if (rg_attempt_move(
-            world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            second_dx,
-            1,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+    if (resolved_cfg.tile_width == 0) {
+        resolved_cfg.tile_width = resolved_cfg.chunk_width;
+    }
+    if (resolved_cfg.tile_height == 0) {
+        resolved_cfg.tile_height = resolved_cfg.chunk_height;
+    }
+    if (resolved_cfg.chunk_sleep_ticks == 0u) {
+        resolved_cfg.chunk_sleep_ticks = RG_DEFAULT_CHUNK_SLEEP_TICKS;
+    }
+    if (resolved_cfg.chunk_sleep_ticks_min == 0u) {
+        resolved_cfg.chunk_sleep_ticks_min = (resolved_cfg.chunk_sleep_ticks >= 4u) ?
+            resolved_cfg.chunk_sleep_ticks / 4u :
+            1u;
+    }
+    if (resolved_cfg.chunk_sleep_ticks_max == 0u) {
+        resolved_cfg.chunk_sleep_ticks_max = (resolved_cfg.chunk_sleep_ticks <= UINT32_MAX / 8u) ?
+            resolved_cfg.chunk_sleep_ticks * 8u :
+            UINT32_MAX;
     }
 
-    return 0u;
-}
+    if (resolved_cfg.chunk_width <= 0 || resolved_cfg.chunk_height <= 0) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if ((uint32_t)resolved_cfg.default_step_mode > (uint32_t)RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    /*
+     * Tiles partition the chunk, and every tile must start on a byte of the
+     * updated mask so concurrent tiles never share a mask byte: tiles narrower
+     * than the chunk need a width that is a multiple of 8, and full-width tiles
+     * shorter than the chunk need a multiple of 8 cells per tile.
+     */
+    if (resolved_cfg.tile_width <= 0 || resolved_cfg.tile_height <= 0 ||
+        (resolved_cfg.chunk_width % resolved_cfg.tile_width) != 0 ||
+        (resolved_cfg.chunk_height % resolved_cfg.tile_height) != 0) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (resolved_cfg.tile_width != resolved_cfg.chunk_width && (resolved_cfg.tile_width % 8) != 0) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (resolved_cfg.tile_height != resolved_cfg.chunk_height &&
+        (((int64_t)resolved_cfg.chunk_width * (int64_t)resolved_cfg.tile_height) % 8) != 0) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if ((uint32_t)resolved_cfg.sleep_policy > (uint32_t)RG_SLEEP_POLICY_ADAPTIVE) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (resolved_cfg.checkerboard_block > (uint32_t)INT32_MAX) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (!rg_is_power_of_two_u32(resolved_cfg.lod_max_period) || resolved_cfg.lod_max_period > RG_MAX_LOD_PERIOD) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (resolved_cfg.chunk_sleep_ticks_min > resolved_cfg.chunk_sleep_ticks ||
+        resolved_cfg.chunk_sleep_ticks_max < resolved_cfg.chunk_sleep_ticks) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if ((uint64_t)resolved_cfg.chunk_width * (uint64_t)resolved_cfg.chunk_height > UINT32_MAX) {
+        return RG_STATUS_CAPACITY_REACHED;
+    }
 
-static uint8_t rg_step_liquid(
-    rg_world_t* world,
-    uint32_t source_chunk_index,
-    rg_chunk_entry_t* source_entry,
-    int32_t source_local_x,
-    int32_t source_local_y,
-    uint32_t source_index,
-    rg_material_id_t source_material_id,
-    const rg_material_record_t* source_material,
-    uint8_t primary_left,
-    uint8_t emit_cross_intents,
-    rg_task_output_t* task_output)
-{
-    int32_t first_dx;
-    int32_t second_dx;
+    status = rg_prepare_allocator(&resolved_cfg.allocator, &allocator);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
 
-    first_dx = (primary_left != 0u) ? -1 : 1;
-    second_dx = -first_dx;
+    world = (rg_world_t*)rg_alloc_bytes(&allocator, sizeof(*world), _Alignof(rg_world_t));
+    if (world == NULL) {
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+    memset(world, 0, sizeof(*world));
 
-    if (rg_attempt_move(
-            world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            0,
-            1,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+    world->allocator = allocator;
+    world->runner = resolved_cfg.runner;
+    world->default_step_mode = resolved_cfg.default_step_mode;
+    world->deterministic_seed = resolved_cfg.deterministic_seed;
+    world->deterministic_mode = resolved_cfg.deterministic_mode;
+    world->chunk_width = resolved_cfg.chunk_width;
+    world->chunk_height = resolved_cfg.chunk_height;
+    world->cells_per_chunk = (uint32_t)((uint64_t)resolved_cfg.chunk_width * (uint64_t)resolved_cfg.chunk_height);
+    world->inline_payload_bytes = resolved_cfg.inline_payload_bytes;
+    world->max_materials = resolved_cfg.max_materials;
+    world->sleep_adaptive = (uint8_t)(resolved_cfg.sleep_policy == RG_SLEEP_POLICY_ADAPTIVE);
+    world->sleep_ticks = resolved_cfg.chunk_sleep_ticks;
+    world->sleep_ticks_min = resolved_cfg.chunk_sleep_ticks_min;
+    world->sleep_ticks_max = resolved_cfg.chunk_sleep_ticks_max;
+    world->lod_radius = resolved_cfg.lod_full_rate_radius;
+    world->lod_band = resolved_cfg.lod_band_width;
+    world->checkerboard_grain = resolved_cfg.checkerboard_grain;
+    world->checkerboard_block = (int32_t)resolved_cfg.checkerboard_block;
+    world->tile_width = resolved_cfg.tile_width;
+    world->tile_height = resolved_cfg.tile_height;
+    world->lod_max_shift = 0u;
+    while ((1u << world->lod_max_shift) < resolved_cfg.lod_max_period) {
+        world->lod_max_shift += 1u;
     }
-    if (rg_attempt_move(
-            world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            first_dx,
-            0,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+
+    material_capacity = ((size_t)world->max_materials + 1u) * sizeof(*world->materials);
+    world->materials = (rg_material_record_t*)rg_alloc_bytes(
+        &world->allocator,
+        material_capacity,
+        _Alignof(rg_material_record_t));
+    if (world->materials == NULL) {
+        rg_free_bytes(&world->allocator, world, sizeof(*world), _Alignof(rg_world_t));
+        return RG_STATUS_ALLOCATION_FAILED;
     }
-    if (rg_attempt_move(
-            world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            second_dx,
-            0,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+    memset(world->materials, 0, material_capacity);
+
+    status = rg_build_border_bits(world);
+    if (status == RG_STATUS_OK) {
+        status = rg_chunk_reserve(world, resolved_cfg.initial_chunk_capacity);
     }
-    if (rg_attempt_move(
-            world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            first_dx,
-            1,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+    if (status != RG_STATUS_OK) {
+        rg_free_bytes(&world->allocator, world->cell_border_bits, (size_t)world->cells_per_chunk, 1u);
+        rg_free_bytes(&world->allocator, world->materials, material_capacity, _Alignof(rg_material_record_t));
+        rg_free_bytes(&world->allocator, world, sizeof(*world), _Alignof(rg_world_t));
+        return status;
     }
-    if (rg_attempt_move(
-            world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            second_dx,
-            1,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+
+    if (resolved_cfg.step_scratch_chunks > 0u) {
+        status = rg_world_reserve_step_scratch(world, resolved_cfg.step_scratch_chunks);
+        if (status != RG_STATUS_OK) {
+            rg_world_destroy(world);
+            return status;
+        }
     }
 
-    return 0u;
+    *out_world = world;
+    return RG_STATUS_OK;
 }
 
-static uint8_t rg_step_gas(
-    rg_world_t* world,
-    uint32_t source_chunk_index,
-    rg_chunk_entry_t* source_entry,
-    int32_t source_local_x,
-    int32_t source_local_y,
-    uint32_t source_index,
-    rg_material_id_t source_material_id,
-    const rg_material_record_t* source_material,
-    uint8_t primary_left,
-    uint8_t emit_cross_intents,
-    rg_task_output_t* task_output)
+/*
+ * Sizes every step scratch buffer for active_chunk_count active chunks in the
+ * largest mode: one output per tile and rim-cell intent slots per output, which
+ * also bounds the intents a phase can merge. A cross-phase graph step also has
+ * a task for each neighbor of an active chunk.
+ */
+rg_status_t rg_world_reserve_step_scratch(rg_world_t* world, uint32_t active_chunk_count)
 {
-    int32_t first_dx;
-    int32_t second_dx;
+    uint64_t output_count;
+    uint64_t intent_count;
+    uint64_t chunk_count;
+    uint64_t chunk_intent_count;
+    rg_status_t status;
 
-    first_dx = (primary_left != 0u) ? -1 : 1;
-    second_dx = -first_dx;
+    if (world == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
+    }
+    if (active_chunk_count == 0u) {
+        return RG_STATUS_OK;
+    }
 
-    if (rg_attempt_move(
+    output_count = (uint64_t)active_chunk_count *
+        (uint64_t)(world->chunk_width / world->tile_width) *
+        (uint64_t)(world->chunk_height / world->tile_height);
+    intent_count = output_count * rg_rect_perimeter_cells(world->tile_width, world->tile_height);
+    chunk_count = active_chunk_count;
+    if (rg_has_graph_runner(world) != 0u && world->checkerboard_block == 1) {
+        chunk_count = 9u * (uint64_t)active_chunk_count;
+        if (chunk_count > output_count) {
+            output_count = chunk_count;
+        }
+    }
+    chunk_intent_count = chunk_count * rg_rect_perimeter_cells(world->chunk_width, world->chunk_height);
+    if (chunk_intent_count > intent_count) {
+        intent_count = chunk_intent_count;
+    }
+    if (output_count > UINT32_MAX || intent_count > UINT32_MAX / 2u) {
+        return RG_STATUS_CAPACITY_REACHED;
+    }
+
+    world->scratch_reserving = 1u;
+    status = rg_scratch_reserve_chunk_indices(world, (uint32_t)chunk_count);
+    if (status == RG_STATUS_OK) {
+        status = rg_scratch_reserve_outputs(world, (uint32_t)output_count);
+    }
+    if (status == RG_STATUS_OK && chunk_count > active_chunk_count) {
+        status = rg_scratch_reserve_chunk_tasks(world, (uint32_t)chunk_count);
+    }
+    if (status == RG_STATUS_OK) {
+        status = rg_scratch_reserve(
             world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            0,
-            -1,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+            (void**)&world->scratch_cost_keys,
+            &world->scratch_cost_key_capacity,
+            active_chunk_count,
+            sizeof(*world->scratch_cost_keys),
+            _Alignof(uint64_t));
+    }
+    if (status == RG_STATUS_OK && world->checkerboard_block > 1) {
+        status = rg_scratch_reserve(
+            world,
+            (void**)&world->scratch_block_offsets,
+            &world->scratch_block_offset_capacity,
+            active_chunk_count + 1u,
+            sizeof(*world->scratch_block_offsets),
+            _Alignof(uint32_t));
     }
-    if (rg_attempt_move(
+    if (status == RG_STATUS_OK) {
+        status = rg_scratch_reserve(
             world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            first_dx,
-            0,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+            (void**)&world->scratch_budget_keys,
+            &world->scratch_budget_key_capacity,
+            active_chunk_count,
+            sizeof(*world->scratch_budget_keys),
+            _Alignof(rg_budget_key_t));
     }
-    if (rg_attempt_move(
+    if (status == RG_STATUS_OK) {
+        status = rg_scratch_reserve(
             world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            second_dx,
-            0,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+            (void**)&world->scratch_tile_chunks,
+            &world->scratch_tile_chunk_capacity,
+            (uint32_t)output_count,
+            sizeof(*world->scratch_tile_chunks),
+            _Alignof(uint32_t));
     }
-    if (rg_attempt_move(
+    if (status == RG_STATUS_OK) {
+        status = rg_scratch_reserve(
             world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            first_dx,
-            -1,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+            (void**)&world->scratch_intents,
+            &world->scratch_intent_capacity,
+            (uint32_t)intent_count,
+            sizeof(*world->scratch_intents),
+            _Alignof(rg_cross_intent_t));
     }
-    if (rg_attempt_move(
+    if (status == RG_STATUS_OK) {
+        status = rg_scratch_reserve(
             world,
-            source_chunk_index,
-            source_entry,
-            source_local_x,
-            source_local_y,
-            source_index,
-            source_material_id,
-            source_material,
-            second_dx,
-            -1,
-            0u,
-            emit_cross_intents,
-            task_output) != 0u) {
-        return 1u;
+            (void**)&world->scratch_merged,
+            &world->scratch_merged_capacity,
+            (uint32_t)intent_count,
+            sizeof(*world->scratch_merged),
+            _Alignof(rg_cross_intent_t));
     }
-
-    return 0u;
+    if (status == RG_STATUS_OK) {
+        status = rg_scratch_reserve(
+            world,
+            (void**)&world->scratch_intent_sort,
+            &world->scratch_intent_sort_capacity,
+            (uint32_t)intent_count * 2u,
+            sizeof(*world->scratch_intent_sort),
+            _Alignof(rg_intent_sort_entry_t));
+    }
+    if (status == RG_STATUS_OK) {
+        status = rg_scratch_reserve(
+            world,
+            (void**)&world->scratch_intent_buckets,
+            &world->scratch_intent_bucket_capacity,
+            (uint32_t)intent_count * 2u,
+            sizeof(*world->scratch_intent_buckets),
+            _Alignof(rg_intent_bucket_t));
+    }
+    if (status == RG_STATUS_OK && rg_has_graph_runner(world) != 0u) {
+        uint64_t graph_tasks;
+        uint64_t graph_words;
+
+        /* Target chunks and graph step tasks lie within one chunk of an active chunk. */
+        graph_tasks = (intent_count < 9u * (uint64_t)active_chunk_count) ? intent_count : 9u * (uint64_t)active_chunk_count;
+        if (chunk_count > graph_tasks) {
+            graph_tasks = chunk_count;
+        }
+        graph_words = rg_merge_graph_words((uint32_t)graph_tasks);
+        if (graph_words > UINT32_MAX) {
+            status = RG_STATUS_CAPACITY_REACHED;
+        } else {
+            status = rg_scratch_reserve(
+                world,
+                (void**)&world->scratch_merge_graph,
+                &world->scratch_merge_graph_capacity,
+                (uint32_t)graph_words,
+                sizeof(*world->scratch_merge_graph),
+                _Alignof(uint32_t));
+        }
+    }
+    world->scratch_reserving = 0u;
+    return status;
 }
 
-static uint8_t rg_step_chunk_serial(
-    rg_world_t* world,
-    uint32_t source_chunk_index,
-    uint64_t tick,
-    uint8_t emit_cross_intents,
-    rg_task_output_t* task_output)
+void rg_world_destroy(rg_world_t* world)
 {
-    rg_chunk_entry_t* entry;
-    rg_chunk_t* chunk;
-    int32_t y;
-    uint8_t changed;
+    size_t material_capacity;
+    uint32_t i;
 
-    if (world == NULL || source_chunk_index >= world->chunk_count) {
-        return 0u;
+    if (world == NULL) {
+        return;
+    }
+    if (world->step_in_flight != 0u) {
+        (void)rg_world_step_wait(world);
     }
 
-    entry = &world->chunks[source_chunk_index];
-    if (entry->chunk == NULL) {
-        return 0u;
+    for (i = 0u; i < world->chunk_count; ++i) {
+        rg_chunk_destroy(world, world->chunks[i].chunk);
+    }
+    for (i = 0u; i < 4u; ++i) {
+        rg_chunk_list_release(world, &world->active_lists[i]);
     }
+    rg_free_bytes(
+        &world->allocator,
+        world->chunks,
+        (size_t)world->chunk_capacity * sizeof(*world->chunks),
+        _Alignof(rg_chunk_entry_t));
 
-    chunk = entry->chunk;
-    if (chunk->live_cells == 0u) {
-        chunk->idle_steps = 0u;
-        rg_chunk_set_awake(world, chunk, 0u);
-        return 0u;
+    for (i = 1u; i <= world->material_count; ++i) {
+        if (world->materials[i].used != 0u && world->materials[i].name != NULL) {
+            size_t name_len;
+            name_len = strlen(world->materials[i].name) + 1u;
+            rg_free_bytes(&world->allocator, world->materials[i].name, name_len, 1u);
+        }
     }
 
-    changed = 0u;
+    material_capacity = ((size_t)world->max_materials + 1u) * sizeof(*world->materials);
+    rg_free_bytes(&world->allocator, world->materials, material_capacity, _Alignof(rg_material_record_t));
+    rg_free_bytes(&world->allocator, world->cell_border_bits, (size_t)world->cells_per_chunk, 1u);
+    rg_scratch_release(world);
+    rg_free_bytes(
+        &world->allocator,
+        world->focus_chunks,
+        (size_t)world->focus_count * sizeof(*world->focus_chunks),
+        _Alignof(rg_cell_coord_t));
+    rg_free_bytes(&world->allocator, world, sizeof(*world), _Alignof(rg_world_t));
+}
 
-    for (y = world->chunk_height - 1; y >= 0; --y) {
-        int32_t x_step;
-        uint8_t left_to_right;
+rg_status_t rg_material_register(
+    rg_world_t* world,
+    const rg_material_desc_t* desc,
+    rg_material_id_t* out_material_id)
+{
+    rg_material_id_t new_id;
+    rg_material_record_t* record;
+    uint16_t instance_align;
+    uint32_t i;
 
-        left_to_right = (uint8_t)(rg_step_random(world, tick, entry->chunk_x, entry->chunk_y, 0, y, 0x71u) & 1u);
-        for (x_step = 0; x_step < world->chunk_width; ++x_step) {
-            int32_t x;
-            uint32_t index;
-            rg_material_id_t material_id;
-            const rg_material_record_t* material;
-            uint8_t primary_left;
-            uint8_t moved;
+    if (world == NULL || desc == NULL || out_material_id == NULL || desc->name == NULL || desc->name[0] == '\0') {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
+    }
+    if (world->material_count >= world->max_materials) {
+        return RG_STATUS_CAPACITY_REACHED;
+    }
 
-            x = (left_to_right != 0u) ? x_step : (world->chunk_width - 1 - x_step);
-            index = ((uint32_t)y * (uint32_t)world->chunk_width) + (uint32_t)x;
+    for (i = 1u; i <= world->material_count; ++i) {
+        if (world->materials[i].used != 0u && strcmp(world->materials[i].name, desc->name) == 0) {
+            return RG_STATUS_ALREADY_EXISTS;
+        }
+    }
 
-            if (rg_mask_test(chunk, index) != 0u) {
-                continue;
-            }
+    instance_align = desc->instance_align;
+    if (instance_align == 0u) {
+        instance_align = 1u;
+    }
+    if (!rg_is_power_of_two_u32(instance_align)) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
 
-            material_id = chunk->material_ids[index];
-            if (material_id == 0u) {
-                continue;
-            }
+    new_id = world->material_count + 1u;
+    record = &world->materials[new_id];
+    memset(record, 0, sizeof(*record));
 
-            material = rg_material_get(world, material_id);
-            if (material == NULL) {
-                continue;
-            }
-            if ((material->flags & RG_MATERIAL_STATIC) != 0u) {
-                continue;
-            }
+    record->name = rg_strdup_with_allocator(&world->allocator, desc->name);
+    if (record->name == NULL) {
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
 
-            primary_left = (uint8_t)(rg_step_random(world, tick, entry->chunk_x, entry->chunk_y, x, y, 0xabu) & 1u);
-            moved = 0u;
-            if (material->update_fn != NULL) {
-                rg_update_ctx_t update_ctx;
-                void* instance_data;
+    record->flags = desc->flags;
+    record->density = desc->density;
+    record->friction = desc->friction;
+    record->dispersion = desc->dispersion;
+    record->instance_size = desc->instance_size;
+    record->instance_align = instance_align;
+    record->instance_ctor = desc->instance_ctor;
+    record->instance_dtor = desc->instance_dtor;
+    record->instance_move = desc->instance_move;
+    record->update_fn = desc->update_fn;
+    record->user_data = desc->user_data;
+    record->used = 1u;
 
-                memset(&update_ctx, 0, sizeof(update_ctx));
-                update_ctx.world = world;
-                update_ctx.tick = tick;
-                update_ctx.source_chunk_index = source_chunk_index;
-                update_ctx.source_entry = entry;
-                update_ctx.source_local_x = x;
-                update_ctx.source_local_y = y;
-                update_ctx.source_cell_index = index;
-                update_ctx.source_cell.x = (entry->chunk_x * world->chunk_width) + x;
-                update_ctx.source_cell.y = (entry->chunk_y * world->chunk_height) + y;
-                update_ctx.emit_cross_intents = emit_cross_intents;
-                update_ctx.task_output = task_output;
+    world->material_count = new_id;
+    *out_material_id = new_id;
+    return RG_STATUS_OK;
+}
 
-                instance_data = NULL;
-                if (material->instance_size > 0u) {
-                    instance_data = rg_chunk_instance_ptr(world, chunk, index, material);
-                }
+rg_status_t rg_chunk_load(rg_world_t* world, int32_t chunk_x, int32_t chunk_y)
+{
+    rg_chunk_t* chunk;
+    rg_status_t status;
+    int32_t block_x;
+    int32_t block_y;
+    uint32_t color;
+    uint32_t insert_index;
 
-                material->update_fn(
-                    &update_ctx,
-                    update_ctx.source_cell,
-                    material_id,
-                    instance_data,
-                    material->user_data);
+    if (world == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
+    }
+    if (rg_chunk_find_index(world, chunk_x, chunk_y) != UINT32_MAX) {
+        return RG_STATUS_ALREADY_EXISTS;
+    }
 
-                moved = update_ctx.changed;
-            } else if ((material->flags & RG_MATERIAL_GAS) != 0u) {
-                moved = rg_step_gas(
-                    world,
-                    source_chunk_index,
-                    entry,
-                    x,
-                    y,
-                    index,
-                    material_id,
-                    material,
-                    primary_left,
-                    emit_cross_intents,
-                    task_output);
-            } else if ((material->flags & RG_MATERIAL_LIQUID) != 0u) {
-                moved = rg_step_liquid(
-                    world,
-                    source_chunk_index,
-                    entry,
-                    x,
-                    y,
-                    index,
-                    material_id,
-                    material,
-                    primary_left,
-                    emit_cross_intents,
-                    task_output);
-            } else if ((material->flags & RG_MATERIAL_POWDER) != 0u) {
-                moved = rg_step_powder(
-                    world,
-                    source_chunk_index,
-                    entry,
-                    x,
-                    y,
-                    index,
-                    material_id,
-                    material,
-                    primary_left,
-                    emit_cross_intents,
-                    task_output);
-            }
+    status = rg_chunk_reserve(world, world->chunk_count + 1u);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
 
-            if (moved != 0u) {
-                changed = 1u;
-            }
-        }
+    rg_split_coord(chunk_x, world->checkerboard_block, &block_x, NULL);
+    rg_split_coord(chunk_y, world->checkerboard_block, &block_y, NULL);
+    color = ((uint32_t)block_x & 1u) | (((uint32_t)block_y & 1u) << 1u);
+    status = rg_chunk_list_reserve(world, &world->active_lists[color], world->chunk_count + 1u);
+    if (status != RG_STATUS_OK) {
+        return status;
     }
 
-    if (emit_cross_intents != 0u && task_output != NULL && task_output->intent_count > 0u) {
-        changed = 1u;
+    status = rg_chunk_create(world, &chunk);
+    if (status != RG_STATUS_OK) {
+        return status;
     }
 
-    if (chunk->live_cells == 0u) {
-        chunk->idle_steps = 0u;
-        rg_set_chunk_awake_for_mode(world, chunk, 0u, task_output);
-    } else if (changed != 0u) {
-        chunk->idle_steps = 0u;
-        rg_set_chunk_awake_for_mode(world, chunk, 1u, task_output);
-    } else {
-        if (chunk->idle_steps < UINT32_MAX) {
-            chunk->idle_steps += 1u;
-        }
-        if (chunk->idle_steps >= RG_CHUNK_SLEEP_TICKS) {
-            rg_set_chunk_awake_for_mode(world, chunk, 0u, task_output);
-        }
+    insert_index = rg_chunk_insert_index(world, chunk_x, chunk_y);
+    if (insert_index < world->chunk_count) {
+        memmove(
+            &world->chunks[insert_index + 1u],
+            &world->chunks[insert_index],
+            (size_t)(world->chunk_count - insert_index) * sizeof(*world->chunks));
     }
 
-    if (task_output != NULL) {
-        task_output->changed = changed;
-    }
-    return changed;
+    world->chunks[insert_index].chunk_x = chunk_x;
+    world->chunks[insert_index].chunk_y = chunk_y;
+    world->chunks[insert_index].chunk = chunk;
+    world->chunk_count += 1u;
+    chunk->color = (uint8_t)color;
+    rg_chunk_table_shifted(world, insert_index, 1);
+    rg_chunk_link_neighbors(world, &world->chunks[insert_index]);
+    rg_chunk_update_lod(world, &world->chunks[insert_index]);
+
+    /* Fresh empty space along every edge can unblock sleeping neighbors. */
+    chunk->border_dirty = UINT8_MAX;
+    rg_chunk_flush_border(world, chunk);
+    return RG_STATUS_OK;
 }
 
-static rg_status_t rg_step_full_scan_serial(rg_world_t* world, uint64_t tick)
+rg_status_t rg_chunk_unload(rg_world_t* world, int32_t chunk_x, int32_t chunk_y)
 {
-    uint32_t i;
+    uint32_t index;
+    rg_chunk_t* chunk;
 
     if (world == NULL) {
         return RG_STATUS_INVALID_ARGUMENT;
     }
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
+    }
 
-    rg_prepare_step_masks(world);
+    index = rg_chunk_find_index(world, chunk_x, chunk_y);
+    if (index == UINT32_MAX) {
+        return RG_STATUS_NOT_FOUND;
+    }
 
-    for (i = 0u; i < world->chunk_count; ++i) {
-        (void)rg_step_chunk_serial(world, i, tick, 0u, NULL);
+    chunk = world->chunks[index].chunk;
+    if (chunk != NULL) {
+        if (world->live_cells >= chunk->live_cells) {
+            world->live_cells -= chunk->live_cells;
+        } else {
+            world->live_cells = 0u;
+        }
+        rg_active_list_remove(world, chunk);
+        rg_chunk_unlink_neighbors(chunk);
+        rg_chunk_destroy(world, chunk);
     }
 
+    if (index + 1u < world->chunk_count) {
+        memmove(
+            &world->chunks[index],
+            &world->chunks[index + 1u],
+            (size_t)(world->chunk_count - index - 1u) * sizeof(*world->chunks));
+    }
+    world->chunk_count -= 1u;
+    rg_chunk_table_shifted(world, index, -1);
     return RG_STATUS_OK;
 }
 
-static rg_status_t rg_step_chunk_scan_serial(rg_world_t* world, uint64_t tick)
+rg_status_t rg_cell_get(
+    const rg_world_t* world,
+    rg_cell_coord_t cell,
+    rg_cell_read_t* out_cell)
 {
-    uint32_t i;
+    rg_status_t status;
+    uint32_t chunk_index;
+    uint32_t cell_index;
+    const rg_chunk_t* chunk;
+    rg_material_id_t material_id;
+    const rg_material_record_t* material;
 
-    if (world == NULL) {
+    if (world == NULL || out_cell == NULL) {
         return RG_STATUS_INVALID_ARGUMENT;
     }
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
+    }
 
-    rg_prepare_step_masks(world);
+    status = rg_locate_cell(world, cell, &chunk_index, &cell_index);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
 
-    for (i = 0u; i < world->chunk_count; ++i) {
-        rg_chunk_t* chunk;
+    chunk = world->chunks[chunk_index].chunk;
+    material_id = chunk->material_ids[cell_index];
 
-        chunk = world->chunks[i].chunk;
-        if (chunk == NULL || chunk->awake == 0u) {
-            continue;
-        }
-        (void)rg_step_chunk_serial(world, i, tick, 0u, NULL);
+    out_cell->material_id = material_id;
+    out_cell->instance_data = NULL;
+    if (material_id == 0u) {
+        return RG_STATUS_OK;
+    }
+
+    material = rg_material_get(world, material_id);
+    if (material == NULL) {
+        return RG_STATUS_NOT_FOUND;
+    }
+    if (material->instance_size > 0u) {
+        out_cell->instance_data = rg_chunk_instance_ptr_const(world, chunk, cell_index, material);
     }
 
     return RG_STATUS_OK;
 }
 
-static uint8_t rg_has_parallel_runner(const rg_world_t* world)
+rg_status_t rg_cell_set(
+    rg_world_t* world,
+    rg_cell_coord_t cell,
+    const rg_cell_write_t* value)
 {
-    if (world == NULL || world->runner == NULL || world->runner->vtable == NULL) {
-        return 0u;
+    rg_status_t status;
+    uint32_t chunk_index;
+    uint32_t cell_index;
+    rg_chunk_t* chunk;
+    rg_material_id_t old_material_id;
+    rg_material_id_t new_material_id;
+    const rg_material_record_t* old_material;
+    const rg_material_record_t* new_material;
+
+    if (world == NULL || value == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
+    }
+    if (value->material_id == 0u) {
+        return rg_cell_clear(world, cell);
     }
-    return (uint8_t)(world->runner->vtable->parallel_for != NULL);
-}
 
-static void rg_checkerboard_task_callback(uint32_t task_index, uint32_t worker_index, void* user_data)
-{
-    rg_checkerboard_task_ctx_t* ctx;
+    new_material = rg_material_get(world, value->material_id);
+    if (new_material == NULL) {
+        return RG_STATUS_NOT_FOUND;
+    }
 
-    (void)worker_index;
+    status = rg_locate_cell(world, cell, &chunk_index, &cell_index);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
 
-    ctx = (rg_checkerboard_task_ctx_t*)user_data;
-    if (ctx == NULL || task_index >= ctx->chunk_count || ctx->outputs == NULL) {
-        return;
+    chunk = world->chunks[chunk_index].chunk;
+    old_material_id = chunk->material_ids[cell_index];
+    new_material_id = value->material_id;
+
+    old_material = rg_material_get(world, old_material_id);
+    if (old_material != NULL) {
+        rg_release_cell_instance(world, chunk, cell_index, old_material, NULL);
     }
 
-    (void)rg_step_chunk_serial(
-        ctx->world,
-        ctx->chunk_indices[task_index],
-        ctx->tick,
-        1u,
-        &ctx->outputs[task_index]);
+    status = rg_write_cell_instance(world, chunk, cell_index, new_material, value->instance_data, NULL);
+    if (status != RG_STATUS_OK) {
+        if (old_material_id != 0u) {
+            chunk->material_ids[cell_index] = 0u;
+            rg_update_live_counts(world, chunk, old_material_id, 0u, NULL);
+            rg_chunk_mark_border(world, chunk, cell_index);
+        }
+        return status;
+    }
+
+    chunk->material_ids[cell_index] = new_material_id;
+    rg_update_live_counts(world, chunk, old_material_id, new_material_id, NULL);
+    chunk->idle_steps = 0u;
+    rg_chunk_set_awake(world, chunk, (uint8_t)(chunk->live_cells > 0u));
+    rg_chunk_mark_border(world, chunk, cell_index);
+    return RG_STATUS_OK;
 }
 
-static rg_status_t rg_execute_checkerboard_phase(
-    rg_world_t* world,
-    uint64_t tick,
-    uint32_t color_x,
-    uint32_t color_y)
+rg_status_t rg_cell_clear(rg_world_t* world, rg_cell_coord_t cell)
 {
-    uint32_t* chunk_indices;
-    rg_task_output_t* outputs;
-    rg_checkerboard_task_ctx_t task_ctx;
-    uint32_t task_count;
-    uint32_t i;
     rg_status_t status;
+    uint32_t chunk_index;
+    uint32_t cell_index;
+    rg_chunk_t* chunk;
+    rg_material_id_t old_material_id;
+    const rg_material_record_t* old_material;
 
     if (world == NULL) {
         return RG_STATUS_INVALID_ARGUMENT;
     }
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
+    }
 
-    chunk_indices = NULL;
-    outputs = NULL;
-    task_count = 0u;
-    status = RG_STATUS_OK;
+    status = rg_locate_cell(world, cell, &chunk_index, &cell_index);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
 
-    if (world->chunk_count > 0u) {
-        chunk_indices = (uint32_t*)malloc((size_t)world->chunk_count * sizeof(*chunk_indices));
-        if (chunk_indices == NULL) {
-            return RG_STATUS_ALLOCATION_FAILED;
-        }
+    chunk = world->chunks[chunk_index].chunk;
+    old_material_id = chunk->material_ids[cell_index];
+    if (old_material_id == 0u) {
+        return RG_STATUS_OK;
     }
 
-    for (i = 0u; i < world->chunk_count; ++i) {
-        rg_chunk_entry_t* entry;
-        rg_chunk_t* chunk;
-        uint32_t x_parity;
-        uint32_t y_parity;
+    old_material = rg_material_get(world, old_material_id);
+    if (old_material != NULL) {
+        rg_release_cell_instance(world, chunk, cell_index, old_material, NULL);
+    }
 
-        entry = &world->chunks[i];
-        chunk = entry->chunk;
-        if (chunk == NULL || chunk->live_cells == 0u || chunk->awake == 0u) {
-            continue;
-        }
+    chunk->material_ids[cell_index] = 0u;
+    rg_update_live_counts(world, chunk, old_material_id, 0u, NULL);
+    rg_chunk_mark_border(world, chunk, cell_index);
+    return RG_STATUS_OK;
+}
 
-        x_parity = ((uint32_t)entry->chunk_x) & 1u;
-        y_parity = ((uint32_t)entry->chunk_y) & 1u;
-        if (x_parity != color_x || y_parity != color_y) {
-            continue;
-        }
+static void rg_reset_step_stats(rg_world_t* world)
+{
+    world->intents_emitted_last_step = 0u;
+    world->intent_conflicts_last_step = 0u;
+    world->cross_intents_last_step = 0u;
+    world->chunk_wakes_last_step = 0u;
+    world->chunk_sleeps_last_step = 0u;
+    world->lod_skipped_chunks_last_step = 0u;
+    world->budget_deferred_chunks_last_step = 0u;
+    world->step_setup_ns_last_step = 0u;
+    world->step_simulate_ns_last_step = 0u;
+}
 
-        chunk_indices[task_count] = i;
-        task_count += 1u;
-    }
+static rg_status_t rg_resolve_step_options(
+    const rg_world_t* world,
+    const rg_step_options_t* options,
+    rg_step_mode_t* out_mode,
+    uint32_t* out_substeps)
+{
+    rg_step_mode_t mode;
+    uint32_t substeps;
 
-    if (task_count == 0u) {
-        free(chunk_indices);
-        return RG_STATUS_OK;
+    mode = world->default_step_mode;
+    substeps = 1u;
+    if (options != NULL) {
+        mode = options->mode;
+        if (options->substeps > 0u) {
+            substeps = options->substeps;
+        }
     }
 
-    outputs = (rg_task_output_t*)calloc((size_t)task_count, sizeof(*outputs));
-    if (outputs == NULL) {
-        free(chunk_indices);
-        return RG_STATUS_ALLOCATION_FAILED;
+    if ((uint32_t)mode > (uint32_t)RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC &&
+        (world->deterministic_mode != 0u || world->chunk_width < 2 || world->chunk_height < 2 ||
+         RG_HAVE_ATOMICS == 0)) {
+        return RG_STATUS_UNSUPPORTED;
+    }
+    if (mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO && (world->chunk_width < 2 || world->chunk_height < 2)) {
+        return RG_STATUS_UNSUPPORTED;
     }
 
-    memset(&task_ctx, 0, sizeof(task_ctx));
-    task_ctx.world = world;
-    task_ctx.tick = tick;
-    task_ctx.chunk_indices = chunk_indices;
-    task_ctx.chunk_count = task_count;
-    task_ctx.outputs = outputs;
+    *out_mode = mode;
+    *out_substeps = substeps;
+    return RG_STATUS_OK;
+}
 
-    if (rg_has_parallel_runner(world) != 0u) {
-        status = world->runner->vtable->parallel_for(
-            world->runner->user,
-            task_count,
-            rg_checkerboard_task_callback,
-            &task_ctx);
-    } else {
-        for (i = 0u; i < task_count; ++i) {
-            rg_checkerboard_task_callback(i, 0u, &task_ctx);
+static rg_status_t rg_world_step_run(rg_world_t* world, rg_step_mode_t mode, uint32_t substeps)
+{
+    uint32_t substep_index;
+    rg_status_t status;
+
+    rg_reset_step_stats(world);
+
+    for (substep_index = 0u; substep_index < substeps; ++substep_index) {
+        uint64_t tick;
+
+        tick = world->step_index + (uint64_t)substep_index + 1u;
+        world->step_tick = tick;
+        switch (mode) {
+        case RG_STEP_MODE_FULL_SCAN_SERIAL:
+            status = rg_step_full_scan_serial(world, tick);
+            break;
+        case RG_STEP_MODE_CHUNK_SCAN_SERIAL:
+            status = rg_step_chunk_scan_serial(world, tick);
+            break;
+        case RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL:
+            status = rg_step_checkerboard_parallel(world, tick, RG_REMOTE_COMMIT_INTENTS);
+            break;
+        case RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC:
+            status = rg_step_checkerboard_parallel(world, tick, RG_REMOTE_COMMIT_ATOMIC);
+            break;
+        case RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO:
+            status = rg_step_checkerboard_parallel(world, tick, RG_REMOTE_COMMIT_HALO);
+            break;
+        case RG_STEP_MODE_TILE_CHECKERBOARD_PARALLEL:
+            status = rg_step_tile_checkerboard(world, tick);
+            break;
+        default:
+            status = RG_STATUS_INVALID_ARGUMENT;
+            break;
         }
-    }
 
-    if (status == RG_STATUS_OK) {
-        for (i = 0u; i < task_count; ++i) {
-            world->intents_emitted_last_step += outputs[i].emitted_move_count;
+        if (status != RG_STATUS_OK) {
+            return status;
         }
-        status = rg_merge_cross_intents(world, outputs, task_count);
-        rg_recompute_active_chunk_count(world);
-    } else {
-        rg_recompute_active_chunk_count(world);
     }
 
-    for (i = 0u; i < task_count; ++i) {
-        rg_task_output_release(&outputs[i]);
-    }
-    free(outputs);
-    free(chunk_indices);
-    return status;
+    world->step_index += (uint64_t)substeps;
+    return RG_STATUS_OK;
 }
 
-static rg_status_t rg_step_checkerboard_parallel(rg_world_t* world, uint64_t tick)
+rg_status_t rg_world_step(rg_world_t* world, const rg_step_options_t* options)
 {
-    uint32_t color_index;
+    rg_step_mode_t mode;
+    uint32_t substeps;
     rg_status_t status;
 
     if (world == NULL) {
         return RG_STATUS_INVALID_ARGUMENT;
     }
-
-    rg_prepare_step_masks(world);
-
-    for (color_index = 0u; color_index < 4u; ++color_index) {
-        uint32_t color_x;
-        uint32_t color_y;
-
-        color_x = color_index & 1u;
-        color_y = (color_index >> 1u) & 1u;
-
-        status = rg_execute_checkerboard_phase(world, tick, color_x, color_y);
-        if (status != RG_STATUS_OK) {
-            return status;
-        }
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
     }
 
-    return RG_STATUS_OK;
+    status = rg_resolve_step_options(world, options, &mode, &substeps);
+    if (status != RG_STATUS_OK) {
+        return status;
+    }
+    return rg_world_step_run(world, mode, substeps);
 }
 
-rg_status_t rg_world_create(const rg_world_config_t* cfg, rg_world_t** out_world)
+static void rg_world_step_async_job(void* user_data)
 {
-    rg_world_config_t resolved_cfg;
-    rg_allocator_t allocator;
     rg_world_t* world;
-    size_t material_capacity;
-    rg_status_t status;
 
-    if (out_world == NULL) {
-        return RG_STATUS_INVALID_ARGUMENT;
-    }
-    *out_world = NULL;
+    world = (rg_world_t*)user_data;
+    world->async_status = rg_world_step_run(world, world->async_mode, world->async_substeps);
+}
 
-    memset(&resolved_cfg, 0, sizeof(resolved_cfg));
-    if (cfg != NULL) {
-        resolved_cfg = *cfg;
+static uint8_t rg_has_async_runner(const rg_world_t* world)
+{
+    if (world->runner == NULL || world->runner->vtable == NULL) {
+        return 0u;
     }
+    return (uint8_t)(world->runner->vtable->submit != NULL && world->runner->vtable->wait != NULL);
+}
 
-    if (resolved_cfg.chunk_width == 0) {
-        resolved_cfg.chunk_width = RG_DEFAULT_CHUNK_WIDTH;
-    }
-    if (resolved_cfg.chunk_height == 0) {
-        resolved_cfg.chunk_height = RG_DEFAULT_CHUNK_HEIGHT;
-    }
-    if (resolved_cfg.inline_payload_bytes == 0u) {
-        resolved_cfg.inline_payload_bytes = RG_DEFAULT_INLINE_PAYLOAD_BYTES;
-    }
-    if (resolved_cfg.max_materials == 0u) {
-        resolved_cfg.max_materials = RG_DEFAULT_MAX_MATERIALS;
-    }
-    if (resolved_cfg.initial_chunk_capacity == 0u) {
-        resolved_cfg.initial_chunk_capacity = RG_DEFAULT_INITIAL_CHUNKS;
-    }
+rg_status_t rg_world_step_begin(rg_world_t* world, const rg_step_options_t* options)
+{
+    rg_status_t status;
 
-    if (resolved_cfg.chunk_width <= 0 || resolved_cfg.chunk_height <= 0) {
-        return RG_STATUS_INVALID_ARGUMENT;
-    }
-    if ((uint32_t)resolved_cfg.default_step_mode > (uint32_t)RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL) {
+    if (world == NULL) {
         return RG_STATUS_INVALID_ARGUMENT;
     }
-    if ((uint64_t)resolved_cfg.chunk_width * (uint64_t)resolved_cfg.chunk_height > UINT32_MAX) {
-        return RG_STATUS_CAPACITY_REACHED;
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
     }
 
-    status = rg_prepare_allocator(&resolved_cfg.allocator, &allocator);
+    status = rg_resolve_step_options(world, options, &world->async_mode, &world->async_substeps);
     if (status != RG_STATUS_OK) {
         return status;
     }
 
-    world = (rg_world_t*)rg_alloc_bytes(&allocator, sizeof(*world), _Alignof(rg_world_t));
-    if (world == NULL) {
-        return RG_STATUS_ALLOCATION_FAILED;
+    world->step_in_flight = 1u;
+    if (rg_has_async_runner(world) == 0u) {
+        rg_world_step_async_job(world);
+        return RG_STATUS_OK;
     }
-    memset(world, 0, sizeof(*world));
-
-    world->allocator = allocator;
-    world->runner = resolved_cfg.runner;
-    world->default_step_mode = resolved_cfg.default_step_mode;
-    world->deterministic_seed = resolved_cfg.deterministic_seed;
-    world->deterministic_mode = resolved_cfg.deterministic_mode;
-    world->chunk_width = resolved_cfg.chunk_width;
-    world->chunk_height = resolved_cfg.chunk_height;
-    world->cells_per_chunk = (uint32_t)((uint64_t)resolved_cfg.chunk_width * (uint64_t)resolved_cfg.chunk_height);
-    world->inline_payload_bytes = resolved_cfg.inline_payload_bytes;
-    world->max_materials = resolved_cfg.max_materials;
 
-    if (world->inline_payload_bytes > 0u) {
-        world->swap_payload = (uint8_t*)rg_alloc_bytes(
-            &world->allocator,
-            (size_t)world->inline_payload_bytes,
-            1u);
-        if (world->swap_payload == NULL) {
-            rg_free_bytes(&world->allocator, world, sizeof(*world), _Alignof(rg_world_t));
-            return RG_STATUS_ALLOCATION_FAILED;
-        }
-        memset(world->swap_payload, 0, (size_t)world->inline_payload_bytes);
+    world->async_status = RG_STATUS_OK;
+    status = world->runner->vtable->submit(world->runner->user, rg_world_step_async_job, world);
+    if (status != RG_STATUS_OK) {
+        world->step_in_flight = 0u;
     }
+    return status;
+}
 
-    material_capacity = ((size_t)world->max_materials + 1u) * sizeof(*world->materials);
-    world->materials = (rg_material_record_t*)rg_alloc_bytes(
-        &world->allocator,
-        material_capacity,
-        _Alignof(rg_material_record_t));
-    if (world->materials == NULL) {
-        rg_free_bytes(&world->allocator, world->swap_payload, (size_t)world->inline_payload_bytes, 1u);
-        rg_free_bytes(&world->allocator, world, sizeof(*world), _Alignof(rg_world_t));
-        return RG_STATUS_ALLOCATION_FAILED;
+rg_status_t rg_world_step_wait(rg_world_t* world)
+{
+    if (world == NULL || world->step_in_flight == 0u) {
+        return RG_STATUS_INVALID_ARGUMENT;
     }
-    memset(world->materials, 0, material_capacity);
 
-    status = rg_chunk_reserve(world, resolved_cfg.initial_chunk_capacity);
-    if (status != RG_STATUS_OK) {
-        rg_free_bytes(&world->allocator, world->materials, material_capacity, _Alignof(rg_material_record_t));
-        rg_free_bytes(&world->allocator, world->swap_payload, (size_t)world->inline_payload_bytes, 1u);
-        rg_free_bytes(&world->allocator, world, sizeof(*world), _Alignof(rg_world_t));
-        return status;
+    if (rg_has_async_runner(world) != 0u) {
+        world->runner->vtable->wait(world->runner->user);
     }
-
-    *out_world = world;
-    return RG_STATUS_OK;
+    world->step_in_flight = 0u;
+    return world->async_status;
 }
 
-void rg_world_destroy(rg_world_t* world)
+static rg_remote_commit_t rg_remote_commit_for_mode(rg_step_mode_t mode)
 {
-    size_t material_capacity;
-    uint32_t i;
-
-    if (world == NULL) {
-        return;
+    if (mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC) {
+        return RG_REMOTE_COMMIT_ATOMIC;
     }
-
-    for (i = 0u; i < world->chunk_count; ++i) {
-        rg_chunk_destroy(world, world->chunks[i].chunk);
+    if (mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO) {
+        return RG_REMOTE_COMMIT_HALO;
     }
-    rg_free_bytes(
-        &world->allocator,
-        world->chunks,
-        (size_t)world->chunk_capacity * sizeof(*world->chunks),
-        _Alignof(rg_chunk_entry_t));
+    return RG_REMOTE_COMMIT_INTENTS;
+}
 
-    for (i = 1u; i <= world->material_count; ++i) {
-        if (world->materials[i].used != 0u && world->materials[i].name != NULL) {
-            size_t name_len;
-            name_len = strlen(world->materials[i].name) + 1u;
-            rg_free_bytes(&world->allocator, world->materials[i].name, name_len, 1u);
+static uint8_t rg_batch_mode_is_flattened(rg_step_mode_t mode)
+{
+    return (uint8_t)(mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL ||
+                     mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC ||
+                     mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO);
+}
+
+/* Maps a shared task index to the world whose range [batch_task_begin, +task_count) holds it. */
+static void rg_batch_task_callback(uint32_t task_index, uint32_t worker_index, void* user_data)
+{
+    const rg_batch_task_ctx_t* ctx;
+    uint32_t lo;
+    uint32_t hi;
+
+    ctx = (const rg_batch_task_ctx_t*)user_data;
+    lo = 0u;
+    hi = ctx->world_count;
+    while (hi - lo > 1u) {
+        uint32_t mid;
+
+        mid = lo + ((hi - lo) / 2u);
+        if (ctx->worlds[mid]->batch_task_begin <= task_index) {
+            lo = mid;
+        } else {
+            hi = mid;
         }
     }
 
-    material_capacity = ((size_t)world->max_materials + 1u) * sizeof(*world->materials);
-    rg_free_bytes(&world->allocator, world->materials, material_capacity, _Alignof(rg_material_record_t));
-    rg_free_bytes(&world->allocator, world->swap_payload, (size_t)world->inline_payload_bytes, 1u);
-    rg_free_bytes(&world->allocator, world, sizeof(*world), _Alignof(rg_world_t));
+    rg_checkerboard_task_callback(
+        task_index - ctx->worlds[lo]->batch_task_begin,
+        worker_index,
+        &ctx->worlds[lo]->batch_phase);
 }
 
-rg_status_t rg_material_register(
-    rg_world_t* world,
-    const rg_material_desc_t* desc,
-    rg_material_id_t* out_material_id)
+/*
+ * One color phase across every flattened world: each prepares its phase, all
+ * tasks go out in one dispatch, then each world finishes and merges on its own.
+ * Worlds with no tasks get an empty range so the index search skips them.
+ */
+static void rg_batch_run_phase(rg_world_t* const* worlds, uint32_t world_count, uint32_t substep_index, uint32_t color)
 {
-    rg_material_id_t new_id;
-    rg_material_record_t* record;
-    uint16_t instance_align;
+    const rg_runner_t* runner;
+    rg_batch_task_ctx_t batch_ctx;
+    uint32_t total_tasks;
     uint32_t i;
+    rg_status_t status;
 
-    if (world == NULL || desc == NULL || out_material_id == NULL || desc->name == NULL || desc->name[0] == '\0') {
-        return RG_STATUS_INVALID_ARGUMENT;
-    }
-    if (world->material_count >= world->max_materials) {
-        return RG_STATUS_CAPACITY_REACHED;
-    }
+    runner = worlds[0]->runner;
+    total_tasks = 0u;
+    for (i = 0u; i < world_count; ++i) {
+        rg_world_t* world;
+        uint32_t chunk_count;
+        uint64_t tick;
 
-    for (i = 1u; i <= world->material_count; ++i) {
-        if (world->materials[i].used != 0u && strcmp(world->materials[i].name, desc->name) == 0) {
-            return RG_STATUS_ALREADY_EXISTS;
+        world = worlds[i];
+        world->batch_task_begin = total_tasks;
+        world->batch_phase.task_count = 0u;
+        if (rg_batch_mode_is_flattened(world->batch_mode) == 0u || world->batch_status != RG_STATUS_OK) {
+            continue;
         }
-    }
 
-    instance_align = desc->instance_align;
-    if (instance_align == 0u) {
-        instance_align = 1u;
+        tick = world->step_index + (uint64_t)substep_index + 1u;
+        world->step_tick = tick;
+        status = rg_select_checkerboard_chunks(world, tick, color, &chunk_count);
+        if (status == RG_STATUS_OK && chunk_count > 0u) {
+            status = rg_prepare_checkerboard_phase(
+                world,
+                tick,
+                world->scratch_chunk_indices,
+                chunk_count,
+                NULL,
+                rg_remote_commit_for_mode(world->batch_mode),
+                &world->batch_phase);
+        }
+        if (status != RG_STATUS_OK) {
+            world->batch_status = status;
+            world->batch_phase.task_count = 0u;
+            continue;
+        }
+        total_tasks += world->batch_phase.task_count;
     }
-    if (!rg_is_power_of_two_u32(instance_align)) {
-        return RG_STATUS_INVALID_ARGUMENT;
+    if (total_tasks == 0u) {
+        return;
     }
 
-    new_id = world->material_count + 1u;
-    record = &world->materials[new_id];
-    memset(record, 0, sizeof(*record));
-
-    record->name = rg_strdup_with_allocator(&world->allocator, desc->name);
-    if (record->name == NULL) {
-        return RG_STATUS_ALLOCATION_FAILED;
+    memset(&batch_ctx, 0, sizeof(batch_ctx));
+    batch_ctx.worlds = worlds;
+    batch_ctx.world_count = world_count;
+    status = RG_STATUS_OK;
+    if (runner != NULL && runner->vtable != NULL && runner->vtable->parallel_for != NULL) {
+        status = runner->vtable->parallel_for(runner->user, total_tasks, rg_batch_task_callback, &batch_ctx);
+    } else {
+        for (i = 0u; i < total_tasks; ++i) {
+            rg_batch_task_callback(i, 0u, &batch_ctx);
+        }
     }
 
-    record->flags = desc->flags;
-    record->density = desc->density;
-    record->friction = desc->friction;
-    record->dispersion = desc->dispersion;
-    record->instance_size = desc->instance_size;
-    record->instance_align = instance_align;
-    record->instance_ctor = desc->instance_ctor;
-    record->instance_dtor = desc->instance_dtor;
-    record->instance_move = desc->instance_move;
-    record->update_fn = desc->update_fn;
-    record->user_data = desc->user_data;
-    record->used = 1u;
+    for (i = 0u; i < world_count; ++i) {
+        rg_world_t* world;
+        rg_status_t finish_status;
 
-    world->material_count = new_id;
-    *out_material_id = new_id;
-    return RG_STATUS_OK;
+        world = worlds[i];
+        if (world->batch_phase.task_count == 0u) {
+            continue;
+        }
+        finish_status = rg_finish_checkerboard_phase(world, &world->batch_phase, status, NULL);
+        if (finish_status != RG_STATUS_OK) {
+            world->batch_status = finish_status;
+        }
+    }
 }
 
-rg_status_t rg_chunk_load(rg_world_t* world, int32_t chunk_x, int32_t chunk_y)
+rg_status_t rg_world_step_batch(rg_world_t* const* worlds, uint32_t world_count, const rg_step_options_t* options)
 {
-    rg_chunk_t* chunk;
+    uint32_t substeps;
+    uint32_t substep_index;
+    uint32_t color;
+    uint32_t i;
     rg_status_t status;
-    uint32_t insert_index;
 
-    if (world == NULL) {
-        return RG_STATUS_INVALID_ARGUMENT;
-    }
-    if (rg_chunk_find_index(world, chunk_x, chunk_y) != UINT32_MAX) {
-        return RG_STATUS_ALREADY_EXISTS;
+    if (world_count == 0u) {
+        return RG_STATUS_OK;
     }
-
-    status = rg_chunk_reserve(world, world->chunk_count + 1u);
-    if (status != RG_STATUS_OK) {
-        return status;
+    if (worlds == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
     }
 
-    status = rg_chunk_create(world, &chunk);
-    if (status != RG_STATUS_OK) {
-        return status;
-    }
+    substeps = 1u;
+    status = RG_STATUS_OK;
+    for (i = 0u; i < world_count && status == RG_STATUS_OK; ++i) {
+        rg_world_t* world;
 
-    insert_index = rg_chunk_insert_index(world, chunk_x, chunk_y);
-    if (insert_index < world->chunk_count) {
-        memmove(
-            &world->chunks[insert_index + 1u],
-            &world->chunks[insert_index],
-            (size_t)(world->chunk_count - insert_index) * sizeof(*world->chunks));
+        world = worlds[i];
+        if (world == NULL || world->batch_member != 0u || world->runner != worlds[0]->runner) {
+            status = RG_STATUS_INVALID_ARGUMENT;
+        } else if (world->step_in_flight != 0u) {
+            status = RG_STATUS_CONFLICT;
+        } else {
+            status = rg_resolve_step_options(world, options, &world->batch_mode, &substeps);
+            world->batch_member = 1u;
+        }
     }
-
-    world->chunks[insert_index].chunk_x = chunk_x;
-    world->chunks[insert_index].chunk_y = chunk_y;
-    world->chunks[insert_index].chunk = chunk;
-    world->chunk_count += 1u;
-    return RG_STATUS_OK;
-}
-
-rg_status_t rg_chunk_unload(rg_world_t* world, int32_t chunk_x, int32_t chunk_y)
-{
-    uint32_t index;
-    rg_chunk_t* chunk;
-
-    if (world == NULL) {
-        return RG_STATUS_INVALID_ARGUMENT;
+    if (status != RG_STATUS_OK) {
+        /* Clears the marks made so far; clearing the failing entry as well is harmless. */
+        for (; i > 0u; --i) {
+            if (worlds[i - 1u] != NULL) {
+                worlds[i - 1u]->batch_member = 0u;
+            }
+        }
+        return status;
     }
 
-    index = rg_chunk_find_index(world, chunk_x, chunk_y);
-    if (index == UINT32_MAX) {
-        return RG_STATUS_NOT_FOUND;
-    }
+    for (i = 0u; i < world_count; ++i) {
+        rg_world_t* world;
 
-    chunk = world->chunks[index].chunk;
-    if (chunk != NULL) {
-        if (world->live_cells >= chunk->live_cells) {
-            world->live_cells -= chunk->live_cells;
+        world = worlds[i];
+        if (rg_batch_mode_is_flattened(world->batch_mode) != 0u) {
+            rg_reset_step_stats(world);
+            world->batch_status = RG_STATUS_OK;
         } else {
-            world->live_cells = 0u;
+            world->batch_status = rg_world_step_run(world, world->batch_mode, substeps);
         }
-        if (chunk->awake != 0u && world->active_chunk_count > 0u) {
-            world->active_chunk_count -= 1u;
+    }
+
+    for (substep_index = 0u; substep_index < substeps; ++substep_index) {
+        for (color = 0u; color < 4u; ++color) {
+            rg_batch_run_phase(worlds, world_count, substep_index, color);
         }
-        rg_chunk_destroy(world, chunk);
     }
 
-    if (index + 1u < world->chunk_count) {
-        memmove(
-            &world->chunks[index],
-            &world->chunks[index + 1u],
-            (size_t)(world->chunk_count - index - 1u) * sizeof(*world->chunks));
+    status = RG_STATUS_OK;
+    for (i = 0u; i < world_count; ++i) {
+        rg_world_t* world;
+
+        world = worlds[i];
+        world->batch_member = 0u;
+        if (world->batch_status != RG_STATUS_OK) {
+            if (status == RG_STATUS_OK) {
+                status = world->batch_status;
+            }
+            continue;
+        }
+        if (rg_batch_mode_is_flattened(world->batch_mode) != 0u) {
+            world->step_index += (uint64_t)substeps;
+        }
     }
-    world->chunk_count -= 1u;
-    return RG_STATUS_OK;
+    return status;
 }
 
-rg_status_t rg_cell_get(
-    const rg_world_t* world,
-    rg_cell_coord_t cell,
-    rg_cell_read_t* out_cell)
+static int rg_budget_key_compare(const void* lhs_void, const void* rhs_void)
 {
-    rg_status_t status;
-    uint32_t chunk_index;
-    uint32_t cell_index;
-    const rg_chunk_t* chunk;
-    rg_material_id_t material_id;
-    const rg_material_record_t* material;
+    const rg_budget_key_t* lhs;
+    const rg_budget_key_t* rhs;
 
-    if (world == NULL || out_cell == NULL) {
-        return RG_STATUS_INVALID_ARGUMENT;
+    lhs = (const rg_budget_key_t*)lhs_void;
+    rhs = (const rg_budget_key_t*)rhs_void;
+    if (lhs->deferred_age != rhs->deferred_age) {
+        return (lhs->deferred_age > rhs->deferred_age) ? -1 : 1;
     }
-
-    status = rg_locate_cell(world, cell, &chunk_index, &cell_index);
-    if (status != RG_STATUS_OK) {
-        return status;
+    if (lhs->priority != rhs->priority) {
+        return (lhs->priority > rhs->priority) ? -1 : 1;
+    }
+    if (lhs->focus_distance != rhs->focus_distance) {
+        return (lhs->focus_distance < rhs->focus_distance) ? -1 : 1;
+    }
+    if (lhs->chunk_index != rhs->chunk_index) {
+        return (lhs->chunk_index < rhs->chunk_index) ? -1 : 1;
     }
+    return 0;
+}
 
-    chunk = world->chunks[chunk_index].chunk;
-    material_id = chunk->material_ids[cell_index];
+/*
+ * Phases start at the color of the highest-priority chunk, which is then task 0
+ * of the first phase and always runs; that keeps the fairness guarantee. Within
+ * a phase tasks are dispatched in priority order and skip themselves once the
+ * deadline passes.
+ */
+static rg_status_t rg_step_budgeted_checkerboard(
+    rg_world_t* world,
+    uint64_t tick,
+    const rg_budget_key_t* keys,
+    uint32_t key_count,
+    rg_step_budget_t* budget,
+    uint32_t* chunk_indices,
+    uint32_t* out_stepped,
+    uint32_t* out_deferred)
+{
+    uint32_t first_color;
+    uint32_t phase;
+    uint32_t i;
+    rg_status_t status;
 
-    out_cell->material_id = material_id;
-    out_cell->instance_data = NULL;
-    if (material_id == 0u) {
+    if (key_count == 0u) {
         return RG_STATUS_OK;
     }
 
-    material = rg_material_get(world, material_id);
-    if (material == NULL) {
-        return RG_STATUS_NOT_FOUND;
-    }
-    if (material->instance_size > 0u) {
-        out_cell->instance_data = rg_chunk_instance_ptr_const(world, chunk, cell_index, material);
+    first_color = world->chunks[keys[0].chunk_index].chunk->color;
+    for (phase = 0u; phase < 4u; ++phase) {
+        uint32_t color;
+        uint32_t task_count;
+        uint32_t skipped;
+
+        color = (first_color + phase) & 3u;
+        task_count = 0u;
+        for (i = 0u; i < key_count; ++i) {
+            if (world->chunks[keys[i].chunk_index].chunk->color == color) {
+                chunk_indices[task_count] = keys[i].chunk_index;
+                task_count += 1u;
+            }
+        }
+        if (task_count == 0u) {
+            continue;
+        }
+
+        budget->run_first = (uint8_t)(*out_stepped == 0u);
+        status = rg_run_checkerboard_tasks(
+            world,
+            tick,
+            chunk_indices,
+            task_count,
+            (budget->deadline_ns != 0u) ? budget : NULL,
+            RG_REMOTE_COMMIT_INTENTS,
+            &skipped);
+        if (status != RG_STATUS_OK) {
+            return status;
+        }
+        *out_stepped += task_count - skipped;
+        *out_deferred += skipped;
     }
 
     return RG_STATUS_OK;
 }
 
-rg_status_t rg_cell_set(
+rg_status_t rg_world_step_budgeted(
     rg_world_t* world,
-    rg_cell_coord_t cell,
-    const rg_cell_write_t* value)
+    const rg_budget_step_options_t* options,
+    rg_budget_step_result_t* out_result)
 {
+    rg_budget_key_t* keys;
+    uint32_t* chunk_indices;
+    rg_step_budget_t budget;
+    uint32_t candidate_count;
+    uint32_t key_count;
+    uint32_t stepped;
+    uint32_t deferred;
+    uint32_t i;
+    uint64_t tick;
     rg_status_t status;
-    uint32_t chunk_index;
-    uint32_t cell_index;
-    rg_chunk_t* chunk;
-    rg_material_id_t old_material_id;
-    rg_material_id_t new_material_id;
-    const rg_material_record_t* old_material;
-    const rg_material_record_t* new_material;
 
-    if (world == NULL || value == NULL) {
+    if (world == NULL || options == NULL) {
         return RG_STATUS_INVALID_ARGUMENT;
     }
-    if (value->material_id == 0u) {
-        return rg_cell_clear(world, cell);
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
     }
-
-    new_material = rg_material_get(world, value->material_id);
-    if (new_material == NULL) {
-        return RG_STATUS_NOT_FOUND;
+    if ((uint32_t)options->mode > (uint32_t)RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO) {
+        return RG_STATUS_INVALID_ARGUMENT;
     }
-
-    status = rg_locate_cell(world, cell, &chunk_index, &cell_index);
-    if (status != RG_STATUS_OK) {
-        return status;
+    if (options->mode == RG_STEP_MODE_TILE_CHECKERBOARD_PARALLEL ||
+        options->mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC ||
+        options->mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO) {
+        return RG_STATUS_UNSUPPORTED;
     }
 
-    chunk = world->chunks[chunk_index].chunk;
-    old_material_id = chunk->material_ids[cell_index];
-    new_material_id = value->material_id;
+    memset(&budget, 0, sizeof(budget));
+    budget.clock_now_ns = (options->clock_now_ns != NULL) ? options->clock_now_ns : rg_default_clock_now_ns;
+    budget.clock_user = options->clock_user;
+    if (options->budget_ns > 0u) {
+        uint64_t now;
 
-    old_material = rg_material_get(world, old_material_id);
-    if (old_material != NULL) {
-        rg_release_cell_instance(world, chunk, cell_index, old_material);
+        now = budget.clock_now_ns(budget.clock_user);
+        budget.deadline_ns = (now > UINT64_MAX - options->budget_ns) ? UINT64_MAX : now + options->budget_ns;
     }
 
-    status = rg_write_cell_instance(world, chunk, cell_index, new_material, value->instance_data);
-    if (status != RG_STATUS_OK) {
-        if (old_material_id != 0u) {
-            chunk->material_ids[cell_index] = 0u;
-            rg_update_live_counts(world, chunk, old_material_id, 0u);
+    rg_reset_step_stats(world);
+
+    tick = world->step_index + 1u;
+    world->step_tick = tick;
+    stepped = 0u;
+    deferred = 0u;
+    status = RG_STATUS_OK;
+
+    candidate_count = (options->mode == RG_STEP_MODE_FULL_SCAN_SERIAL) ?
+        world->chunk_count :
+        world->active_chunk_count;
+    if (candidate_count > 0u) {
+        uint64_t setup_start_ns;
+        uint64_t simulate_start_ns;
+
+        setup_start_ns = rg_default_clock_now_ns(NULL);
+        status = rg_scratch_reserve_chunk_indices(world, candidate_count);
+        if (status == RG_STATUS_OK) {
+            status = rg_scratch_reserve(
+                world,
+                (void**)&world->scratch_budget_keys,
+                &world->scratch_budget_key_capacity,
+                candidate_count,
+                sizeof(*world->scratch_budget_keys),
+                _Alignof(rg_budget_key_t));
         }
-        return status;
-    }
+        if (status != RG_STATUS_OK) {
+            return status;
+        }
+        chunk_indices = world->scratch_chunk_indices;
+        keys = world->scratch_budget_keys;
 
-    chunk->material_ids[cell_index] = new_material_id;
-    rg_update_live_counts(world, chunk, old_material_id, new_material_id);
-    chunk->idle_steps = 0u;
-    rg_chunk_set_awake(world, chunk, (uint8_t)(chunk->live_cells > 0u));
-    return RG_STATUS_OK;
-}
+        if (options->mode == RG_STEP_MODE_FULL_SCAN_SERIAL) {
+            for (i = 0u; i < candidate_count; ++i) {
+                chunk_indices[i] = i;
+            }
+        } else {
+            candidate_count = rg_snapshot_active_chunks(world, 0u, 4u, chunk_indices);
+        }
 
-rg_status_t rg_cell_clear(rg_world_t* world, rg_cell_coord_t cell)
-{
-    rg_status_t status;
-    uint32_t chunk_index;
-    uint32_t cell_index;
-    rg_chunk_t* chunk;
-    rg_material_id_t old_material_id;
-    const rg_material_record_t* old_material;
+        key_count = 0u;
+        for (i = 0u; i < candidate_count; ++i) {
+            const rg_chunk_entry_t* entry;
 
-    if (world == NULL) {
-        return RG_STATUS_INVALID_ARGUMENT;
+            entry = &world->chunks[chunk_indices[i]];
+            if (entry->chunk == NULL) {
+                continue;
+            }
+            if (options->mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL && entry->chunk->live_cells == 0u) {
+                continue;
+            }
+            if (rg_chunk_due(entry, tick) == 0u) {
+                world->lod_skipped_chunks_last_step += 1u;
+                continue;
+            }
+
+            keys[key_count].deferred_age = entry->chunk->deferred_age;
+            keys[key_count].priority = entry->chunk->priority;
+            keys[key_count].focus_distance = entry->chunk->focus_distance;
+            keys[key_count].chunk_index = chunk_indices[i];
+            key_count += 1u;
+        }
+        if (key_count > 1u) {
+            qsort(keys, (size_t)key_count, sizeof(*keys), rg_budget_key_compare);
+        }
+        simulate_start_ns = rg_default_clock_now_ns(NULL);
+        world->step_setup_ns_last_step += rg_elapsed_ns(setup_start_ns, simulate_start_ns);
+
+        if (options->mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL) {
+            status = rg_step_budgeted_checkerboard(
+                world,
+                tick,
+                keys,
+                key_count,
+                &budget,
+                chunk_indices,
+                &stepped,
+                &deferred);
+        } else {
+            for (i = 0u; i < key_count; ++i) {
+                rg_chunk_t* chunk;
+
+                if (stepped > 0u &&
+                    budget.deadline_ns != 0u &&
+                    budget.clock_now_ns(budget.clock_user) >= budget.deadline_ns) {
+                    break;
+                }
+
+                chunk = world->chunks[keys[i].chunk_index].chunk;
+                if (options->mode == RG_STEP_MODE_CHUNK_SCAN_SERIAL && chunk->awake == 0u) {
+                    chunk->deferred_age = 0u;
+                    continue;
+                }
+                (void)rg_step_chunk_serial(world, keys[i].chunk_index, tick, 0u, NULL);
+                stepped += 1u;
+            }
+            for (; i < key_count; ++i) {
+                world->chunks[keys[i].chunk_index].chunk->deferred_age += 1u;
+                deferred += 1u;
+            }
+            world->step_simulate_ns_last_step += rg_elapsed_ns(simulate_start_ns, rg_default_clock_now_ns(NULL));
+        }
     }
 
-    status = rg_locate_cell(world, cell, &chunk_index, &cell_index);
     if (status != RG_STATUS_OK) {
         return status;
     }
 
-    chunk = world->chunks[chunk_index].chunk;
-    old_material_id = chunk->material_ids[cell_index];
-    if (old_material_id == 0u) {
-        return RG_STATUS_OK;
-    }
-
-    old_material = rg_material_get(world, old_material_id);
-    if (old_material != NULL) {
-        rg_release_cell_instance(world, chunk, cell_index, old_material);
+    world->budget_deferred_chunks_last_step = deferred;
+    world->step_index += 1u;
+    if (out_result != NULL) {
+        out_result->chunks_stepped = stepped;
+        out_result->chunks_deferred = deferred;
     }
-
-    chunk->material_ids[cell_index] = 0u;
-    rg_update_live_counts(world, chunk, old_material_id, 0u);
     return RG_STATUS_OK;
 }
 
-rg_status_t rg_world_step(rg_world_t* world, const rg_step_options_t* options)
+rg_status_t rg_chunk_set_priority(rg_world_t* world, int32_t chunk_x, int32_t chunk_y, int32_t priority)
 {
-    rg_step_mode_t mode;
-    uint32_t substeps;
-    uint32_t substep_index;
-    rg_status_t status;
+    uint32_t index;
 
     if (world == NULL) {
         return RG_STATUS_INVALID_ARGUMENT;
     }
-
-    mode = world->default_step_mode;
-    substeps = 1u;
-    if (options != NULL) {
-        mode = options->mode;
-        if (options->substeps > 0u) {
-            substeps = options->substeps;
-        }
-    }
-
-    if ((uint32_t)mode > (uint32_t)RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL) {
-        return RG_STATUS_INVALID_ARGUMENT;
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
     }
 
-    world->intents_emitted_last_step = 0u;
-    world->intent_conflicts_last_step = 0u;
-
-    for (substep_index = 0u; substep_index < substeps; ++substep_index) {
-        uint64_t tick;
-
-        tick = world->step_index + (uint64_t)substep_index + 1u;
-        switch (mode) {
-        case RG_STEP_MODE_FULL_SCAN_SERIAL:
-            status = rg_step_full_scan_serial(world, tick);
-            break;
-        case RG_STEP_MODE_CHUNK_SCAN_SERIAL:
-            status = rg_step_chunk_scan_serial(world, tick);
-            break;
-        case RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL:
-            status = rg_step_checkerboard_parallel(world, tick);
-            break;
-        default:
-            status = RG_STATUS_INVALID_ARGUMENT;
-            break;
-        }
-
-        if (status != RG_STATUS_OK) {
-            return status;
-        }
+    index = rg_chunk_find_index(world, chunk_x, chunk_y);
+    if (index == UINT32_MAX) {
+        return RG_STATUS_NOT_FOUND;
     }
 
-    world->step_index += (uint64_t)substeps;
+    world->chunks[index].chunk->priority = priority;
     return RG_STATUS_OK;
 }
 
@@ -2496,6 +6473,9 @@ rg_status_t rg_world_get_stats(const rg_world_t* world, rg_world_stats_t* out_st
     if (world == NULL || out_stats == NULL) {
         return RG_STATUS_INVALID_ARGUMENT;
     }
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
+    }
 
     memset(out_stats, 0, sizeof(*out_stats));
     out_stats->loaded_chunks = world->chunk_count;
@@ -2506,6 +6486,60 @@ rg_status_t rg_world_get_stats(const rg_world_t* world, rg_world_stats_t* out_st
     out_stats->intent_conflicts_last_step = world->intent_conflicts_last_step;
     out_stats->payload_overflow_allocs = world->payload_overflow_allocs;
     out_stats->payload_overflow_frees = world->payload_overflow_frees;
+    out_stats->chunk_wakes_last_step = world->chunk_wakes_last_step;
+    out_stats->chunk_sleeps_last_step = world->chunk_sleeps_last_step;
+    out_stats->chunk_wakes_total = world->chunk_wakes_total;
+    out_stats->chunk_sleeps_total = world->chunk_sleeps_total;
+    out_stats->lod_skipped_chunks_last_step = world->lod_skipped_chunks_last_step;
+    out_stats->budget_deferred_chunks_last_step = world->budget_deferred_chunks_last_step;
+    out_stats->step_setup_ns_last_step = world->step_setup_ns_last_step;
+    out_stats->step_simulate_ns_last_step = world->step_simulate_ns_last_step;
+    out_stats->step_scratch_allocs = world->step_scratch_allocs;
+    out_stats->cross_intents_last_step = world->cross_intents_last_step;
+    return RG_STATUS_OK;
+}
+
+rg_status_t rg_world_set_focus_points(rg_world_t* world, const rg_cell_coord_t* points, uint32_t count)
+{
+    rg_cell_coord_t* focus_chunks;
+    uint32_t i;
+
+    if (world == NULL || (count > 0u && points == NULL)) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+    if (world->step_in_flight != 0u) {
+        return RG_STATUS_CONFLICT;
+    }
+
+    focus_chunks = NULL;
+    if (count > 0u) {
+        focus_chunks = (rg_cell_coord_t*)rg_alloc_bytes(
+            &world->allocator,
+            (size_t)count * sizeof(*focus_chunks),
+            _Alignof(rg_cell_coord_t));
+        if (focus_chunks == NULL) {
+            return RG_STATUS_ALLOCATION_FAILED;
+        }
+
+        for (i = 0u; i < count; ++i) {
+            int32_t local;
+
+            rg_split_coord(points[i].x, world->chunk_width, &focus_chunks[i].x, &local);
+            rg_split_coord(points[i].y, world->chunk_height, &focus_chunks[i].y, &local);
+        }
+    }
+
+    rg_free_bytes(
+        &world->allocator,
+        world->focus_chunks,
+        (size_t)world->focus_count * sizeof(*world->focus_chunks),
+        _Alignof(rg_cell_coord_t));
+    world->focus_chunks = focus_chunks;
+    world->focus_count = count;
+
+    for (i = 0u; i < world->chunk_count; ++i) {
+        rg_chunk_update_lod(world, &world->chunks[i]);
+    }
     return RG_STATUS_OK;
 }
 
@@ -2563,16 +6597,12 @@ static rg_status_t rg_ctx_transform_current_cell(
     }
 
     if (new_material == 0u) {
-        rg_release_cell_instance(world, source_chunk, ctx->source_cell_index, old_material);
+        rg_release_cell_instance(world, source_chunk, ctx->source_cell_index, old_material, ctx->task_output);
         source_chunk->material_ids[ctx->source_cell_index] = 0u;
-        rg_update_live_counts(world, source_chunk, old_material_id, 0u);
-        source_chunk->idle_steps = 0u;
-        rg_set_chunk_awake_for_mode(
-            world,
-            source_chunk,
-            (uint8_t)(source_chunk->live_cells > 0u),
-            ctx->task_output);
-        rg_mask_set(source_chunk, ctx->source_cell_index);
+        rg_update_live_counts(world, source_chunk, old_material_id, 0u, ctx->task_output);
+        rg_chunk_note_activity(world, source_chunk, ctx->task_output);
+        rg_mask_set(world, source_chunk, ctx->source_cell_index);
+        rg_chunk_mark_border_for_mode(world, source_chunk, ctx->source_cell_index, ctx->task_output);
         return RG_STATUS_OK;
     }
 
@@ -2582,9 +6612,9 @@ static rg_status_t rg_ctx_transform_current_cell(
     }
 
     if (new_material != old_material_id) {
-        rg_release_cell_instance(world, source_chunk, ctx->source_cell_index, old_material);
+        rg_release_cell_instance(world, source_chunk, ctx->source_cell_index, old_material, ctx->task_output);
     } else if (new_instance_data == NULL) {
-        rg_mask_set(source_chunk, ctx->source_cell_index);
+        rg_mask_set(world, source_chunk, ctx->source_cell_index);
         return RG_STATUS_OK;
     }
 
@@ -2593,22 +6623,20 @@ static rg_status_t rg_ctx_transform_current_cell(
         source_chunk,
         ctx->source_cell_index,
         new_material_record,
-        new_instance_data);
+        new_instance_data,
+        ctx->task_output);
     if (status != RG_STATUS_OK) {
         source_chunk->material_ids[ctx->source_cell_index] = 0u;
-        rg_update_live_counts(world, source_chunk, old_material_id, 0u);
+        rg_update_live_counts(world, source_chunk, old_material_id, 0u, ctx->task_output);
+        rg_chunk_mark_border_for_mode(world, source_chunk, ctx->source_cell_index, ctx->task_output);
         return status;
     }
 
     source_chunk->material_ids[ctx->source_cell_index] = new_material;
-    rg_update_live_counts(world, source_chunk, old_material_id, new_material);
-    source_chunk->idle_steps = 0u;
-    rg_set_chunk_awake_for_mode(
-        world,
-        source_chunk,
-        (uint8_t)(source_chunk->live_cells > 0u),
-        ctx->task_output);
-    rg_mask_set(source_chunk, ctx->source_cell_index);
+    rg_update_live_counts(world, source_chunk, old_material_id, new_material, ctx->task_output);
+    rg_chunk_note_activity(world, source_chunk, ctx->task_output);
+    rg_mask_set(world, source_chunk, ctx->source_cell_index);
+    rg_chunk_mark_border_for_mode(world, source_chunk, ctx->source_cell_index, ctx->task_output);
     return RG_STATUS_OK;
 }
 
@@ -2760,9 +6788,6 @@ rg_status_t rg_ctx_try_swap(rg_update_ctx_t* ctx, rg_cell_coord_t a, rg_cell_coo
     if (status != RG_STATUS_OK) {
         return status;
     }
-    (void)target_local_x;
-    (void)target_local_y;
-
     target_chunk = target_entry->chunk;
     if (target_chunk == NULL) {
         return RG_STATUS_NOT_FOUND;
@@ -2780,12 +6805,36 @@ rg_status_t rg_ctx_try_swap(rg_update_ctx_t* ctx, rg_cell_coord_t a, rg_cell_coo
         return RG_STATUS_CONFLICT;
     }
 
-    if (ctx->emit_cross_intents != 0u && target_chunk_index != ctx->source_chunk_index) {
+    if (ctx->emit_cross_intents != 0u &&
+        rg_target_is_remote(
+            world,
+            ctx->task_output,
+            source_entry,
+            target_entry,
+            target_local_x,
+            target_local_y) != 0u) {
         rg_cross_intent_t intent;
 
         if (ctx->task_output == NULL) {
             return RG_STATUS_INVALID_ARGUMENT;
         }
+        if (ctx->task_output->remote_commit != (uint8_t)RG_REMOTE_COMMIT_INTENTS) {
+            if (rg_commit_remote_move(
+                    world,
+                    ctx->task_output,
+                    source_entry,
+                    ctx->source_cell_index,
+                    source_material_id,
+                    NULL,
+                    target_entry,
+                    target_index,
+                    target_material_id) == 0u) {
+                return RG_STATUS_CONFLICT;
+            }
+            ctx->operation_done = 1u;
+            ctx->changed = 1u;
+            return RG_STATUS_OK;
+        }
 
         intent.source_chunk_index = ctx->source_chunk_index;
         intent.target_chunk_index = target_chunk_index;
@@ -2802,19 +6851,12 @@ rg_status_t rg_ctx_try_swap(rg_update_ctx_t* ctx, rg_cell_coord_t a, rg_cell_coo
         source_chunk->material_ids[ctx->source_cell_index] = target_material_id;
         rg_payload_swap(world, source_chunk, ctx->source_cell_index, target_chunk, target_index);
 
-        source_chunk->idle_steps = 0u;
-        target_chunk->idle_steps = 0u;
-        rg_set_chunk_awake_for_mode(
-            world,
-            source_chunk,
-            (uint8_t)(source_chunk->live_cells > 0u),
-            ctx->task_output);
-        rg_set_chunk_awake_for_mode(
-            world,
-            target_chunk,
-            (uint8_t)(target_chunk->live_cells > 0u),
-            ctx->task_output);
-        rg_mask_set(target_chunk, target_index);
+        rg_chunk_note_activity(world, source_chunk, ctx->task_output);
+        rg_chunk_note_activity(world, target_chunk, ctx->task_output);
+        rg_mask_set(world, target_chunk, target_index);
+        rg_chunk_mark_border_for_mode(world, source_chunk, ctx->source_cell_index, ctx->task_output);
+        rg_chunk_mark_border_for_mode(world, target_chunk, target_index, ctx->task_output);
+        rg_task_output_note_block_move(ctx->task_output, source_entry, target_entry);
 
         if (ctx->task_output != NULL) {
             ctx->task_output->emitted_move_count += 1u;
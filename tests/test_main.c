@@ -1,6 +1,7 @@
 #include "regolith/regolith.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 
 #define ASSERT_TRUE(condition)                                                      \
@@ -52,6 +53,8 @@ typedef struct test_runner_state_s {
     uint32_t call_count;
     uint32_t total_task_count;
     uint32_t max_task_count;
+    uint32_t graph_call_count;
+    uint32_t graph_edge_count;
 } test_runner_state_t;
 
 static rg_status_t test_runner_parallel_for(
@@ -97,7 +100,68 @@ static uint32_t test_runner_worker_count(void* runner_user)
 
 static const rg_runner_vtable_t g_test_runner_vtable = {
     test_runner_parallel_for,
-    test_runner_worker_count
+    test_runner_worker_count,
+    NULL,
+    NULL,
+    NULL
+};
+
+/* Always runs the highest ready task next, so the order differs from index order. */
+static rg_status_t test_runner_run_graph(void* runner_user, const rg_task_graph_t* graph)
+{
+    test_runner_state_t* state;
+    uint32_t* pending;
+    uint32_t remaining;
+    uint32_t i;
+
+    if (graph == NULL || graph->task == NULL) {
+        return RG_STATUS_INVALID_ARGUMENT;
+    }
+
+    state = (test_runner_state_t*)runner_user;
+    if (state != NULL) {
+        state->graph_call_count += 1u;
+        state->graph_edge_count += graph->dependency_offsets[graph->task_count];
+    }
+
+    pending = (uint32_t*)calloc((size_t)graph->task_count + 1u, sizeof(*pending));
+    if (pending == NULL) {
+        return RG_STATUS_ALLOCATION_FAILED;
+    }
+    for (i = 0u; i < graph->task_count; ++i) {
+        pending[i] = graph->dependency_offsets[i + 1u] - graph->dependency_offsets[i];
+    }
+
+    for (remaining = graph->task_count; remaining > 0u; --remaining) {
+        uint32_t edge;
+
+        i = graph->task_count;
+        while (i > 0u && pending[i - 1u] != 0u) {
+            i -= 1u;
+        }
+        if (i == 0u) {
+            free(pending);
+            return RG_STATUS_INVALID_ARGUMENT;
+        }
+        i -= 1u;
+
+        pending[i] = UINT32_MAX;
+        graph->task(i, i % 4u, graph->task_user_data);
+        for (edge = graph->successor_offsets[i]; edge < graph->successor_offsets[i + 1u]; ++edge) {
+            pending[graph->successors[edge]] -= 1u;
+        }
+    }
+
+    free(pending);
+    return RG_STATUS_OK;
+}
+
+static const rg_runner_vtable_t g_test_graph_runner_vtable = {
+    test_runner_parallel_for,
+    test_runner_worker_count,
+    NULL,
+    NULL,
+    test_runner_run_graph
 };
 
 typedef struct test_custom_move_user_s {
@@ -502,6 +566,44 @@ static int test_powder_falls_in_full_scan(void)
     return 0;
 }
 
+static int test_powder_falls_one_cell_per_substep(void)
+{
+    rg_world_t* world;
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_cell_write_t write;
+    rg_cell_read_t read;
+    rg_step_options_t step_options;
+    int32_t y;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 8;
+    cfg.chunk_height = 8;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 8u;
+    ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+
+    ASSERT_TRUE(register_simple_material(world, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_STATUS(rg_chunk_load(world, 0, 0), RG_STATUS_OK);
+
+    memset(&write, 0, sizeof(write));
+    write.material_id = sand_id;
+    ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){3, 0}, &write), RG_STATUS_OK);
+
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = RG_STEP_MODE_CHUNK_SCAN_SERIAL;
+    step_options.substeps = 3u;
+    ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+
+    for (y = 0; y < 8; ++y) {
+        ASSERT_STATUS(rg_cell_get(world, (rg_cell_coord_t){3, y}, &read), RG_STATUS_OK);
+        ASSERT_TRUE(read.material_id == ((y == 3) ? sand_id : 0u));
+    }
+
+    rg_world_destroy(world);
+    return 0;
+}
+
 static int test_liquid_flows_sideways_when_blocked(void)
 {
     rg_world_t* world;
@@ -580,6 +682,59 @@ static int test_cross_chunk_fall(void)
     return 0;
 }
 
+static int test_dense_fall_settles_across_chunks(void)
+{
+    rg_world_t* world;
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_cell_write_t write;
+    rg_cell_read_t read;
+    rg_step_options_t step_options;
+    rg_world_stats_t stats;
+    int32_t x;
+    int32_t y;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 8;
+    cfg.chunk_height = 8;
+    cfg.default_step_mode = RG_STEP_MODE_CHUNK_SCAN_SERIAL;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 31u;
+    ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+
+    ASSERT_TRUE(register_simple_material(world, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_STATUS(rg_chunk_load(world, 0, 0), RG_STATUS_OK);
+    ASSERT_STATUS(rg_chunk_load(world, 1, 0), RG_STATUS_OK);
+    ASSERT_STATUS(rg_chunk_load(world, 0, 1), RG_STATUS_OK);
+    ASSERT_STATUS(rg_chunk_load(world, 1, 1), RG_STATUS_OK);
+
+    memset(&write, 0, sizeof(write));
+    write.material_id = sand_id;
+    for (y = 0; y < 4; ++y) {
+        for (x = 0; x < 16; ++x) {
+            ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){x, y}, &write), RG_STATUS_OK);
+        }
+    }
+
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = RG_STEP_MODE_CHUNK_SCAN_SERIAL;
+    step_options.substeps = 32u;
+    ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+
+    ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+    ASSERT_TRUE(stats.live_cells == 64u);
+
+    for (y = 0; y < 16; ++y) {
+        for (x = 0; x < 16; ++x) {
+            ASSERT_STATUS(rg_cell_get(world, (rg_cell_coord_t){x, y}, &read), RG_STATUS_OK);
+            ASSERT_TRUE(read.material_id == ((y >= 12) ? sand_id : 0u));
+        }
+    }
+
+    rg_world_destroy(world);
+    return 0;
+}
+
 static int test_chunk_scan_sleep_and_wake(void)
 {
     rg_world_t* world;
@@ -623,6 +778,444 @@ static int test_chunk_scan_sleep_and_wake(void)
     return 0;
 }
 
+static int test_chunk_scan_steps_woken_chunks_next_pass(void)
+{
+    rg_world_t* world;
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_cell_write_t write;
+    rg_cell_read_t read;
+    rg_step_options_t step_options;
+    rg_world_stats_t stats;
+    int32_t cy;
+    int32_t y;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 8;
+    cfg.chunk_height = 8;
+    cfg.default_step_mode = RG_STEP_MODE_CHUNK_SCAN_SERIAL;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 3u;
+    cfg.chunk_sleep_ticks = 1u;
+    ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+    ASSERT_TRUE(register_simple_material(world, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    for (cy = 0; cy < 3; ++cy) {
+        ASSERT_STATUS(rg_chunk_load(world, 0, cy), RG_STATUS_OK);
+    }
+
+    memset(&write, 0, sizeof(write));
+    write.material_id = sand_id;
+    ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){3, 7}, &write), RG_STATUS_OK);
+
+    /*
+     * The grain wakes each chunk below as it crosses in. Stepping that chunk in the
+     * same pass would spend its one idle tick and strand the grain mid-air.
+     */
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = RG_STEP_MODE_CHUNK_SCAN_SERIAL;
+    step_options.substeps = 1u;
+    for (y = 8; y < 20; ++y) {
+        ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+        ASSERT_STATUS(rg_cell_get(world, (rg_cell_coord_t){3, y}, &read), RG_STATUS_OK);
+        ASSERT_TRUE(read.material_id == sand_id);
+        ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+        ASSERT_TRUE(stats.active_chunks == 1u);
+        ASSERT_TRUE(stats.chunk_wakes_last_step == ((y % 8 == 0) ? 1u : 0u));
+    }
+
+    rg_world_destroy(world);
+    return 0;
+}
+
+static int step_and_count_active(rg_world_t* world, uint32_t substeps, uint32_t* out_active)
+{
+    rg_step_options_t step_options;
+    rg_world_stats_t stats;
+
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = RG_STEP_MODE_CHUNK_SCAN_SERIAL;
+    step_options.substeps = substeps;
+    ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+    *out_active = stats.active_chunks;
+    return 0;
+}
+
+static int test_adaptive_sleep_policy(void)
+{
+    rg_world_t* world;
+    rg_world_config_t cfg;
+    rg_material_id_t stone_id;
+    rg_cell_write_t write;
+    rg_world_stats_t stats;
+    uint32_t active;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 8;
+    cfg.chunk_height = 8;
+    cfg.default_step_mode = RG_STEP_MODE_CHUNK_SCAN_SERIAL;
+    cfg.sleep_policy = RG_SLEEP_POLICY_ADAPTIVE;
+    cfg.chunk_sleep_ticks = 2u;
+    cfg.chunk_sleep_ticks_min = 4u;
+    ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_INVALID_ARGUMENT);
+
+    cfg.chunk_sleep_ticks_min = 1u;
+    cfg.chunk_sleep_ticks_max = 4u;
+    ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+    ASSERT_TRUE(register_simple_material(world, "stone", RG_MATERIAL_STATIC, 100.0f, &stone_id) == 0);
+    ASSERT_STATUS(rg_chunk_load(world, 0, 0), RG_STATUS_OK);
+
+    memset(&write, 0, sizeof(write));
+    write.material_id = stone_id;
+    ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){2, 2}, &write), RG_STATUS_OK);
+
+    /* Settles after the configured 2 ticks; a clean first sleep shrinks the threshold to 1. */
+    ASSERT_TRUE(step_and_count_active(world, 1u, &active) == 0);
+    ASSERT_TRUE(active == 1u);
+    ASSERT_TRUE(step_and_count_active(world, 1u, &active) == 0);
+    ASSERT_TRUE(active == 0u);
+
+    /* Woken right after sleeping: the threshold doubles back to 2. */
+    ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){3, 2}, &write), RG_STATUS_OK);
+    ASSERT_TRUE(step_and_count_active(world, 1u, &active) == 0);
+    ASSERT_TRUE(active == 1u);
+    ASSERT_TRUE(step_and_count_active(world, 1u, &active) == 0);
+    ASSERT_TRUE(active == 0u);
+
+    /* Early again: grows to the max of 4. */
+    ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){4, 2}, &write), RG_STATUS_OK);
+    ASSERT_TRUE(step_and_count_active(world, 3u, &active) == 0);
+    ASSERT_TRUE(active == 1u);
+    ASSERT_TRUE(step_and_count_active(world, 1u, &active) == 0);
+    ASSERT_TRUE(active == 0u);
+    ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+    ASSERT_TRUE(stats.chunk_sleeps_last_step == 1u);
+    ASSERT_TRUE(stats.chunk_wakes_last_step == 0u);
+
+    /* Quiet spells between wakes let the threshold shrink again: 4 -> 2. */
+    ASSERT_TRUE(step_and_count_active(world, 16u, &active) == 0);
+    ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){5, 2}, &write), RG_STATUS_OK);
+    ASSERT_TRUE(step_and_count_active(world, 3u, &active) == 0);
+    ASSERT_TRUE(active == 1u);
+    ASSERT_TRUE(step_and_count_active(world, 1u, &active) == 0);
+    ASSERT_TRUE(active == 0u);
+
+    ASSERT_TRUE(step_and_count_active(world, 8u, &active) == 0);
+    ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){6, 2}, &write), RG_STATUS_OK);
+    ASSERT_TRUE(step_and_count_active(world, 1u, &active) == 0);
+    ASSERT_TRUE(active == 1u);
+    ASSERT_TRUE(step_and_count_active(world, 1u, &active) == 0);
+    ASSERT_TRUE(active == 0u);
+
+    ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+    ASSERT_TRUE(stats.chunk_wakes_total == 5u);
+    ASSERT_TRUE(stats.chunk_sleeps_total == 5u);
+
+    rg_world_destroy(world);
+    return 0;
+}
+
+static int test_lod_steps_distant_chunks_less_often(void)
+{
+    static const rg_step_mode_t k_modes[3] = {
+        RG_STEP_MODE_FULL_SCAN_SERIAL,
+        RG_STEP_MODE_CHUNK_SCAN_SERIAL,
+        RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL
+    };
+    uint32_t mode_index;
+
+    for (mode_index = 0u; mode_index < 3u; ++mode_index) {
+        rg_world_t* world;
+        rg_world_config_t cfg;
+        rg_material_id_t sand_id;
+        rg_cell_write_t write;
+        rg_cell_read_t read;
+        rg_step_options_t step_options;
+        rg_world_stats_t stats;
+        rg_cell_coord_t focus;
+        int32_t cx;
+
+        memset(&cfg, 0, sizeof(cfg));
+        cfg.chunk_width = 4;
+        cfg.chunk_height = 16;
+        cfg.default_step_mode = k_modes[mode_index];
+        cfg.deterministic_mode = 1u;
+        cfg.deterministic_seed = 9u;
+        cfg.lod_full_rate_radius = 0u;
+        cfg.lod_band_width = 1u;
+        cfg.lod_max_period = 3u;
+        ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_INVALID_ARGUMENT);
+        cfg.lod_max_period = 4u;
+        ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+
+        ASSERT_TRUE(register_simple_material(world, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+        for (cx = 0; cx < 4; ++cx) {
+            ASSERT_STATUS(rg_chunk_load(world, cx, 0), RG_STATUS_OK);
+        }
+
+        memset(&write, 0, sizeof(write));
+        write.material_id = sand_id;
+        ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){1, 0}, &write), RG_STATUS_OK);
+        ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){13, 0}, &write), RG_STATUS_OK);
+
+        /* Chunk 0 holds the focus and runs every tick; chunk 3 is two bands out (period 4). */
+        focus.x = 2;
+        focus.y = 3;
+        ASSERT_STATUS(rg_world_set_focus_points(world, &focus, 1u), RG_STATUS_OK);
+
+        memset(&step_options, 0, sizeof(step_options));
+        step_options.mode = k_modes[mode_index];
+        step_options.substeps = 8u;
+        ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+
+        ASSERT_STATUS(rg_cell_get(world, (rg_cell_coord_t){1, 8}, &read), RG_STATUS_OK);
+        ASSERT_TRUE(read.material_id == sand_id);
+        ASSERT_STATUS(rg_cell_get(world, (rg_cell_coord_t){13, 2}, &read), RG_STATUS_OK);
+        ASSERT_TRUE(read.material_id == sand_id);
+        ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+        ASSERT_TRUE(stats.lod_skipped_chunks_last_step > 0u);
+
+        ASSERT_STATUS(rg_world_set_focus_points(world, NULL, 0u), RG_STATUS_OK);
+        step_options.substeps = 4u;
+        ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+        ASSERT_STATUS(rg_cell_get(world, (rg_cell_coord_t){13, 6}, &read), RG_STATUS_OK);
+        ASSERT_TRUE(read.material_id == sand_id);
+        ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+        ASSERT_TRUE(stats.lod_skipped_chunks_last_step == 0u);
+
+        rg_world_destroy(world);
+    }
+
+    return 0;
+}
+
+static uint64_t test_ticking_clock(void* user)
+{
+    uint64_t* now;
+
+    now = (uint64_t*)user;
+    *now += 1u;
+    return *now - 1u;
+}
+
+static int32_t grain_row(const rg_world_t* world, int32_t x, int32_t height)
+{
+    rg_cell_read_t read;
+    int32_t y;
+
+    for (y = 0; y < height; ++y) {
+        if (rg_cell_get(world, (rg_cell_coord_t){x, y}, &read) == RG_STATUS_OK && read.material_id != 0u) {
+            return y;
+        }
+    }
+    return -1;
+}
+
+static int test_budgeted_step_priority_and_fairness(void)
+{
+    static const rg_step_mode_t k_modes[2] = {
+        RG_STEP_MODE_CHUNK_SCAN_SERIAL,
+        RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL
+    };
+    uint32_t mode_index;
+
+    for (mode_index = 0u; mode_index < 2u; ++mode_index) {
+        rg_world_t* world;
+        rg_world_config_t cfg;
+        rg_material_id_t sand_id;
+        rg_cell_write_t write;
+        rg_budget_step_options_t budget_options;
+        rg_budget_step_result_t result;
+        rg_world_stats_t stats;
+        uint64_t now;
+        int32_t cx;
+        uint32_t call;
+
+        memset(&cfg, 0, sizeof(cfg));
+        cfg.chunk_width = 4;
+        cfg.chunk_height = 16;
+        cfg.deterministic_mode = 1u;
+        cfg.deterministic_seed = 11u;
+        ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+        ASSERT_TRUE(register_simple_material(world, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+
+        memset(&write, 0, sizeof(write));
+        write.material_id = sand_id;
+        for (cx = 0; cx < 4; ++cx) {
+            ASSERT_STATUS(rg_chunk_load(world, cx, 0), RG_STATUS_OK);
+            ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){(cx * 4) + 1, 0}, &write), RG_STATUS_OK);
+        }
+        ASSERT_STATUS(rg_chunk_set_priority(world, 3, 0, 5), RG_STATUS_OK);
+        ASSERT_STATUS(rg_chunk_set_priority(world, 9, 0, 5), RG_STATUS_NOT_FOUND);
+
+        /* Every clock read advances 1ns; a 2ns budget fits two chunks. */
+        now = 0u;
+        memset(&budget_options, 0, sizeof(budget_options));
+        budget_options.mode = k_modes[mode_index];
+        budget_options.budget_ns = 2u;
+        budget_options.clock_now_ns = test_ticking_clock;
+        budget_options.clock_user = &now;
+
+        ASSERT_STATUS(rg_world_step_budgeted(world, &budget_options, &result), RG_STATUS_OK);
+        ASSERT_TRUE(result.chunks_stepped >= 1u);
+        ASSERT_TRUE(result.chunks_stepped + result.chunks_deferred == 4u);
+        ASSERT_TRUE(grain_row(world, 13, 16) == 1);
+        ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+        ASSERT_TRUE(stats.budget_deferred_chunks_last_step == result.chunks_deferred);
+        if (k_modes[mode_index] == RG_STEP_MODE_CHUNK_SCAN_SERIAL) {
+            ASSERT_TRUE(result.chunks_stepped == 2u);
+            ASSERT_TRUE(grain_row(world, 1, 16) == 1);
+            ASSERT_TRUE(grain_row(world, 5, 16) == 0);
+            ASSERT_TRUE(grain_row(world, 9, 16) == 0);
+
+            /* Deferred chunks outrank the priority chunk on the next call. */
+            ASSERT_STATUS(rg_world_step_budgeted(world, &budget_options, &result), RG_STATUS_OK);
+            ASSERT_TRUE(grain_row(world, 5, 16) == 1);
+            ASSERT_TRUE(grain_row(world, 9, 16) == 1);
+            ASSERT_TRUE(grain_row(world, 13, 16) == 1);
+        }
+
+        /* An already expired budget still steps one chunk per call, oldest first. */
+        budget_options.budget_ns = 1u;
+        for (call = 0u; call < 8u; ++call) {
+            ASSERT_STATUS(rg_world_step_budgeted(world, &budget_options, &result), RG_STATUS_OK);
+            ASSERT_TRUE(result.chunks_stepped >= 1u);
+        }
+        for (cx = 0; cx < 4; ++cx) {
+            ASSERT_TRUE(grain_row(world, (cx * 4) + 1, 16) >= 2);
+        }
+
+        budget_options.budget_ns = 0u;
+        ASSERT_STATUS(rg_world_step_budgeted(world, &budget_options, &result), RG_STATUS_OK);
+        ASSERT_TRUE(result.chunks_stepped == 4u);
+        ASSERT_TRUE(result.chunks_deferred == 0u);
+
+        rg_world_destroy(world);
+    }
+
+    return 0;
+}
+
+static int test_active_chunks_follow_load_and_unload(void)
+{
+    rg_world_t* world;
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_cell_write_t write;
+    rg_cell_read_t read;
+    rg_world_stats_t stats;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 4;
+    cfg.chunk_height = 4;
+    cfg.default_step_mode = RG_STEP_MODE_CHUNK_SCAN_SERIAL;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 3u;
+    ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+
+    ASSERT_TRUE(register_simple_material(world, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_STATUS(rg_chunk_load(world, 0, 0), RG_STATUS_OK);
+    ASSERT_STATUS(rg_chunk_load(world, 2, 0), RG_STATUS_OK);
+
+    memset(&write, 0, sizeof(write));
+    write.material_id = sand_id;
+    ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){9, 0}, &write), RG_STATUS_OK);
+
+    ASSERT_STATUS(rg_chunk_load(world, 1, 0), RG_STATUS_OK);
+    ASSERT_STATUS(rg_chunk_load(world, -1, 0), RG_STATUS_OK);
+    ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){5, 0}, &write), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+    ASSERT_TRUE(stats.active_chunks == 2u);
+
+    ASSERT_STATUS(rg_chunk_unload(world, -1, 0), RG_STATUS_OK);
+    ASSERT_STATUS(rg_chunk_unload(world, 1, 0), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+    ASSERT_TRUE(stats.active_chunks == 1u);
+    ASSERT_TRUE(stats.live_cells == 1u);
+
+    ASSERT_STATUS(rg_world_step(world, NULL), RG_STATUS_OK);
+    ASSERT_STATUS(rg_cell_get(world, (rg_cell_coord_t){9, 1}, &read), RG_STATUS_OK);
+    ASSERT_TRUE(read.material_id == sand_id);
+
+    ASSERT_STATUS(rg_cell_clear(world, (rg_cell_coord_t){9, 1}), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+    ASSERT_TRUE(stats.active_chunks == 0u);
+
+    rg_world_destroy(world);
+    return 0;
+}
+
+static int test_border_change_wakes_sleeping_neighbor(void)
+{
+    static const rg_step_mode_t k_modes[2] = {
+        RG_STEP_MODE_CHUNK_SCAN_SERIAL,
+        RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL
+    };
+    uint32_t mode_index;
+
+    for (mode_index = 0u; mode_index < 2u; ++mode_index) {
+        rg_world_t* world;
+        rg_world_config_t cfg;
+        rg_material_id_t sand_id;
+        rg_material_id_t stone_id;
+        rg_cell_write_t write;
+        rg_cell_read_t read;
+        rg_step_options_t step_options;
+        rg_world_stats_t stats;
+        int32_t x;
+        int32_t y;
+
+        memset(&cfg, 0, sizeof(cfg));
+        cfg.chunk_width = 4;
+        cfg.chunk_height = 4;
+        cfg.default_step_mode = k_modes[mode_index];
+        cfg.deterministic_mode = 1u;
+        cfg.deterministic_seed = 5u;
+        ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+
+        ASSERT_TRUE(register_simple_material(world, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+        ASSERT_TRUE(register_simple_material(world, "stone", RG_MATERIAL_STATIC, 100.0f, &stone_id) == 0);
+        ASSERT_STATUS(rg_chunk_load(world, 0, 0), RG_STATUS_OK);
+        ASSERT_STATUS(rg_chunk_load(world, 0, 1), RG_STATUS_OK);
+
+        /* Two sand rows resting on a stone plug that sits in the chunk below. */
+        memset(&write, 0, sizeof(write));
+        for (x = 0; x < 4; ++x) {
+            write.material_id = sand_id;
+            ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){x, 2}, &write), RG_STATUS_OK);
+            ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){x, 3}, &write), RG_STATUS_OK);
+            write.material_id = stone_id;
+            ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){x, 4}, &write), RG_STATUS_OK);
+        }
+
+        memset(&step_options, 0, sizeof(step_options));
+        step_options.mode = k_modes[mode_index];
+        step_options.substeps = 16u;
+        ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+        ASSERT_TRUE(stats.active_chunks == 0u);
+
+        /* Removing the plug only touches the lower chunk's top border. */
+        for (x = 0; x < 4; ++x) {
+            ASSERT_STATUS(rg_cell_clear(world, (rg_cell_coord_t){x, 4}), RG_STATUS_OK);
+        }
+        ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+        ASSERT_TRUE(stats.active_chunks == 1u);
+
+        ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+        for (y = 2; y < 8; ++y) {
+            for (x = 0; x < 4; ++x) {
+                ASSERT_STATUS(rg_cell_get(world, (rg_cell_coord_t){x, y}, &read), RG_STATUS_OK);
+                ASSERT_TRUE(read.material_id == ((y >= 6) ? sand_id : 0u));
+            }
+        }
+
+        rg_world_destroy(world);
+    }
+
+    return 0;
+}
+
 static int test_unloaded_chunk_cell_access(void)
 {
     rg_world_t* world;
@@ -754,6 +1347,1646 @@ static int test_checkerboard_parallel_conflict_resolution(void)
     return 0;
 }
 
+static int populate_mixed_scene(rg_world_t* world, rg_material_id_t sand_id, rg_material_id_t water_id)
+{
+    rg_cell_write_t write;
+    int32_t x;
+    int32_t y;
+
+    memset(&write, 0, sizeof(write));
+    for (y = 0; y < 6; ++y) {
+        for (x = 0; x < 16; ++x) {
+            write.material_id = (((x + y) % 3) == 0) ? water_id : sand_id;
+            ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){x, y}, &write), RG_STATUS_OK);
+        }
+    }
+    return 0;
+}
+
+static int assert_worlds_match(
+    const rg_world_t* lhs,
+    const rg_world_t* rhs,
+    int32_t origin_x,
+    int32_t origin_y,
+    int32_t width,
+    int32_t height)
+{
+    rg_cell_read_t read_lhs;
+    rg_cell_read_t read_rhs;
+    int32_t x;
+    int32_t y;
+
+    for (y = origin_y; y < origin_y + height; ++y) {
+        for (x = origin_x; x < origin_x + width; ++x) {
+            ASSERT_STATUS(rg_cell_get(lhs, (rg_cell_coord_t){x, y}, &read_lhs), RG_STATUS_OK);
+            ASSERT_STATUS(rg_cell_get(rhs, (rg_cell_coord_t){x, y}, &read_rhs), RG_STATUS_OK);
+            ASSERT_TRUE(read_lhs.material_id == read_rhs.material_id);
+        }
+    }
+    return 0;
+}
+
+/* Fills row y with sand and water one chunk column at a time, left to right or right to left. */
+static int drop_mixed_row(
+    rg_world_t* world,
+    rg_material_id_t sand_id,
+    rg_material_id_t water_id,
+    int32_t y,
+    uint8_t reverse)
+{
+    rg_cell_write_t write;
+    int32_t first_x;
+    int32_t i;
+    int32_t x;
+
+    memset(&write, 0, sizeof(write));
+    for (i = 0; i < 8; ++i) {
+        first_x = 8 * ((reverse != 0u) ? 7 - i : i);
+        for (x = first_x; x < first_x + 8; ++x) {
+            write.material_id = (((x + y) % 3) == 0) ? water_id : sand_id;
+            ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){x, y}, &write), RG_STATUS_OK);
+        }
+    }
+    return 0;
+}
+
+static int test_active_chunk_order_independent_of_wakes(void)
+{
+    rg_world_t* worlds[2];
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_material_id_t water_id;
+    rg_step_options_t step_options;
+    uint32_t round;
+    uint32_t w;
+    int32_t cx;
+    int32_t cy;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 8;
+    cfg.chunk_height = 8;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 11u;
+    cfg.chunk_sleep_ticks = 2u;
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.substeps = 1u;
+
+    for (w = 0u; w < 2u; ++w) {
+        ASSERT_STATUS(rg_world_create(&cfg, &worlds[w]), RG_STATUS_OK);
+        ASSERT_TRUE(register_simple_material(worlds[w], "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+        ASSERT_TRUE(register_simple_material(worlds[w], "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+        for (cy = 0; cy < 4; ++cy) {
+            for (cx = 0; cx < 8; ++cx) {
+                ASSERT_STATUS(rg_chunk_load(worlds[w], cx, cy), RG_STATUS_OK);
+            }
+        }
+    }
+
+    /*
+     * The two worlds wake their chunks in opposite orders, and chunks fall asleep
+     * between drops, so the awake lists are reordered over and over. Stepping must
+     * still visit chunks in table order.
+     */
+    for (round = 0u; round < 6u; ++round) {
+        for (w = 0u; w < 2u; ++w) {
+            uint32_t step;
+
+            ASSERT_TRUE(drop_mixed_row(worlds[w], sand_id, water_id, (int32_t)(round % 3u), (uint8_t)w) == 0);
+            step_options.mode = (round % 2u == 0u) ? RG_STEP_MODE_CHUNK_SCAN_SERIAL : RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+            for (step = 0u; step < 40u; ++step) {
+                ASSERT_STATUS(rg_world_step(worlds[w], &step_options), RG_STATUS_OK);
+            }
+        }
+        ASSERT_TRUE(assert_worlds_match(worlds[0], worlds[1], 0, 0, 64, 32) == 0);
+    }
+
+    rg_world_destroy(worlds[0]);
+    rg_world_destroy(worlds[1]);
+    return 0;
+}
+
+static int test_checkerboard_randomness_independent_of_scheduling(void)
+{
+    rg_world_t* world_serial;
+    rg_world_t* world_runner;
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_material_id_t water_id;
+    rg_step_options_t step_options;
+    test_runner_state_t runner_state;
+    rg_runner_t runner;
+    int32_t cx;
+    int32_t cy;
+
+    memset(&runner_state, 0, sizeof(runner_state));
+    runner.vtable = &g_test_runner_vtable;
+    runner.user = &runner_state;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 4;
+    cfg.chunk_height = 4;
+    cfg.default_step_mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 2024u;
+    ASSERT_STATUS(rg_world_create(&cfg, &world_serial), RG_STATUS_OK);
+    cfg.runner = &runner;
+    ASSERT_STATUS(rg_world_create(&cfg, &world_runner), RG_STATUS_OK);
+
+    ASSERT_TRUE(register_simple_material(world_serial, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(world_serial, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+    ASSERT_TRUE(register_simple_material(world_runner, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(world_runner, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+
+    for (cy = 0; cy < 4; ++cy) {
+        for (cx = 0; cx < 4; ++cx) {
+            ASSERT_STATUS(rg_chunk_load(world_serial, cx, cy), RG_STATUS_OK);
+            ASSERT_STATUS(rg_chunk_load(world_runner, cx, cy), RG_STATUS_OK);
+        }
+    }
+    ASSERT_TRUE(populate_mixed_scene(world_serial, sand_id, water_id) == 0);
+    ASSERT_TRUE(populate_mixed_scene(world_runner, sand_id, water_id) == 0);
+
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    step_options.substeps = 24u;
+    ASSERT_STATUS(rg_world_step(world_serial, &step_options), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_step(world_runner, &step_options), RG_STATUS_OK);
+
+    ASSERT_TRUE(runner_state.call_count > 0u);
+    ASSERT_TRUE(assert_worlds_match(world_serial, world_runner, 0, 0, 16, 16) == 0);
+
+    rg_world_destroy(world_serial);
+    rg_world_destroy(world_runner);
+    return 0;
+}
+
+typedef struct counting_allocator_s {
+    uint64_t alloc_count;
+    uint64_t free_count;
+} counting_allocator_t;
+
+/* Over-allocates and stores the malloc base just below the aligned block. */
+static void* counting_alloc(void* user, size_t size, size_t align)
+{
+    counting_allocator_t* counter;
+    unsigned char* base;
+    uintptr_t aligned;
+
+    counter = (counting_allocator_t*)user;
+    counter->alloc_count += 1u;
+    if (align < sizeof(void*)) {
+        align = sizeof(void*);
+    }
+    base = (unsigned char*)malloc(size + align + sizeof(void*));
+    if (base == NULL) {
+        return NULL;
+    }
+    aligned = ((uintptr_t)(base + sizeof(void*)) + (align - 1u)) & ~(uintptr_t)(align - 1u);
+    ((void**)aligned)[-1] = base;
+    return (void*)aligned;
+}
+
+static void counting_free(void* user, void* ptr, size_t size, size_t align)
+{
+    counting_allocator_t* counter;
+
+    (void)size;
+    (void)align;
+    counter = (counting_allocator_t*)user;
+    counter->free_count += 1u;
+    free(((void**)ptr)[-1]);
+}
+
+/* Steps a fresh counting-allocator world once and returns the allocator calls the step made. */
+static int step_substep_world(
+    const rg_runner_t* runner,
+    uint32_t substeps,
+    counting_allocator_t* counter,
+    rg_world_t** out_world,
+    uint64_t* out_step_allocs)
+{
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_material_id_t water_id;
+    rg_cell_write_t write;
+    rg_step_options_t step_options;
+    uint64_t created_alloc_count;
+    int32_t cx;
+    int32_t cy;
+    int32_t x;
+    int32_t y;
+
+    memset(counter, 0, sizeof(*counter));
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.allocator.alloc = counting_alloc;
+    cfg.allocator.free = counting_free;
+    cfg.allocator.user = counter;
+    cfg.chunk_width = 32;
+    cfg.chunk_height = 32;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 21u;
+    cfg.runner = runner;
+    ASSERT_STATUS(rg_world_create(&cfg, out_world), RG_STATUS_OK);
+    ASSERT_TRUE(register_simple_material(*out_world, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(*out_world, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+    for (cy = 0; cy < 2; ++cy) {
+        for (cx = 0; cx < 2; ++cx) {
+            ASSERT_STATUS(rg_chunk_load(*out_world, cx, cy), RG_STATUS_OK);
+        }
+    }
+
+    memset(&write, 0, sizeof(write));
+    for (y = 0; y < 12; ++y) {
+        for (x = 0; x < 64; ++x) {
+            write.material_id = (((x / 3) + y) % 2 == 0) ? sand_id : water_id;
+            ASSERT_STATUS(rg_cell_set(*out_world, (rg_cell_coord_t){x, y}, &write), RG_STATUS_OK);
+        }
+    }
+
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    step_options.substeps = substeps;
+    created_alloc_count = counter->alloc_count;
+    ASSERT_STATUS(rg_world_step(*out_world, &step_options), RG_STATUS_OK);
+    *out_step_allocs = counter->alloc_count - created_alloc_count;
+    return 0;
+}
+
+static int test_substeps_reuse_step_scratch(void)
+{
+    rg_world_t* world;
+    counting_allocator_t counter;
+    test_runner_state_t runner_state;
+    rg_runner_t runner;
+    rg_step_options_t step_options;
+    rg_world_stats_t stats;
+    uint64_t single_substep_allocs;
+    uint64_t step_allocs;
+    int32_t cx;
+    int32_t cy;
+
+    memset(&runner_state, 0, sizeof(runner_state));
+    runner.vtable = &g_test_runner_vtable;
+    runner.user = &runner_state;
+
+    ASSERT_TRUE(step_substep_world(&runner, 1u, &counter, &world, &single_substep_allocs) == 0);
+    ASSERT_TRUE(single_substep_allocs > 0u);
+    rg_world_destroy(world);
+    ASSERT_TRUE(counter.alloc_count == counter.free_count);
+
+    /* Substeps after the first reuse the scratch the first one grew. */
+    ASSERT_TRUE(step_substep_world(&runner, 8u, &counter, &world, &step_allocs) == 0);
+    ASSERT_TRUE(step_allocs == single_substep_allocs);
+    ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+    ASSERT_TRUE(stats.intents_emitted_last_step > 0u);
+
+    /* Per-step counters start from zero rather than accumulating. */
+    for (cy = 0; cy < 2; ++cy) {
+        for (cx = 0; cx < 2; ++cx) {
+            ASSERT_STATUS(rg_chunk_unload(world, cx, cy), RG_STATUS_OK);
+        }
+    }
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+    ASSERT_TRUE(stats.intents_emitted_last_step == 0u);
+    rg_world_destroy(world);
+    ASSERT_TRUE(counter.alloc_count == counter.free_count);
+    return 0;
+}
+
+static int create_tile_world(
+    const rg_runner_t* runner,
+    int32_t tile_width,
+    int32_t tile_height,
+    rg_world_t** out_world)
+{
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_material_id_t water_id;
+    int32_t cx;
+    int32_t cy;
+    int32_t x;
+    int32_t y;
+    rg_cell_write_t write;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 32;
+    cfg.chunk_height = 32;
+    cfg.tile_width = tile_width;
+    cfg.tile_height = tile_height;
+    cfg.default_step_mode = RG_STEP_MODE_TILE_CHECKERBOARD_PARALLEL;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 9u;
+    cfg.runner = runner;
+    ASSERT_STATUS(rg_world_create(&cfg, out_world), RG_STATUS_OK);
+    ASSERT_TRUE(register_simple_material(*out_world, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(*out_world, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+    for (cy = 0; cy < 2; ++cy) {
+        for (cx = 0; cx < 2; ++cx) {
+            ASSERT_STATUS(rg_chunk_load(*out_world, cx, cy), RG_STATUS_OK);
+        }
+    }
+
+    memset(&write, 0, sizeof(write));
+    for (y = 0; y < 12; ++y) {
+        for (x = 0; x < 64; ++x) {
+            write.material_id = (((x / 3) + y) % 2 == 0) ? sand_id : water_id;
+            ASSERT_STATUS(rg_cell_set(*out_world, (rg_cell_coord_t){x, y}, &write), RG_STATUS_OK);
+        }
+    }
+    return 0;
+}
+
+static int create_counting_world(
+    rg_step_mode_t mode,
+    const rg_runner_t* runner,
+    uint32_t step_scratch_chunks,
+    counting_allocator_t* counter,
+    rg_world_t** out_world)
+{
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_material_id_t water_id;
+    rg_cell_write_t write;
+    int32_t cx;
+    int32_t cy;
+    int32_t x;
+    int32_t y;
+
+    memset(counter, 0, sizeof(*counter));
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.allocator.alloc = counting_alloc;
+    cfg.allocator.free = counting_free;
+    cfg.allocator.user = counter;
+    cfg.chunk_width = 32;
+    cfg.chunk_height = 32;
+    cfg.tile_width = 8;
+    cfg.tile_height = 8;
+    cfg.step_scratch_chunks = step_scratch_chunks;
+    cfg.default_step_mode = mode;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 21u;
+    cfg.runner = runner;
+    ASSERT_STATUS(rg_world_create(&cfg, out_world), RG_STATUS_OK);
+    ASSERT_TRUE(register_simple_material(*out_world, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(*out_world, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+    for (cy = 0; cy < 2; ++cy) {
+        for (cx = 0; cx < 2; ++cx) {
+            ASSERT_STATUS(rg_chunk_load(*out_world, cx, cy), RG_STATUS_OK);
+        }
+    }
+
+    memset(&write, 0, sizeof(write));
+    for (y = 0; y < 12; ++y) {
+        for (x = 0; x < 64; ++x) {
+            write.material_id = (((x / 3) + y) % 2 == 0) ? sand_id : water_id;
+            ASSERT_STATUS(rg_cell_set(*out_world, (rg_cell_coord_t){x, y}, &write), RG_STATUS_OK);
+        }
+    }
+    return 0;
+}
+
+static int run_steady_state_steps(rg_step_mode_t mode, const rg_runner_t* runner)
+{
+    rg_world_t* world;
+    counting_allocator_t counter;
+    rg_step_options_t step_options;
+    uint64_t warm_alloc_count;
+    uint32_t step;
+
+    ASSERT_TRUE(create_counting_world(mode, runner, 0u, &counter, &world) == 0);
+
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = mode;
+    step_options.substeps = 1u;
+    for (step = 0u; step < 60u; ++step) {
+        ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+    }
+    warm_alloc_count = counter.alloc_count;
+    for (step = 0u; step < 30u; ++step) {
+        ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+    }
+    ASSERT_TRUE(counter.alloc_count == warm_alloc_count);
+
+    rg_world_destroy(world);
+    ASSERT_TRUE(counter.alloc_count == counter.free_count);
+    return 0;
+}
+
+static int test_steady_state_steps_do_not_allocate(void)
+{
+    test_runner_state_t runner_state;
+    test_runner_state_t graph_state;
+    rg_runner_t runner;
+    rg_runner_t graph_runner;
+
+    memset(&runner_state, 0, sizeof(runner_state));
+    memset(&graph_state, 0, sizeof(graph_state));
+    runner.vtable = &g_test_runner_vtable;
+    runner.user = &runner_state;
+    graph_runner.vtable = &g_test_graph_runner_vtable;
+    graph_runner.user = &graph_state;
+
+    ASSERT_TRUE(run_steady_state_steps(RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL, NULL) == 0);
+    ASSERT_TRUE(run_steady_state_steps(RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL, &runner) == 0);
+    ASSERT_TRUE(run_steady_state_steps(RG_STEP_MODE_TILE_CHECKERBOARD_PARALLEL, &runner) == 0);
+    ASSERT_TRUE(run_steady_state_steps(RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL, &graph_runner) == 0);
+    ASSERT_TRUE(graph_state.graph_call_count > 0u);
+    return 0;
+}
+
+static int test_reserved_step_scratch(void)
+{
+    rg_world_t* world;
+    counting_allocator_t counter;
+    test_runner_state_t runner_state;
+    rg_runner_t runner;
+    rg_step_options_t step_options;
+    rg_budget_step_options_t budget_options;
+    rg_budget_step_result_t budget_result;
+    rg_world_stats_t stats;
+    uint64_t created_alloc_count;
+    uint32_t step;
+
+    memset(&runner_state, 0, sizeof(runner_state));
+    runner.vtable = &g_test_runner_vtable;
+    runner.user = &runner_state;
+
+    /* Without a reservation the first step grows scratch and reports it. */
+    ASSERT_TRUE(create_counting_world(RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL, &runner, 0u, &counter, &world) == 0);
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    step_options.substeps = 1u;
+    ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+    ASSERT_TRUE(stats.step_scratch_allocs > 0u);
+    rg_world_destroy(world);
+
+    ASSERT_TRUE(create_counting_world(RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL, &runner, 4u, &counter, &world) == 0);
+    ASSERT_STATUS(rg_world_reserve_step_scratch(NULL, 4u), RG_STATUS_INVALID_ARGUMENT);
+    ASSERT_STATUS(rg_world_reserve_step_scratch(world, 2u), RG_STATUS_OK);
+    created_alloc_count = counter.alloc_count;
+
+    memset(&budget_options, 0, sizeof(budget_options));
+    budget_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    for (step = 0u; step < 24u; ++step) {
+        step_options.mode = (step % 2u == 0u) ?
+            RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL :
+            RG_STEP_MODE_TILE_CHECKERBOARD_PARALLEL;
+        ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_step_budgeted(world, &budget_options, &budget_result), RG_STATUS_OK);
+    }
+
+    ASSERT_TRUE(counter.alloc_count == created_alloc_count);
+    ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+    ASSERT_TRUE(stats.step_scratch_allocs == 0u);
+    rg_world_destroy(world);
+    ASSERT_TRUE(counter.alloc_count == counter.free_count);
+
+    /* A graph runner's reservation also covers the cross-phase step graph. */
+    runner.vtable = &g_test_graph_runner_vtable;
+    ASSERT_TRUE(create_counting_world(RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL, &runner, 4u, &counter, &world) == 0);
+    created_alloc_count = counter.alloc_count;
+    step_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    for (step = 0u; step < 24u; ++step) {
+        ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+    }
+    ASSERT_TRUE(counter.alloc_count == created_alloc_count);
+    ASSERT_TRUE(runner_state.graph_call_count > 0u);
+    rg_world_destroy(world);
+    ASSERT_TRUE(counter.alloc_count == counter.free_count);
+    return 0;
+}
+
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+/* Real threads are the only runner on which tiles of one color share mask bytes concurrently. */
+static int run_tile_thread_runner_against_serial(int32_t tile_width, int32_t tile_height)
+{
+    rg_world_t* world_serial;
+    rg_world_t* world_threaded;
+    rg_thread_runner_t* thread_runner;
+    uint32_t step;
+
+    ASSERT_STATUS(rg_thread_runner_create(4u, &thread_runner), RG_STATUS_OK);
+    ASSERT_TRUE(create_tile_world(NULL, tile_width, tile_height, &world_serial) == 0);
+    ASSERT_TRUE(create_tile_world(rg_thread_runner_get_runner(thread_runner), tile_width, tile_height, &world_threaded) == 0);
+    for (step = 0u; step < 80u; ++step) {
+        ASSERT_STATUS(rg_world_step(world_serial, NULL), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_step(world_threaded, NULL), RG_STATUS_OK);
+    }
+    ASSERT_TRUE(assert_worlds_match(world_serial, world_threaded, 0, 0, 64, 64) == 0);
+
+    rg_world_destroy(world_serial);
+    rg_world_destroy(world_threaded);
+    rg_thread_runner_destroy(thread_runner);
+    return 0;
+}
+#endif
+
+static int test_tile_checkerboard_mode(void)
+{
+    rg_world_t* world_serial;
+    rg_world_t* world_runner;
+    rg_world_config_t cfg;
+    rg_world_t* rejected;
+    rg_world_stats_t stats;
+    rg_budget_step_options_t budget_options;
+    test_runner_state_t runner_state;
+    rg_runner_t runner;
+    rg_cell_read_t read;
+    uint32_t step;
+    int32_t x;
+    uint32_t bottom_filled;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 32;
+    cfg.chunk_height = 32;
+    cfg.tile_width = 12;
+    ASSERT_STATUS(rg_world_create(&cfg, &rejected), RG_STATUS_INVALID_ARGUMENT);
+    cfg.tile_width = 4;
+    ASSERT_STATUS(rg_world_create(&cfg, &rejected), RG_STATUS_INVALID_ARGUMENT);
+    cfg.tile_width = 0;
+    cfg.tile_height = 5;
+    ASSERT_STATUS(rg_world_create(&cfg, &rejected), RG_STATUS_INVALID_ARGUMENT);
+
+    /* Full-width tiles shorter than the chunk must still start on a mask byte. */
+    cfg.chunk_width = 4;
+    cfg.chunk_height = 8;
+    cfg.tile_height = 1;
+    ASSERT_STATUS(rg_world_create(&cfg, &rejected), RG_STATUS_INVALID_ARGUMENT);
+    cfg.tile_height = 2;
+    ASSERT_STATUS(rg_world_create(&cfg, &rejected), RG_STATUS_OK);
+    rg_world_destroy(rejected);
+
+    memset(&runner_state, 0, sizeof(runner_state));
+    runner.vtable = &g_test_runner_vtable;
+    runner.user = &runner_state;
+    ASSERT_TRUE(create_tile_world(NULL, 8, 8, &world_serial) == 0);
+    ASSERT_TRUE(create_tile_world(&runner, 8, 8, &world_runner) == 0);
+
+    for (step = 0u; step < 80u; ++step) {
+        ASSERT_STATUS(rg_world_step(world_serial, NULL), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_step(world_runner, NULL), RG_STATUS_OK);
+    }
+
+    /* Tiles run in reverse order on the test runner; the result must not change. */
+    ASSERT_TRUE(runner_state.call_count > 0u);
+    ASSERT_TRUE(assert_worlds_match(world_serial, world_runner, 0, 0, 64, 64) == 0);
+
+    ASSERT_STATUS(rg_world_get_stats(world_serial, &stats), RG_STATUS_OK);
+    ASSERT_TRUE(stats.live_cells == 12u * 64u);
+    bottom_filled = 0u;
+    for (x = 0; x < 64; ++x) {
+        ASSERT_STATUS(rg_cell_get(world_serial, (rg_cell_coord_t){x, 63}, &read), RG_STATUS_OK);
+        bottom_filled += (read.material_id != 0u) ? 1u : 0u;
+    }
+    ASSERT_TRUE(bottom_filled == 64u);
+
+    memset(&budget_options, 0, sizeof(budget_options));
+    budget_options.mode = RG_STEP_MODE_TILE_CHECKERBOARD_PARALLEL;
+    ASSERT_STATUS(rg_world_step_budgeted(world_serial, &budget_options, NULL), RG_STATUS_UNSUPPORTED);
+
+    rg_world_destroy(world_serial);
+    rg_world_destroy(world_runner);
+
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    ASSERT_TRUE(run_tile_thread_runner_against_serial(8, 8) == 0);
+    ASSERT_TRUE(run_tile_thread_runner_against_serial(32, 4) == 0);
+    ASSERT_TRUE(run_tile_thread_runner_against_serial(32, 1) == 0);
+#endif
+    return 0;
+}
+
+static int run_intent_merge_graph_against_barriers(rg_world_t* world_barrier, rg_world_t* world_graph, int32_t extent)
+{
+    rg_world_stats_t stats_barrier;
+    rg_world_stats_t stats_graph;
+    uint32_t step;
+
+    for (step = 0u; step < 32u; ++step) {
+        ASSERT_STATUS(rg_world_step(world_barrier, NULL), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_step(world_graph, NULL), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_get_stats(world_barrier, &stats_barrier), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_get_stats(world_graph, &stats_graph), RG_STATUS_OK);
+        ASSERT_TRUE(stats_barrier.live_cells == stats_graph.live_cells);
+        ASSERT_TRUE(stats_barrier.active_chunks == stats_graph.active_chunks);
+        ASSERT_TRUE(stats_barrier.intents_emitted_last_step == stats_graph.intents_emitted_last_step);
+        ASSERT_TRUE(stats_barrier.intent_conflicts_last_step == stats_graph.intent_conflicts_last_step);
+        ASSERT_TRUE(stats_barrier.chunk_wakes_total == stats_graph.chunk_wakes_total);
+        ASSERT_TRUE(stats_barrier.chunk_sleeps_total == stats_graph.chunk_sleeps_total);
+    }
+    ASSERT_TRUE(assert_worlds_match(world_barrier, world_graph, 0, 0, extent, extent) == 0);
+    return 0;
+}
+
+static int test_intent_merge_task_graph(void)
+{
+    rg_world_t* world_barrier;
+    rg_world_t* world_graph;
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_material_id_t water_id;
+    test_runner_state_t barrier_state;
+    test_runner_state_t graph_state;
+    rg_runner_t barrier_runner;
+    rg_runner_t graph_runner;
+    int32_t cx;
+    int32_t cy;
+
+    memset(&barrier_state, 0, sizeof(barrier_state));
+    memset(&graph_state, 0, sizeof(graph_state));
+    barrier_runner.vtable = &g_test_runner_vtable;
+    barrier_runner.user = &barrier_state;
+    graph_runner.vtable = &g_test_graph_runner_vtable;
+    graph_runner.user = &graph_state;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 4;
+    cfg.chunk_height = 4;
+    cfg.default_step_mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 46u;
+    cfg.runner = &barrier_runner;
+    ASSERT_STATUS(rg_world_create(&cfg, &world_barrier), RG_STATUS_OK);
+    cfg.runner = &graph_runner;
+    ASSERT_STATUS(rg_world_create(&cfg, &world_graph), RG_STATUS_OK);
+    ASSERT_TRUE(register_simple_material(world_barrier, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(world_barrier, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+    ASSERT_TRUE(register_simple_material(world_graph, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(world_graph, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+    for (cy = 0; cy < 4; ++cy) {
+        for (cx = 0; cx < 4; ++cx) {
+            ASSERT_STATUS(rg_chunk_load(world_barrier, cx, cy), RG_STATUS_OK);
+            ASSERT_STATUS(rg_chunk_load(world_graph, cx, cy), RG_STATUS_OK);
+        }
+    }
+    ASSERT_TRUE(populate_mixed_scene(world_barrier, sand_id, water_id) == 0);
+    ASSERT_TRUE(populate_mixed_scene(world_graph, sand_id, water_id) == 0);
+
+    /* Merge buckets run highest ready first on the graph runner; the result must not change. */
+    ASSERT_TRUE(run_intent_merge_graph_against_barriers(world_barrier, world_graph, 16) == 0);
+    ASSERT_TRUE(graph_state.graph_call_count > 0u);
+    ASSERT_TRUE(graph_state.graph_edge_count > 0u);
+    ASSERT_TRUE(barrier_state.graph_call_count == 0u);
+    rg_world_destroy(world_barrier);
+    rg_world_destroy(world_graph);
+
+    /* Tile mode: a chunk can be both the source and the target of a bucket. */
+    memset(&graph_state, 0, sizeof(graph_state));
+    ASSERT_TRUE(create_tile_world(&barrier_runner, 8, 8, &world_barrier) == 0);
+    ASSERT_TRUE(create_tile_world(&graph_runner, 8, 8, &world_graph) == 0);
+    ASSERT_TRUE(run_intent_merge_graph_against_barriers(world_barrier, world_graph, 64) == 0);
+    ASSERT_TRUE(graph_state.graph_call_count > 0u);
+    rg_world_destroy(world_barrier);
+    rg_world_destroy(world_graph);
+    return 0;
+}
+
+/* Sleeping, waking, LOD skips and unloaded holes, all through the one-graph-per-step path. */
+static int test_checkerboard_step_task_graph(void)
+{
+    rg_world_t* world_barrier;
+    rg_world_t* world_graph;
+    rg_world_t* worlds[2];
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_material_id_t water_id;
+    test_runner_state_t barrier_state;
+    test_runner_state_t graph_state;
+    rg_runner_t barrier_runner;
+    rg_runner_t graph_runner;
+    rg_world_stats_t stats_barrier;
+    rg_world_stats_t stats_graph;
+    rg_cell_write_t write;
+    rg_cell_coord_t focus;
+    uint64_t lod_skipped;
+    uint32_t index;
+    uint32_t step;
+    int32_t cx;
+    int32_t cy;
+
+    memset(&barrier_state, 0, sizeof(barrier_state));
+    memset(&graph_state, 0, sizeof(graph_state));
+    barrier_runner.vtable = &g_test_runner_vtable;
+    barrier_runner.user = &barrier_state;
+    graph_runner.vtable = &g_test_graph_runner_vtable;
+    graph_runner.user = &graph_state;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 4;
+    cfg.chunk_height = 4;
+    cfg.default_step_mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 146u;
+    cfg.sleep_policy = RG_SLEEP_POLICY_ADAPTIVE;
+    cfg.chunk_sleep_ticks = 2u;
+    cfg.lod_full_rate_radius = 1u;
+    cfg.lod_band_width = 1u;
+    cfg.runner = &barrier_runner;
+    ASSERT_STATUS(rg_world_create(&cfg, &world_barrier), RG_STATUS_OK);
+    cfg.runner = &graph_runner;
+    ASSERT_STATUS(rg_world_create(&cfg, &world_graph), RG_STATUS_OK);
+    worlds[0] = world_barrier;
+    worlds[1] = world_graph;
+    focus.x = 2;
+    focus.y = 2;
+    memset(&write, 0, sizeof(write));
+    for (index = 0u; index < 2u; ++index) {
+        ASSERT_TRUE(register_simple_material(worlds[index], "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+        ASSERT_TRUE(register_simple_material(worlds[index], "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+        for (cy = 0; cy < 8; ++cy) {
+            for (cx = 0; cx < 8; ++cx) {
+                /* Leave a few holes so tasks meet missing neighbors. */
+                if ((cx == 3 && cy == 5) || (cx == 6 && cy == 2)) {
+                    continue;
+                }
+                ASSERT_STATUS(rg_chunk_load(worlds[index], cx, cy), RG_STATUS_OK);
+            }
+        }
+        ASSERT_STATUS(rg_world_set_focus_points(worlds[index], &focus, 1u), RG_STATUS_OK);
+    }
+
+    lod_skipped = 0u;
+    for (step = 0u; step < 64u; ++step) {
+        /* A fresh pour every 16 steps wakes chunks that have settled. */
+        if ((step % 16u) == 0u) {
+            for (index = 0u; index < 2u; ++index) {
+                for (cx = 0; cx < 32; cx += 3) {
+                    write.material_id = (((uint32_t)cx + step) % 2u == 0u) ? sand_id : water_id;
+                    ASSERT_STATUS(rg_cell_set(worlds[index], (rg_cell_coord_t){cx, (int32_t)(step / 16u)}, &write), RG_STATUS_OK);
+                }
+            }
+        }
+        ASSERT_STATUS(rg_world_step(world_barrier, NULL), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_step(world_graph, NULL), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_get_stats(world_barrier, &stats_barrier), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_get_stats(world_graph, &stats_graph), RG_STATUS_OK);
+        ASSERT_TRUE(stats_barrier.live_cells == stats_graph.live_cells);
+        ASSERT_TRUE(stats_barrier.active_chunks == stats_graph.active_chunks);
+        ASSERT_TRUE(stats_barrier.intents_emitted_last_step == stats_graph.intents_emitted_last_step);
+        ASSERT_TRUE(stats_barrier.intent_conflicts_last_step == stats_graph.intent_conflicts_last_step);
+        ASSERT_TRUE(stats_barrier.cross_intents_last_step == stats_graph.cross_intents_last_step);
+        ASSERT_TRUE(stats_barrier.chunk_wakes_last_step == stats_graph.chunk_wakes_last_step);
+        ASSERT_TRUE(stats_barrier.chunk_sleeps_last_step == stats_graph.chunk_sleeps_last_step);
+        ASSERT_TRUE(stats_barrier.lod_skipped_chunks_last_step == stats_graph.lod_skipped_chunks_last_step);
+        lod_skipped += stats_graph.lod_skipped_chunks_last_step;
+    }
+    for (cy = 0; cy < 8; ++cy) {
+        for (cx = 0; cx < 8; ++cx) {
+            if ((cx == 3 && cy == 5) || (cx == 6 && cy == 2)) {
+                continue;
+            }
+            ASSERT_TRUE(assert_worlds_match(world_barrier, world_graph, cx * 4, cy * 4, 4, 4) == 0);
+        }
+    }
+    ASSERT_TRUE(stats_graph.chunk_wakes_total > 0u);
+    ASSERT_TRUE(stats_graph.chunk_sleeps_total > 0u);
+    ASSERT_TRUE(lod_skipped > 0u);
+
+    /* All four phases and their merges go out as a single graph per step. */
+    ASSERT_TRUE(graph_state.graph_call_count == 64u);
+    ASSERT_TRUE(graph_state.call_count == 0u);
+    ASSERT_TRUE(graph_state.graph_edge_count > 0u);
+    ASSERT_TRUE(barrier_state.graph_call_count == 0u);
+    rg_world_destroy(world_barrier);
+    rg_world_destroy(world_graph);
+    return 0;
+}
+
+static int run_runner_against_serial(const rg_runner_t* runner, uint32_t grain)
+{
+    rg_world_t* world_serial;
+    rg_world_t* world_threaded;
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_material_id_t water_id;
+    rg_step_options_t step_options;
+    rg_world_stats_t stats_serial;
+    rg_world_stats_t stats_threaded;
+    int32_t cx;
+    int32_t cy;
+    uint32_t step;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 4;
+    cfg.chunk_height = 4;
+    cfg.default_step_mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 77u;
+    ASSERT_STATUS(rg_world_create(&cfg, &world_serial), RG_STATUS_OK);
+    cfg.runner = runner;
+    cfg.checkerboard_grain = grain;
+    ASSERT_STATUS(rg_world_create(&cfg, &world_threaded), RG_STATUS_OK);
+
+    ASSERT_TRUE(register_simple_material(world_serial, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(world_serial, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+    ASSERT_TRUE(register_simple_material(world_threaded, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(world_threaded, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+
+    for (cy = 0; cy < 4; ++cy) {
+        for (cx = 0; cx < 4; ++cx) {
+            ASSERT_STATUS(rg_chunk_load(world_serial, cx, cy), RG_STATUS_OK);
+            ASSERT_STATUS(rg_chunk_load(world_threaded, cx, cy), RG_STATUS_OK);
+        }
+    }
+    ASSERT_TRUE(populate_mixed_scene(world_serial, sand_id, water_id) == 0);
+    ASSERT_TRUE(populate_mixed_scene(world_threaded, sand_id, water_id) == 0);
+
+    /* Many short steps so the pool is parked and woken repeatedly. */
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    step_options.substeps = 1u;
+    for (step = 0u; step < 24u; ++step) {
+        ASSERT_STATUS(rg_world_step(world_serial, &step_options), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_step(world_threaded, &step_options), RG_STATUS_OK);
+    }
+
+    ASSERT_TRUE(assert_worlds_match(world_serial, world_threaded, 0, 0, 16, 16) == 0);
+    ASSERT_STATUS(rg_world_get_stats(world_serial, &stats_serial), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_get_stats(world_threaded, &stats_threaded), RG_STATUS_OK);
+    ASSERT_TRUE(stats_serial.live_cells == stats_threaded.live_cells);
+    ASSERT_TRUE(stats_serial.intent_conflicts_last_step == stats_threaded.intent_conflicts_last_step);
+
+    rg_world_destroy(world_serial);
+    rg_world_destroy(world_threaded);
+    return 0;
+}
+
+typedef struct graph_order_check_s {
+    const rg_task_graph_t* graph;
+    uint32_t calls[256];
+    uint32_t early_starts;
+} graph_order_check_t;
+
+/* Plain reads of the dependencies' calls are ordered by the runner's release edges. */
+static void check_graph_task_order(uint32_t task_index, uint32_t worker_index, void* user_data)
+{
+    graph_order_check_t* check;
+    uint32_t edge;
+
+    (void)worker_index;
+    check = (graph_order_check_t*)user_data;
+    for (edge = check->graph->dependency_offsets[task_index];
+         edge < check->graph->dependency_offsets[task_index + 1u];
+         ++edge) {
+        if (check->calls[check->graph->dependencies[edge]] != 1u) {
+            check->early_starts += 1u;
+        }
+    }
+    check->calls[task_index] += 1u;
+}
+
+static int run_runner_task_graph(const rg_runner_t* runner)
+{
+    rg_task_graph_t graph;
+    graph_order_check_t* check;
+    uint32_t dependency_offsets[257];
+    uint32_t dependencies[512];
+    uint32_t successor_offsets[257];
+    uint32_t successors[512];
+    uint32_t round;
+    uint32_t i;
+
+    /* A lattice: task i waits for i - 1 and i - 16, so every worker hits blocked slots. */
+    dependency_offsets[0] = 0u;
+    memset(successor_offsets, 0, sizeof(successor_offsets));
+    for (i = 0u; i < 256u; ++i) {
+        uint32_t edge;
+
+        edge = dependency_offsets[i];
+        if ((i % 16u) != 0u) {
+            dependencies[edge] = i - 1u;
+            successor_offsets[i] += 1u;
+            edge += 1u;
+        }
+        if (i >= 16u) {
+            dependencies[edge] = i - 16u;
+            successor_offsets[i - 15u] += 1u;
+            edge += 1u;
+        }
+        dependency_offsets[i + 1u] = edge;
+    }
+    for (i = 1u; i <= 256u; ++i) {
+        successor_offsets[i] += successor_offsets[i - 1u];
+    }
+    {
+        uint32_t cursors[256];
+
+        memcpy(cursors, successor_offsets, sizeof(cursors));
+        for (i = 0u; i < 256u; ++i) {
+            uint32_t edge;
+
+            for (edge = dependency_offsets[i]; edge < dependency_offsets[i + 1u]; ++edge) {
+                successors[cursors[dependencies[edge]]] = i;
+                cursors[dependencies[edge]] += 1u;
+            }
+        }
+    }
+
+    check = (graph_order_check_t*)calloc(1u, sizeof(*check));
+    ASSERT_TRUE(check != NULL);
+    graph.task_count = 256u;
+    graph.task = check_graph_task_order;
+    graph.task_user_data = check;
+    graph.dependency_offsets = dependency_offsets;
+    graph.dependencies = dependencies;
+    graph.successor_offsets = successor_offsets;
+    graph.successors = successors;
+    check->graph = &graph;
+
+    ASSERT_TRUE(runner->vtable->run_graph != NULL);
+    for (round = 0u; round < 8u; ++round) {
+        memset(check->calls, 0, sizeof(check->calls));
+        check->early_starts = 0u;
+        ASSERT_STATUS(runner->vtable->run_graph(runner->user, &graph), RG_STATUS_OK);
+        ASSERT_TRUE(check->early_starts == 0u);
+        for (i = 0u; i < 256u; ++i) {
+            ASSERT_TRUE(check->calls[i] == 1u);
+        }
+    }
+
+    /* Edges must point to lower indices. */
+    graph.task_count = 4u;
+    dependencies[0] = 1u;
+    ASSERT_STATUS(runner->vtable->run_graph(runner->user, &graph), RG_STATUS_INVALID_ARGUMENT);
+
+    free(check);
+    return 0;
+}
+
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+static int run_thread_runner_against_serial(rg_thread_schedule_t schedule, uint32_t grain)
+{
+    rg_thread_runner_t* thread_runner;
+    rg_thread_runner_config_t runner_cfg;
+
+    runner_cfg.worker_count = 4u;
+    runner_cfg.schedule = schedule;
+    ASSERT_STATUS(rg_thread_runner_create_with_config(&runner_cfg, &thread_runner), RG_STATUS_OK);
+    ASSERT_TRUE(rg_thread_runner_get_runner(thread_runner) != NULL);
+    ASSERT_TRUE(run_runner_against_serial(rg_thread_runner_get_runner(thread_runner), grain) == 0);
+    rg_thread_runner_destroy(thread_runner);
+    return 0;
+}
+
+static int test_thread_runner_matches_serial_checkerboard(void)
+{
+    ASSERT_TRUE(run_thread_runner_against_serial(RG_THREAD_SCHEDULE_SHARED, 1u) == 0);
+    ASSERT_TRUE(run_thread_runner_against_serial(RG_THREAD_SCHEDULE_WORK_STEALING, 1u) == 0);
+    ASSERT_TRUE(run_thread_runner_against_serial(RG_THREAD_SCHEDULE_WORK_STEALING, 3u) == 0);
+    return 0;
+}
+
+static void count_task_calls(uint32_t task_index, uint32_t worker_index, void* user_data)
+{
+    uint32_t* calls;
+
+    (void)worker_index;
+    calls = (uint32_t*)user_data;
+    calls[task_index] += 1u;
+}
+
+static int test_work_stealing_runner_runs_each_task_once(void)
+{
+    rg_thread_runner_t* thread_runner;
+    rg_thread_runner_config_t runner_cfg;
+    const rg_runner_t* runner;
+    uint32_t calls[257];
+    uint32_t task_count;
+    uint32_t i;
+
+    runner_cfg.worker_count = 4u;
+    runner_cfg.schedule = RG_THREAD_SCHEDULE_WORK_STEALING;
+    ASSERT_STATUS(rg_thread_runner_create_with_config(&runner_cfg, &thread_runner), RG_STATUS_OK);
+    runner = rg_thread_runner_get_runner(thread_runner);
+    ASSERT_TRUE(runner->vtable->worker_count(runner->user) == 4u);
+
+    for (task_count = 2u; task_count <= 257u; task_count += 51u) {
+        memset(calls, 0, sizeof(calls));
+        ASSERT_STATUS(runner->vtable->parallel_for(runner->user, task_count, count_task_calls, calls), RG_STATUS_OK);
+        for (i = 0u; i < 257u; ++i) {
+            ASSERT_TRUE(calls[i] == ((i < task_count) ? 1u : 0u));
+        }
+    }
+
+    rg_thread_runner_destroy(thread_runner);
+
+    runner_cfg.schedule = (rg_thread_schedule_t)7;
+    ASSERT_STATUS(rg_thread_runner_create_with_config(&runner_cfg, &thread_runner), RG_STATUS_INVALID_ARGUMENT);
+    ASSERT_TRUE(thread_runner == NULL);
+    return 0;
+}
+
+static int test_thread_runner_task_graph(void)
+{
+    rg_thread_runner_t* thread_runner;
+    rg_thread_runner_config_t runner_cfg;
+    uint32_t schedule;
+
+    for (schedule = 0u; schedule < 2u; ++schedule) {
+        runner_cfg.worker_count = 4u;
+        runner_cfg.schedule = (schedule == 0u) ? RG_THREAD_SCHEDULE_SHARED : RG_THREAD_SCHEDULE_WORK_STEALING;
+        ASSERT_STATUS(rg_thread_runner_create_with_config(&runner_cfg, &thread_runner), RG_STATUS_OK);
+        ASSERT_TRUE(run_runner_task_graph(rg_thread_runner_get_runner(thread_runner)) == 0);
+        rg_thread_runner_destroy(thread_runner);
+    }
+    return 0;
+}
+#endif
+
+typedef struct checkerboard_fixture_s {
+    const rg_runner_t* runner;
+    rg_step_mode_t mode;
+    uint8_t deterministic_mode;
+    uint32_t deterministic_seed;
+    uint32_t checkerboard_block;
+    int32_t chunk_min; /* Chunks [chunk_min, chunk_max) are loaded on both axes. */
+    int32_t chunk_max;
+    int32_t fill_rows; /* Striped rows dropped from the top of the loaded area. */
+} checkerboard_fixture_t;
+
+/* Steps striped sand and water on 8x8-cell chunks; the world is destroyed when out_world is NULL. */
+static int run_checkerboard_fixture(
+    const checkerboard_fixture_t* fixture,
+    rg_world_t** out_world,
+    uint64_t* out_cross_intents)
+{
+    rg_world_t* world;
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_material_id_t water_id;
+    rg_cell_write_t write;
+    rg_cell_read_t read;
+    rg_step_options_t step_options;
+    rg_world_stats_t stats;
+    uint64_t cross_intents;
+    uint64_t scanned;
+    uint32_t step;
+    int32_t min_cell;
+    int32_t max_cell;
+    int32_t cx;
+    int32_t cy;
+    int32_t x;
+    int32_t y;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 8;
+    cfg.chunk_height = 8;
+    cfg.default_step_mode = fixture->mode;
+    cfg.deterministic_mode = fixture->deterministic_mode;
+    cfg.deterministic_seed = fixture->deterministic_seed;
+    cfg.checkerboard_block = fixture->checkerboard_block;
+    cfg.runner = fixture->runner;
+    ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+    ASSERT_TRUE(register_simple_material(world, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(world, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+    for (cy = fixture->chunk_min; cy < fixture->chunk_max; ++cy) {
+        for (cx = fixture->chunk_min; cx < fixture->chunk_max; ++cx) {
+            ASSERT_STATUS(rg_chunk_load(world, cx, cy), RG_STATUS_OK);
+        }
+    }
+
+    min_cell = fixture->chunk_min * 8;
+    max_cell = fixture->chunk_max * 8;
+    memset(&write, 0, sizeof(write));
+    for (y = min_cell; y < min_cell + fixture->fill_rows; ++y) {
+        for (x = min_cell; x < max_cell; ++x) {
+            write.material_id = (((x / 2) + y) % 2 == 0) ? sand_id : water_id;
+            ASSERT_STATUS(rg_cell_set(world, (rg_cell_coord_t){x, y}, &write), RG_STATUS_OK);
+        }
+    }
+
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = fixture->mode;
+    step_options.substeps = 1u;
+    cross_intents = 0u;
+    for (step = 0u; step < 120u; ++step) {
+        ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_get_stats(world, &stats), RG_STATUS_OK);
+        cross_intents += stats.cross_intents_last_step;
+    }
+
+    /* Nothing is lost or duplicated, and the material has reached the floor. */
+    scanned = 0u;
+    for (y = min_cell; y < max_cell; ++y) {
+        for (x = min_cell; x < max_cell; ++x) {
+            ASSERT_STATUS(rg_cell_get(world, (rg_cell_coord_t){x, y}, &read), RG_STATUS_OK);
+            scanned += (read.material_id != 0u) ? 1u : 0u;
+            if (y == max_cell - 1) {
+                ASSERT_TRUE(read.material_id != 0u);
+            }
+        }
+    }
+    ASSERT_TRUE(scanned == (uint64_t)fixture->fill_rows * (uint64_t)(max_cell - min_cell));
+    ASSERT_TRUE(stats.live_cells == scanned);
+    if (fixture->mode == RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC) {
+        ASSERT_TRUE(stats.intent_conflicts_last_step == 0u);
+    }
+
+    if (out_cross_intents != NULL) {
+        *out_cross_intents = cross_intents;
+    }
+    if (out_world != NULL) {
+        *out_world = world;
+    } else {
+        rg_world_destroy(world);
+    }
+    return 0;
+}
+
+static int test_checkerboard_atomic_mode(void)
+{
+    rg_world_t* world;
+    rg_world_config_t cfg;
+    checkerboard_fixture_t fixture;
+    rg_step_options_t step_options;
+    rg_budget_step_options_t budget_options;
+    test_runner_state_t runner_state;
+    rg_runner_t runner;
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    rg_thread_runner_t* thread_runner;
+#endif
+
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC;
+    memset(&budget_options, 0, sizeof(budget_options));
+    budget_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 8;
+    cfg.chunk_height = 8;
+    cfg.deterministic_mode = 1u;
+    ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_UNSUPPORTED);
+    rg_world_destroy(world);
+
+    cfg.deterministic_mode = 0u;
+    cfg.chunk_width = 1;
+    ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_UNSUPPORTED);
+    rg_world_destroy(world);
+
+    cfg.chunk_width = 8;
+    ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_step_budgeted(world, &budget_options, NULL), RG_STATUS_UNSUPPORTED);
+    rg_world_destroy(world);
+
+    memset(&runner_state, 0, sizeof(runner_state));
+    runner.vtable = &g_test_runner_vtable;
+    runner.user = &runner_state;
+    memset(&fixture, 0, sizeof(fixture));
+    fixture.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC;
+    fixture.chunk_max = 3;
+    fixture.fill_rows = 8;
+    ASSERT_TRUE(run_checkerboard_fixture(&fixture, NULL, NULL) == 0);
+    fixture.runner = &runner;
+    ASSERT_TRUE(run_checkerboard_fixture(&fixture, NULL, NULL) == 0);
+    ASSERT_TRUE(runner_state.call_count > 0u);
+
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    ASSERT_STATUS(rg_thread_runner_create(4u, &thread_runner), RG_STATUS_OK);
+    fixture.runner = rg_thread_runner_get_runner(thread_runner);
+    ASSERT_TRUE(run_checkerboard_fixture(&fixture, NULL, NULL) == 0);
+    rg_thread_runner_destroy(thread_runner);
+#endif
+    return 0;
+}
+
+static int test_checkerboard_halo_mode(void)
+{
+    rg_world_t* world;
+    rg_world_t* world_serial;
+    rg_world_t* world_runner;
+    rg_world_config_t cfg;
+    checkerboard_fixture_t fixture;
+    rg_step_options_t step_options;
+    rg_budget_step_options_t budget_options;
+    test_runner_state_t runner_state;
+    rg_runner_t runner;
+    uint64_t cross_intents;
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    rg_thread_runner_t* thread_runner;
+#endif
+
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO;
+    memset(&budget_options, 0, sizeof(budget_options));
+    budget_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 1;
+    cfg.chunk_height = 8;
+    ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_step(world, &step_options), RG_STATUS_UNSUPPORTED);
+    rg_world_destroy(world);
+
+    cfg.chunk_width = 8;
+    ASSERT_STATUS(rg_world_create(&cfg, &world), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_step_budgeted(world, &budget_options, NULL), RG_STATUS_UNSUPPORTED);
+    rg_world_destroy(world);
+
+    /* Intent mode merges moves across chunk borders; halo mode commits them in place. */
+    memset(&fixture, 0, sizeof(fixture));
+    fixture.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    fixture.deterministic_mode = 1u;
+    fixture.deterministic_seed = 7u;
+    fixture.chunk_max = 3;
+    fixture.fill_rows = 8;
+    ASSERT_TRUE(run_checkerboard_fixture(&fixture, NULL, &cross_intents) == 0);
+    ASSERT_TRUE(cross_intents > 0u);
+
+    fixture.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO;
+    ASSERT_TRUE(run_checkerboard_fixture(&fixture, &world_serial, &cross_intents) == 0);
+    ASSERT_TRUE(cross_intents == 0u);
+
+    /* The color schedule alone decides who writes a halo cell, so results do not depend on the runner. */
+    memset(&runner_state, 0, sizeof(runner_state));
+    runner.vtable = &g_test_runner_vtable;
+    runner.user = &runner_state;
+    fixture.runner = &runner;
+    ASSERT_TRUE(run_checkerboard_fixture(&fixture, &world_runner, NULL) == 0);
+    ASSERT_TRUE(runner_state.call_count > 0u);
+    ASSERT_TRUE(assert_worlds_match(world_serial, world_runner, 0, 0, 24, 24) == 0);
+    rg_world_destroy(world_runner);
+
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    ASSERT_STATUS(rg_thread_runner_create(4u, &thread_runner), RG_STATUS_OK);
+    fixture.runner = rg_thread_runner_get_runner(thread_runner);
+    ASSERT_TRUE(run_checkerboard_fixture(&fixture, &world_runner, NULL) == 0);
+    ASSERT_TRUE(assert_worlds_match(world_serial, world_runner, 0, 0, 24, 24) == 0);
+    rg_world_destroy(world_runner);
+    rg_thread_runner_destroy(thread_runner);
+#endif
+
+    rg_world_destroy(world_serial);
+    return 0;
+}
+
+static int test_checkerboard_block_tasks(void)
+{
+    static const rg_step_mode_t k_modes[2] = {
+        RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL,
+        RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO
+    };
+    rg_world_t* world_serial;
+    rg_world_t* world_runner;
+    checkerboard_fixture_t fixture;
+    test_runner_state_t runner_state;
+    rg_runner_t runner;
+    uint64_t chunk_intents;
+    uint64_t block_intents;
+    uint32_t mode;
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    rg_thread_runner_t* thread_runner;
+#endif
+
+    /* Chunks -3..2 on both axes, so blocks straddle the origin. */
+    memset(&fixture, 0, sizeof(fixture));
+    fixture.mode = k_modes[0];
+    fixture.deterministic_mode = 1u;
+    fixture.deterministic_seed = 5u;
+    fixture.chunk_min = -3;
+    fixture.chunk_max = 3;
+    fixture.fill_rows = 12;
+
+    /* Moves between the chunks of a block commit in place, so fewer become intents. */
+    fixture.checkerboard_block = 1u;
+    ASSERT_TRUE(run_checkerboard_fixture(&fixture, NULL, &chunk_intents) == 0);
+    fixture.checkerboard_block = 2u;
+    ASSERT_TRUE(run_checkerboard_fixture(&fixture, NULL, &block_intents) == 0);
+    ASSERT_TRUE(block_intents > 0u);
+    ASSERT_TRUE(block_intents < chunk_intents);
+
+    memset(&runner_state, 0, sizeof(runner_state));
+    runner.vtable = &g_test_runner_vtable;
+    runner.user = &runner_state;
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    ASSERT_STATUS(rg_thread_runner_create(4u, &thread_runner), RG_STATUS_OK);
+#endif
+    for (mode = 0u; mode < 2u; ++mode) {
+        /* Blocks run in reverse order on the test runner; results must not change. */
+        fixture.mode = k_modes[mode];
+        fixture.runner = NULL;
+        ASSERT_TRUE(run_checkerboard_fixture(&fixture, &world_serial, NULL) == 0);
+        fixture.runner = &runner;
+        ASSERT_TRUE(run_checkerboard_fixture(&fixture, &world_runner, NULL) == 0);
+        ASSERT_TRUE(assert_worlds_match(world_serial, world_runner, -24, -24, 48, 48) == 0);
+        rg_world_destroy(world_runner);
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+        fixture.runner = rg_thread_runner_get_runner(thread_runner);
+        ASSERT_TRUE(run_checkerboard_fixture(&fixture, &world_runner, NULL) == 0);
+        ASSERT_TRUE(assert_worlds_match(world_serial, world_runner, -24, -24, 48, 48) == 0);
+        rg_world_destroy(world_runner);
+#endif
+        rg_world_destroy(world_serial);
+    }
+    ASSERT_TRUE(runner_state.call_count > 0u);
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    rg_thread_runner_destroy(thread_runner);
+#endif
+    return 0;
+}
+
+static int run_async_steps_against_sync(const rg_runner_t* runner)
+{
+    rg_world_t* world_sync;
+    rg_world_t* world_async;
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_material_id_t water_id;
+    rg_step_options_t step_options;
+    rg_cell_write_t write;
+    rg_cell_read_t read;
+    rg_world_stats_t stats_sync;
+    rg_world_stats_t stats_async;
+    int32_t cx;
+    int32_t cy;
+    uint32_t frame;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 4;
+    cfg.chunk_height = 4;
+    cfg.default_step_mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = 404u;
+    ASSERT_STATUS(rg_world_create(&cfg, &world_sync), RG_STATUS_OK);
+    cfg.runner = runner;
+    ASSERT_STATUS(rg_world_create(&cfg, &world_async), RG_STATUS_OK);
+
+    ASSERT_TRUE(register_simple_material(world_sync, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(world_sync, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+    ASSERT_TRUE(register_simple_material(world_async, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(world_async, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+    for (cy = 0; cy < 4; ++cy) {
+        for (cx = 0; cx < 4; ++cx) {
+            ASSERT_STATUS(rg_chunk_load(world_sync, cx, cy), RG_STATUS_OK);
+            ASSERT_STATUS(rg_chunk_load(world_async, cx, cy), RG_STATUS_OK);
+        }
+    }
+    ASSERT_TRUE(populate_mixed_scene(world_sync, sand_id, water_id) == 0);
+    ASSERT_TRUE(populate_mixed_scene(world_async, sand_id, water_id) == 0);
+
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = (rg_step_mode_t)9;
+    ASSERT_STATUS(rg_world_step_begin(world_async, &step_options), RG_STATUS_INVALID_ARGUMENT);
+    ASSERT_STATUS(rg_world_step_wait(world_async), RG_STATUS_INVALID_ARGUMENT);
+
+    memset(&write, 0, sizeof(write));
+    write.material_id = sand_id;
+    step_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    step_options.substeps = 1u;
+    for (frame = 0u; frame < 24u; ++frame) {
+        ASSERT_STATUS(rg_world_step_begin(world_async, &step_options), RG_STATUS_OK);
+
+        /* The in-flight step owns the world; the caller's frame work goes elsewhere. */
+        ASSERT_STATUS(rg_world_step_begin(world_async, &step_options), RG_STATUS_CONFLICT);
+        ASSERT_STATUS(rg_world_step(world_async, &step_options), RG_STATUS_CONFLICT);
+        ASSERT_STATUS(rg_cell_get(world_async, (rg_cell_coord_t){0, 0}, &read), RG_STATUS_CONFLICT);
+        ASSERT_STATUS(rg_cell_set(world_async, (rg_cell_coord_t){0, 0}, &write), RG_STATUS_CONFLICT);
+        ASSERT_STATUS(rg_chunk_load(world_async, 9, 9), RG_STATUS_CONFLICT);
+        ASSERT_STATUS(rg_world_get_stats(world_async, &stats_async), RG_STATUS_CONFLICT);
+        ASSERT_STATUS(rg_world_step(world_sync, &step_options), RG_STATUS_OK);
+
+        ASSERT_STATUS(rg_world_step_wait(world_async), RG_STATUS_OK);
+    }
+    ASSERT_STATUS(rg_world_step_wait(world_async), RG_STATUS_INVALID_ARGUMENT);
+
+    ASSERT_TRUE(assert_worlds_match(world_sync, world_async, 0, 0, 16, 16) == 0);
+    ASSERT_STATUS(rg_world_get_stats(world_sync, &stats_sync), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_get_stats(world_async, &stats_async), RG_STATUS_OK);
+    ASSERT_TRUE(stats_sync.step_index == stats_async.step_index);
+    ASSERT_TRUE(stats_sync.live_cells == stats_async.live_cells);
+
+    /* Destroying a world mid-step waits for the step first. */
+    ASSERT_STATUS(rg_world_step_begin(world_async, &step_options), RG_STATUS_OK);
+    rg_world_destroy(world_async);
+    rg_world_destroy(world_sync);
+    return 0;
+}
+
+static int test_async_step_begin_wait(void)
+{
+    test_runner_state_t runner_state;
+    rg_runner_t runner;
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    rg_thread_runner_t* thread_runner;
+#endif
+
+    /* Without submit/wait in the vtable, begin runs the step before returning. */
+    memset(&runner_state, 0, sizeof(runner_state));
+    runner.vtable = &g_test_runner_vtable;
+    runner.user = &runner_state;
+    ASSERT_TRUE(run_async_steps_against_sync(NULL) == 0);
+    ASSERT_TRUE(run_async_steps_against_sync(&runner) == 0);
+    ASSERT_TRUE(runner_state.call_count > 0u);
+
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    ASSERT_STATUS(rg_thread_runner_create(4u, &thread_runner), RG_STATUS_OK);
+    ASSERT_TRUE(run_async_steps_against_sync(rg_thread_runner_get_runner(thread_runner)) == 0);
+    rg_thread_runner_destroy(thread_runner);
+
+    ASSERT_STATUS(rg_thread_runner_create(1u, &thread_runner), RG_STATUS_OK);
+    ASSERT_TRUE(run_async_steps_against_sync(rg_thread_runner_get_runner(thread_runner)) == 0);
+    rg_thread_runner_destroy(thread_runner);
+#endif
+    return 0;
+}
+
+#if defined(REGOLITH_HAVE_SDL_RUNNER)
+static int test_sdl_runner(void)
+{
+    rg_sdl_runner_t* sdl_runner;
+    const rg_runner_t* runner;
+    rg_world_t* world_serial;
+    rg_world_t* world_sdl;
+    checkerboard_fixture_t fixture;
+    uint32_t worker_count;
+
+    ASSERT_STATUS(rg_sdl_runner_create(4u, NULL), RG_STATUS_INVALID_ARGUMENT);
+    ASSERT_TRUE(rg_sdl_runner_get_runner(NULL) == NULL);
+
+    /* One worker runs everything inline on the caller; four parks and wakes helpers. */
+    for (worker_count = 1u; worker_count <= 4u; worker_count += 3u) {
+        ASSERT_STATUS(rg_sdl_runner_create(worker_count, &sdl_runner), RG_STATUS_OK);
+        runner = rg_sdl_runner_get_runner(sdl_runner);
+        ASSERT_TRUE(runner->vtable->worker_count(runner->user) == worker_count);
+
+        ASSERT_TRUE(run_runner_against_serial(runner, 1u) == 0);
+        ASSERT_TRUE(run_runner_against_serial(runner, 3u) == 0);
+
+        memset(&fixture, 0, sizeof(fixture));
+        fixture.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_ATOMIC;
+        fixture.chunk_max = 3;
+        fixture.fill_rows = 8;
+        fixture.runner = runner;
+        ASSERT_TRUE(run_checkerboard_fixture(&fixture, NULL, NULL) == 0);
+
+        fixture.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_HALO;
+        fixture.deterministic_mode = 1u;
+        fixture.deterministic_seed = 7u;
+        fixture.runner = NULL;
+        ASSERT_TRUE(run_checkerboard_fixture(&fixture, &world_serial, NULL) == 0);
+        fixture.runner = runner;
+        ASSERT_TRUE(run_checkerboard_fixture(&fixture, &world_sdl, NULL) == 0);
+        ASSERT_TRUE(assert_worlds_match(world_serial, world_sdl, 0, 0, 24, 24) == 0);
+        rg_world_destroy(world_sdl);
+        rg_world_destroy(world_serial);
+
+        ASSERT_TRUE(run_async_steps_against_sync(runner) == 0);
+        ASSERT_TRUE(run_runner_task_graph(runner) == 0);
+        rg_sdl_runner_destroy(sdl_runner);
+    }
+    return 0;
+}
+#endif
+
+static int create_batch_world(const rg_runner_t* runner, uint64_t seed, rg_step_mode_t mode, rg_world_t** out_world)
+{
+    rg_world_config_t cfg;
+    rg_material_id_t sand_id;
+    rg_material_id_t water_id;
+    int32_t cx;
+    int32_t cy;
+
+    memset(&cfg, 0, sizeof(cfg));
+    cfg.chunk_width = 4;
+    cfg.chunk_height = 4;
+    cfg.default_step_mode = mode;
+    cfg.deterministic_mode = 1u;
+    cfg.deterministic_seed = seed;
+    cfg.runner = runner;
+    ASSERT_STATUS(rg_world_create(&cfg, out_world), RG_STATUS_OK);
+    ASSERT_TRUE(register_simple_material(*out_world, "sand", RG_MATERIAL_POWDER, 10.0f, &sand_id) == 0);
+    ASSERT_TRUE(register_simple_material(*out_world, "water", RG_MATERIAL_LIQUID, 5.0f, &water_id) == 0);
+    for (cy = 0; cy < 4; ++cy) {
+        for (cx = 0; cx < 4; ++cx) {
+            ASSERT_STATUS(rg_chunk_load(*out_world, cx, cy), RG_STATUS_OK);
+        }
+    }
+    ASSERT_TRUE(populate_mixed_scene(*out_world, sand_id, water_id) == 0);
+    return 0;
+}
+
+static int test_world_step_batch(void)
+{
+    static const rg_step_mode_t modes[4] = {
+        RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL,
+        RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL,
+        RG_STEP_MODE_CHUNK_SCAN_SERIAL,
+        RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL
+    };
+    rg_world_t* alone[4];
+    rg_world_t* batched[4];
+    rg_world_t* pair[2];
+    rg_world_t* other_runner_world;
+    rg_step_options_t step_options;
+    rg_world_stats_t stats_alone;
+    rg_world_stats_t stats_batched;
+    test_runner_state_t alone_state;
+    test_runner_state_t batch_state;
+    rg_runner_t alone_runner;
+    rg_runner_t batch_runner;
+    uint32_t step;
+    uint32_t i;
+
+    memset(&alone_state, 0, sizeof(alone_state));
+    memset(&batch_state, 0, sizeof(batch_state));
+    alone_runner.vtable = &g_test_runner_vtable;
+    alone_runner.user = &alone_state;
+    batch_runner.vtable = &g_test_runner_vtable;
+    batch_runner.user = &batch_state;
+    for (i = 0u; i < 4u; ++i) {
+        ASSERT_TRUE(create_batch_world(&alone_runner, 100u + i, modes[i], &alone[i]) == 0);
+        ASSERT_TRUE(create_batch_world(&batch_runner, 100u + i, modes[i], &batched[i]) == 0);
+    }
+
+    /* Each world keeps its default mode; the checkerboard ones share dispatches. */
+    for (step = 0u; step < 16u; ++step) {
+        for (i = 0u; i < 4u; ++i) {
+            ASSERT_STATUS(rg_world_step(alone[i], NULL), RG_STATUS_OK);
+        }
+        ASSERT_STATUS(rg_world_step_batch(batched, 4u, NULL), RG_STATUS_OK);
+    }
+    memset(&step_options, 0, sizeof(step_options));
+    step_options.mode = RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL;
+    step_options.substeps = 3u;
+    for (i = 0u; i < 4u; ++i) {
+        ASSERT_STATUS(rg_world_step(alone[i], &step_options), RG_STATUS_OK);
+    }
+    ASSERT_STATUS(rg_world_step_batch(batched, 4u, &step_options), RG_STATUS_OK);
+
+    for (i = 0u; i < 4u; ++i) {
+        ASSERT_TRUE(assert_worlds_match(alone[i], batched[i], 0, 0, 16, 16) == 0);
+        ASSERT_STATUS(rg_world_get_stats(alone[i], &stats_alone), RG_STATUS_OK);
+        ASSERT_STATUS(rg_world_get_stats(batched[i], &stats_batched), RG_STATUS_OK);
+        ASSERT_TRUE(stats_alone.step_index == stats_batched.step_index);
+        ASSERT_TRUE(stats_alone.live_cells == stats_batched.live_cells);
+        ASSERT_TRUE(stats_alone.intents_emitted_last_step == stats_batched.intents_emitted_last_step);
+    }
+    ASSERT_TRUE(batch_state.call_count < alone_state.call_count);
+    ASSERT_TRUE(batch_state.max_task_count > alone_state.max_task_count);
+
+    /* Rejected batches leave no world marked, so a valid batch still runs afterwards. */
+    pair[0] = batched[0];
+    pair[1] = batched[0];
+    ASSERT_STATUS(rg_world_step_batch(pair, 2u, NULL), RG_STATUS_INVALID_ARGUMENT);
+    ASSERT_TRUE(create_batch_world(NULL, 7u, RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL, &other_runner_world) == 0);
+    pair[1] = other_runner_world;
+    ASSERT_STATUS(rg_world_step_batch(pair, 2u, NULL), RG_STATUS_INVALID_ARGUMENT);
+    ASSERT_STATUS(rg_world_step_batch(NULL, 1u, NULL), RG_STATUS_INVALID_ARGUMENT);
+    ASSERT_STATUS(rg_world_step_batch(batched, 2u, NULL), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_step_begin(batched[1], NULL), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_step_batch(batched, 2u, NULL), RG_STATUS_CONFLICT);
+    ASSERT_STATUS(rg_world_step_wait(batched[1]), RG_STATUS_OK);
+    ASSERT_STATUS(rg_world_step_batch(batched, 2u, NULL), RG_STATUS_OK);
+
+    rg_world_destroy(other_runner_world);
+    for (i = 0u; i < 4u; ++i) {
+        rg_world_destroy(alone[i]);
+        rg_world_destroy(batched[i]);
+    }
+    return 0;
+}
+
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+static int test_world_step_batch_thread_runner(void)
+{
+    rg_thread_runner_t* thread_runner;
+    rg_world_t* alone[6];
+    rg_world_t* batched[6];
+    uint32_t step;
+    uint32_t i;
+
+    ASSERT_STATUS(rg_thread_runner_create(4u, &thread_runner), RG_STATUS_OK);
+    for (i = 0u; i < 6u; ++i) {
+        ASSERT_TRUE(
+            create_batch_world(NULL, 300u + i, RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL, &alone[i]) == 0);
+        ASSERT_TRUE(
+            create_batch_world(
+                rg_thread_runner_get_runner(thread_runner),
+                300u + i,
+                RG_STEP_MODE_CHUNK_CHECKERBOARD_PARALLEL,
+                &batched[i]) == 0);
+    }
+
+    for (step = 0u; step < 20u; ++step) {
+        for (i = 0u; i < 6u; ++i) {
+            ASSERT_STATUS(rg_world_step(alone[i], NULL), RG_STATUS_OK);
+        }
+        ASSERT_STATUS(rg_world_step_batch(batched, 6u, NULL), RG_STATUS_OK);
+    }
+    for (i = 0u; i < 6u; ++i) {
+        ASSERT_TRUE(assert_worlds_match(alone[i], batched[i], 0, 0, 16, 16) == 0);
+        rg_world_destroy(alone[i]);
+        rg_world_destroy(batched[i]);
+    }
+    rg_thread_runner_destroy(thread_runner);
+    return 0;
+}
+#endif
+
 static int test_custom_update_try_move_with_payload(void)
 {
     rg_world_t* world;
@@ -1084,12 +3317,44 @@ int main(void)
     RUN_TEST(test_ctor_dtor_behavior);
     RUN_TEST(test_step_and_stats);
     RUN_TEST(test_powder_falls_in_full_scan);
+    RUN_TEST(test_powder_falls_one_cell_per_substep);
     RUN_TEST(test_liquid_flows_sideways_when_blocked);
     RUN_TEST(test_cross_chunk_fall);
+    RUN_TEST(test_dense_fall_settles_across_chunks);
     RUN_TEST(test_chunk_scan_sleep_and_wake);
+    RUN_TEST(test_chunk_scan_steps_woken_chunks_next_pass);
+    RUN_TEST(test_active_chunk_order_independent_of_wakes);
+    RUN_TEST(test_adaptive_sleep_policy);
+    RUN_TEST(test_lod_steps_distant_chunks_less_often);
+    RUN_TEST(test_budgeted_step_priority_and_fairness);
+    RUN_TEST(test_active_chunks_follow_load_and_unload);
+    RUN_TEST(test_border_change_wakes_sleeping_neighbor);
     RUN_TEST(test_unloaded_chunk_cell_access);
     RUN_TEST(test_checkerboard_parallel_cross_chunk_with_runner);
     RUN_TEST(test_checkerboard_parallel_conflict_resolution);
+    RUN_TEST(test_checkerboard_randomness_independent_of_scheduling);
+    RUN_TEST(test_substeps_reuse_step_scratch);
+    RUN_TEST(test_tile_checkerboard_mode);
+    RUN_TEST(test_intent_merge_task_graph);
+    RUN_TEST(test_checkerboard_step_task_graph);
+    RUN_TEST(test_steady_state_steps_do_not_allocate);
+    RUN_TEST(test_reserved_step_scratch);
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    RUN_TEST(test_thread_runner_matches_serial_checkerboard);
+    RUN_TEST(test_work_stealing_runner_runs_each_task_once);
+    RUN_TEST(test_thread_runner_task_graph);
+#endif
+    RUN_TEST(test_checkerboard_atomic_mode);
+    RUN_TEST(test_checkerboard_halo_mode);
+    RUN_TEST(test_checkerboard_block_tasks);
+    RUN_TEST(test_async_step_begin_wait);
+#if defined(REGOLITH_HAVE_SDL_RUNNER)
+    RUN_TEST(test_sdl_runner);
+#endif
+    RUN_TEST(test_world_step_batch);
+#if defined(REGOLITH_HAVE_THREAD_RUNNER)
+    RUN_TEST(test_world_step_batch_thread_runner);
+#endif
     RUN_TEST(test_custom_update_try_move_with_payload);
     RUN_TEST(test_custom_update_try_swap);
     RUN_TEST(test_custom_update_transform_in_checkerboard);